@@ -0,0 +1,184 @@
+#pragma once
+
+#include "input-dependency/Analysis/AnalysisContext.h"
+#include "input-dependency/Analysis/definitions.h"
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace llvm {
+class Function;
+}
+
+namespace input_dependency {
+
+/// Limits of work done to analyze a single function, 0 means unlimited
+struct FunctionAnalysisBudget
+{
+    unsigned long instructions = 0;
+    unsigned long alias_queries = 0;
+    unsigned long loop_reflected_values = 0;
+    double wall_ms = 0;
+
+    bool empty() const
+    {
+        return instructions == 0 && alias_queries == 0 && loop_reflected_values == 0 && wall_ms == 0;
+    }
+};
+
+/// Thrown from the analysis of a function when it exceeds its budget
+class BudgetExceededException : public std::exception
+{
+public:
+    explicit BudgetExceededException(const std::string& reason)
+        : m_reason(reason)
+        , m_msg("Analysis budget exceeded: " + reason)
+    {
+    }
+
+    const char* what() const throw() override
+    {
+        return m_msg.c_str();
+    }
+
+    /// Exceeded limit
+    const std::string& reason() const
+    {
+        return m_reason;
+    }
+
+private:
+    std::string m_reason;
+    std::string m_msg;
+};
+
+/**
+ * \class AnalysisBudget
+ * \brief Enforces per function analysis budgets and keeps summaries of functions which exceeded them.
+ *
+ * Functions which exceed the budget are considered entirely input dependent. Their summaries hold globals
+ * they may reference or modify, so that callers and callees can treat them conservatively.
+ * Side effects of a budgeted analysis on other functions are deferred until the analysis finishes, and dropped if
+ * it exceeds the budget.
+ */
+class AnalysisBudget
+{
+public:
+    struct FallbackSummary
+    {
+        std::string reason;
+        FunctionSet calledFunctions;
+        GlobalsSet referencedGlobals;
+        GlobalsSet modifiedGlobals;
+    };
+
+    using FallbackSummaries = std::unordered_map<llvm::Function*, FallbackSummary>;
+
+    static AnalysisBudget& get()
+    {
+        return AnalysisContext::get().get_budget();
+    }
+
+    /// Enforces the budget during its lifetime, while analysis of a function is running.
+    class Scope
+    {
+    public:
+        explicit Scope(llvm::Function* F);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator =(const Scope&) = delete;
+    };
+
+private:
+    friend class AnalysisContext;
+    AnalysisBudget() = default;
+
+public:
+    void set_budget(const FunctionAnalysisBudget& budget)
+    {
+        m_budget = budget;
+    }
+
+    const FunctionAnalysisBudget& get_budget() const
+    {
+        return m_budget;
+    }
+
+    bool has_budget() const
+    {
+        return !m_budget.empty();
+    }
+
+    void reset();
+
+    /// Returns true if function is too large to start its analysis
+    bool exceeds_instructions_budget(llvm::Function* F) const;
+
+    void count_alias_query()
+    {
+        if (!m_enforced) {
+            return;
+        }
+        if (m_budget.alias_queries != 0 && ++m_aliasQueries > m_budget.alias_queries) {
+            throw BudgetExceededException("alias queries");
+        }
+        check_wall_time();
+    }
+
+    void count_loop_reflected_value()
+    {
+        if (m_enforced && m_budget.loop_reflected_values != 0
+                && ++m_loopReflectedValues > m_budget.loop_reflected_values) {
+            throw BudgetExceededException("values reflected in loops");
+        }
+    }
+
+    void check_wall_time() const;
+
+    /// Runs side effect of the running analysis on other functions, deferring it while the budget is enforced
+    void run_side_effect(std::function<void ()> effect)
+    {
+        if (m_enforced) {
+            m_deferredEffects.push_back(std::move(effect));
+            return;
+        }
+        effect();
+    }
+
+    /// Runs side effects deferred by analysis which finished within budget
+    void commit_side_effects();
+
+    /// Drops side effects deferred by analysis which exceeded budget
+    void discard_side_effects()
+    {
+        m_deferredEffects.clear();
+    }
+
+    /// Computes and records conservative summary of function F, using results of already analyzed callees
+    const FallbackSummary& add_fallback_function(llvm::Function* F,
+                                                 const std::string& reason,
+                                                 const FunctionAnalysisGetter& FAG);
+    const FallbackSummary* get_fallback_summary(llvm::Function* F) const;
+
+    const FallbackSummaries& get_fallback_functions() const
+    {
+        return m_fallbacks;
+    }
+
+private:
+    FunctionAnalysisBudget m_budget;
+    bool m_enforced = false;
+    unsigned long m_aliasQueries = 0;
+    unsigned long m_loopReflectedValues = 0;
+    std::chrono::steady_clock::time_point m_start;
+    std::vector<std::function<void ()>> m_deferredEffects;
+    FallbackSummaries m_fallbacks;
+};
+
+} // namespace input_dependency
+
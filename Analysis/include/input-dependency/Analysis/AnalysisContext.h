@@ -0,0 +1,120 @@
+#pragma once
+
+#include <memory>
+
+namespace input_dependency {
+
+class AnalysisBudget;
+class AnalysisCostRecorder;
+class AnalysisTiers;
+class BasicBlocksUtils;
+class GlobalsIndex;
+class InputDepConfig;
+class InputDepInstructionsRecorder;
+class LibraryInfoManager;
+class MemoryAccounting;
+class PhaseTimers;
+
+/**
+ * \class AnalysisContext
+ * \brief Holds mutable state of an analysis run: configuration, library info, unreachable blocks, recorded
+ * instructions, budgets, costs, timers and indices of globals.
+ *
+ * get() functions of InputDepConfig, BasicBlocksUtils, LibraryInfoManager, InputDepInstructionsRecorder and
+ * other analysis wide objects return the instance of the context active in the calling thread.
+ * A driver analysing several modules makes a context active for each module with AnalysisContext::Scope, so that
+ * modules can be analysed in parallel threads and no state is carried over between runs. If no context is active,
+ * process wide default context is used.
+ */
+class AnalysisContext
+{
+public:
+    AnalysisContext();
+    ~AnalysisContext();
+
+    AnalysisContext(const AnalysisContext&) = delete;
+    AnalysisContext& operator =(const AnalysisContext&) = delete;
+
+    /// Context active in the calling thread
+    static AnalysisContext& get();
+
+    /// Makes context active in the calling thread during its lifetime.
+    class Scope
+    {
+    public:
+        explicit Scope(AnalysisContext& context);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator =(const Scope&) = delete;
+
+    private:
+        AnalysisContext* m_previous;
+    };
+
+public:
+    InputDepConfig& get_config()
+    {
+        return *m_config;
+    }
+
+    BasicBlocksUtils& get_blocks_utils()
+    {
+        return *m_blocksUtils;
+    }
+
+    /// Created on first use, as it reads library configuration file set in config
+    LibraryInfoManager& get_library_info();
+    /// Uses read only library function models of given context, instead of loading them again
+    void share_library_info(AnalysisContext& context);
+
+    InputDepInstructionsRecorder& get_instructions_recorder()
+    {
+        return *m_instructionsRecorder;
+    }
+
+    AnalysisBudget& get_budget()
+    {
+        return *m_budget;
+    }
+
+    AnalysisCostRecorder& get_cost_recorder()
+    {
+        return *m_costRecorder;
+    }
+
+    AnalysisTiers& get_tiers()
+    {
+        return *m_tiers;
+    }
+
+    MemoryAccounting& get_memory_accounting()
+    {
+        return *m_memoryAccounting;
+    }
+
+    PhaseTimers& get_phase_timers()
+    {
+        return *m_phaseTimers;
+    }
+
+    GlobalsIndex& get_globals_index()
+    {
+        return *m_globalsIndex;
+    }
+
+private:
+    std::unique_ptr<InputDepConfig> m_config;
+    std::unique_ptr<BasicBlocksUtils> m_blocksUtils;
+    std::unique_ptr<LibraryInfoManager> m_libraryInfo;
+    std::unique_ptr<InputDepInstructionsRecorder> m_instructionsRecorder;
+    std::unique_ptr<AnalysisBudget> m_budget;
+    std::unique_ptr<AnalysisCostRecorder> m_costRecorder;
+    std::unique_ptr<AnalysisTiers> m_tiers;
+    std::unique_ptr<MemoryAccounting> m_memoryAccounting;
+    std::unique_ptr<PhaseTimers> m_phaseTimers;
+    std::unique_ptr<GlobalsIndex> m_globalsIndex;
+};
+
+} // namespace input_dependency
+
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "input-dependency/Analysis/AnalysisBudget.h"
+#include "input-dependency/Analysis/AnalysisContext.h"
+
+#include <chrono>
+#include <cstddef>
+#include <unordered_map>
+
+namespace llvm {
+class Function;
+}
+
+namespace input_dependency {
+
+/// Work done to analyze a function
+struct FunctionAnalysisCost
+{
+    unsigned long alias_queries = 0;
+    unsigned long map_merges = 0;
+    // value entries inserted or merged by map merges
+    unsigned long propagated_values = 0;
+    // values reflected on their dependents in loop blocks, one per value and block
+    unsigned long loop_reflected_values = 0;
+    // dependents of input dependent values resolved without reflecting remaining dependencies
+    unsigned long saturated_reflections = 0;
+    // input dependent entries skipped by finalization
+    unsigned long saturated_finalizations = 0;
+    // net growth of heap usage while function is analyzed
+    unsigned long allocated_bytes = 0;
+    double wall_ms = 0;
+};
+
+/**
+ * \class AnalysisCostRecorder
+ * \brief Attributes analysis work to the function being analyzed.
+ *
+ * Counters are updated from hot paths of the analysis. When recording is off, or no function is being analyzed,
+ * they go to a scratch record which is never reported.
+ */
+class AnalysisCostRecorder
+{
+public:
+    using FunctionCosts = std::unordered_map<llvm::Function*, FunctionAnalysisCost>;
+
+    static AnalysisCostRecorder& get()
+    {
+        return AnalysisContext::get().get_cost_recorder();
+    }
+
+    /// Attributes work done during its lifetime to given function, if recording.
+    class Scope
+    {
+    public:
+        explicit Scope(llvm::Function* F);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator =(const Scope&) = delete;
+
+    private:
+        FunctionAnalysisCost* m_cost;
+        FunctionAnalysisCost* m_previous;
+        std::chrono::steady_clock::time_point m_start;
+        std::size_t m_mallocUsage;
+    };
+
+private:
+    friend class AnalysisContext;
+    AnalysisCostRecorder();
+
+public:
+    void set_record(bool record)
+    {
+        m_record = record;
+    }
+
+    bool is_recording() const
+    {
+        return m_record;
+    }
+
+    void reset();
+
+    // counters also enforce the analysis budget of the function
+    void count_alias_query()
+    {
+        ++m_current->alias_queries;
+        AnalysisBudget::get().count_alias_query();
+    }
+
+    void count_map_merge(std::size_t merged_values)
+    {
+        ++m_current->map_merges;
+        m_current->propagated_values += merged_values;
+        AnalysisBudget::get().check_wall_time();
+    }
+
+    void count_loop_reflected_value()
+    {
+        ++m_current->loop_reflected_values;
+        AnalysisBudget::get().count_loop_reflected_value();
+    }
+
+    void count_saturated_reflection()
+    {
+        ++m_current->saturated_reflections;
+    }
+
+    void count_saturated_finalization()
+    {
+        ++m_current->saturated_finalizations;
+    }
+
+    const FunctionCosts& get_costs() const
+    {
+        return m_costs;
+    }
+
+private:
+    bool m_record;
+    FunctionCosts m_costs;
+    FunctionAnalysisCost m_scratch;
+    FunctionAnalysisCost* m_current;
+};
+
+} // namespace input_dependency
+
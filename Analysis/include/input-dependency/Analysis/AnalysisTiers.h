@@ -0,0 +1,92 @@
+#pragma once
+
+#include "input-dependency/Analysis/AnalysisContext.h"
+#include "input-dependency/Analysis/definitions.h"
+
+#include <unordered_map>
+
+namespace llvm {
+class CallGraph;
+class Function;
+class Instruction;
+class Module;
+}
+
+namespace input_dependency {
+
+/**
+ * \class AnalysisTiers
+ * \brief Fast flow insensitive prepass, finding functions which are trivially input independent.
+ *
+ * A function is trivially input independent if it does not use its arguments, does not reference globals,
+ * reads only memory of its own allocas, its address is not taken and it calls only trivially input independent
+ * functions and library functions without input dependencies. Such functions are not analysed by function
+ * analiser, as all their reachable instructions are input independent.
+ * Also counts functions by tier of analysis they got.
+ */
+class AnalysisTiers
+{
+public:
+    enum Tier {
+        INPUT_INDEP,
+        INPUT_DEP,
+        FULL
+    };
+
+    static AnalysisTiers& get()
+    {
+        return AnalysisContext::get().get_tiers();
+    }
+
+private:
+    friend class AnalysisContext;
+    AnalysisTiers() = default;
+
+public:
+    void set_enabled(bool enabled)
+    {
+        m_enabled = enabled;
+    }
+
+    bool is_enabled() const
+    {
+        return m_enabled;
+    }
+
+    void run(llvm::Module& M, llvm::CallGraph& callGraph);
+    void reset();
+
+    bool is_input_independent(llvm::Function* F) const
+    {
+        return m_inputIndepFunctions.find(F) != m_inputIndepFunctions.end();
+    }
+
+    /// Defined functions called from trivially input independent function F
+    const FunctionSet& get_called_functions(llvm::Function* F) const;
+
+    /// Marks F and all functions it calls input dependent, as analysis does for input dependent functions.
+    void mark_input_dep_function(llvm::Function* F) const;
+
+    void add_function_tier(Tier tier)
+    {
+        ++m_tierCounts[tier];
+    }
+
+    unsigned long get_tier_count(Tier tier) const
+    {
+        return m_tierCounts[tier];
+    }
+
+private:
+    bool is_library_call_input_independent(llvm::Function* F) const;
+    bool has_input_dependencies(llvm::Function* F, llvm::Module& M, FunctionSet& calledFunctions) const;
+
+private:
+    bool m_enabled = false;
+    FunctionSet m_inputIndepFunctions;
+    std::unordered_map<llvm::Function*, FunctionSet> m_calledFunctions;
+    unsigned long m_tierCounts[3] = {0, 0, 0};
+};
+
+} // namespace input_dependency
+
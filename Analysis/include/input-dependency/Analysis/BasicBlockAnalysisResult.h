@@ -51,6 +51,7 @@ public:
     void finalizeResults(const ArgumentDependenciesMap& dependentArgs) override;
     void finalizeGlobals(const GlobalVariableDependencyMap& globalsDeps) override;
     void dumpResults() const override;
+    void accountMemory(MemoryUsage& usage) const override;
 
 public:
     void analyze() override;
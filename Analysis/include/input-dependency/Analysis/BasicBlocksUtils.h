@@ -1,5 +1,7 @@
 #pragma once
 
+#include "input-dependency/Analysis/AnalysisContext.h"
+
 #include <unordered_set>
 
 namespace llvm {
@@ -14,15 +16,18 @@ class BasicBlocksUtils
 public:
     static BasicBlocksUtils& get()
     {
-        static BasicBlocksUtils blocksUtils;
-        return blocksUtils;
+        return AnalysisContext::get().get_blocks_utils();
     }
 
 public:
     void addUnreachableBlock(llvm::BasicBlock* block);
+    /// Removes unreachable blocks of F, e.g. when its analysis is aborted
+    void removeFunctionUnreachableBlocks(llvm::Function* F);
     bool isBlockUnreachable(llvm::BasicBlock* block) const;
     long unsigned getFunctionUnreachableBlocksCount(llvm::Function* F) const;
     long unsigned getFunctionUnreachableInstructionsCount(llvm::Function* F) const;
+    /// Clears collected blocks. Should be called when analysed modules are destroyed.
+    void reset();
 
 private:
     std::unordered_set<llvm::BasicBlock*> m_unreachableBlocks;
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "llvm/ADT/DenseMap.h"
+
+#include <utility>
+#include <vector>
+
+namespace llvm {
+class BasicBlock;
+class Loop;
+class LoopInfo;
+class Function;
+}
+
+namespace input_dependency {
+
+/**
+ * \class CFGTraversalOrder
+ * \brief Traversal order of function blocks, computed once per function and shared by function and loop analisers.
+ *
+ * Blocks reachable from entry are kept in a contiguous vector in reverse post order,
+ * arranged so that blocks of each loop form an interval starting with the loop header.
+ * At the level of a parent loop (or function) a child loop is a single node represented by its header,
+ * and its body is a subrange of the same vector.
+ * Blocks not reachable from entry are not in the order.
+ *
+ * Cycles of function level nodes which are not natural loops (irreducible control flow) are kept as
+ * contiguous irreducible regions, so that they can be solved by iteration, while the rest of the order stays topological.
+ */
+class CFGTraversalOrder
+{
+public:
+    using Blocks = std::vector<llvm::BasicBlock*>;
+    /// Block and the loop it is a header of, nullptr for non loop nodes
+    using LevelNodes = std::vector<std::pair<llvm::BasicBlock*, llvm::Loop*>>;
+
+public:
+    CFGTraversalOrder(llvm::Function& F, llvm::LoopInfo& LI);
+
+    CFGTraversalOrder(const CFGTraversalOrder&) = delete;
+    CFGTraversalOrder& operator =(const CFGTraversalOrder&) = delete;
+
+public:
+    const Blocks& getBlocks() const
+    {
+        return m_blocks;
+    }
+
+    bool hasBlock(llvm::BasicBlock* B) const;
+    /// Returns index of B in the order. B should be reachable.
+    unsigned getBlockIndex(llvm::BasicBlock* B) const;
+    /// Returns [begin, end) interval of loop blocks in the order. Header is at begin.
+    std::pair<unsigned, unsigned> getLoopInterval(llvm::Loop* L) const;
+    /// Returns header of outermost loop containing B, nullptr if B is not in a loop.
+    /// Does not use loop info, hence is valid after loop info is invalidated.
+    llvm::BasicBlock* getTopLevelLoopHeader(llvm::BasicBlock* B) const;
+    /**
+     * \brief Returns nodes of given loop in traversal order, nullptr for function level nodes.
+     * Nodes are blocks directly in L, and headers of immediate subloops of L paired with the subloop.
+     * Header of L is the first node, and is not paired with L.
+     */
+    LevelNodes getLevelNodes(llvm::Loop* L) const;
+    /// Returns irreducible region id of function level node B, -1 if B is not in irreducible region.
+    int getIrreducibleRegion(llvm::BasicBlock* B) const;
+
+    unsigned getIrreducibleRegionsCount() const
+    {
+        return m_regionsCount;
+    }
+
+private:
+    static constexpr unsigned UNDEF = ~0u;
+
+    void add_level(llvm::Loop* L,
+                   llvm::LoopInfo& LI,
+                   const llvm::DenseMap<llvm::Loop*, Blocks>& level_blocks);
+    void order_irreducible_regions(llvm::Function& F,
+                                   llvm::LoopInfo& LI,
+                                   Blocks& nodes,
+                                   llvm::DenseMap<llvm::BasicBlock*, unsigned>& regions);
+
+private:
+    Blocks m_blocks;
+    llvm::DenseMap<llvm::BasicBlock*, unsigned> m_indices;
+    // innermost loop of each block in the order
+    std::vector<llvm::Loop*> m_loops;
+    // for a loop header, index past the end of its loop; for other blocks next index
+    std::vector<unsigned> m_loopEnds;
+    // index of outermost loop header, UNDEF if block is not in a loop
+    std::vector<unsigned> m_topLevelHeaders;
+    // irreducible region of function level nodes, UNDEF for other blocks
+    std::vector<unsigned> m_regions;
+    unsigned m_regionsCount;
+};
+
+} // namespace input_dependency
+
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+namespace llvm {
+class CallGraph;
+class Function;
+class Module;
+}
+
+namespace input_dependency {
+
+/**
+ * \class CallGraphPartitioner
+ * \brief Splits functions of a module into partitions of balanced size with few call edges between them.
+ *
+ * SCCs are never split, as their functions are analysed together. SCCs are assigned bottom up to the partition they
+ * have most call edges with, among partitions with room left, and are then moved between partitions while moves
+ * reduce the number of cut call edges. Size of a function is its instructions count.
+ */
+class CallGraphPartitioner
+{
+public:
+    CallGraphPartitioner(llvm::Module& M, llvm::CallGraph& callGraph);
+
+public:
+    void partition(unsigned partitionsCount);
+
+    unsigned getPartitionsCount() const
+    {
+        return m_partitionSizes.size();
+    }
+
+    /// Partition of function defined in the module
+    unsigned getPartition(llvm::Function* F) const;
+
+    unsigned long getPartitionSize(unsigned partition) const
+    {
+        return m_partitionSizes[partition];
+    }
+
+    unsigned long getCallEdgesCount() const
+    {
+        return m_edgesCount;
+    }
+
+    unsigned long getCutEdgesCount() const;
+
+private:
+    void collectUnits();
+    void assignUnits(unsigned long capacity);
+    bool refine(unsigned long capacity);
+    std::unordered_map<unsigned, unsigned long> getPartitionConnections(unsigned unit) const;
+
+private:
+    llvm::Module& m_module;
+    llvm::CallGraph& m_callGraph;
+    /// SCCs in bottom up order, with their sizes and call edges to other SCCs, in both directions
+    std::vector<std::vector<llvm::Function*>> m_units;
+    std::vector<unsigned long> m_unitSizes;
+    std::vector<std::unordered_map<unsigned, unsigned long>> m_unitEdges;
+    std::unordered_map<llvm::Function*, unsigned> m_functionUnits;
+    std::vector<unsigned> m_unitPartitions;
+    std::vector<unsigned long> m_partitionSizes;
+    unsigned long m_edgesCount = 0;
+}; // class CallGraphPartitioner
+
+} // namespace input_dependency
+
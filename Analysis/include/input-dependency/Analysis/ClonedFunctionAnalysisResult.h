@@ -58,6 +58,7 @@ public:
      long unsigned get_input_indep_count() const override;
      long unsigned get_data_indep_count() const override;
      long unsigned get_input_unknowns_count() const override;
+     void accountMemory(MemoryUsage& usage) const override;
 
      ClonedFunctionAnalysisResult* toClonedFunctionAnalysisResult() override
      {
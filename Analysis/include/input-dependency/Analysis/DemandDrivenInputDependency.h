@@ -0,0 +1,162 @@
+#pragma once
+
+#include "input-dependency/Analysis/InputDependencyAnalysisInterface.h"
+#include "input-dependency/Analysis/definitions.h"
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace llvm {
+class AAResults;
+class BasicBlock;
+class Function;
+class Instruction;
+class Module;
+class PostDominatorTree;
+class Value;
+}
+
+namespace input_dependency {
+
+class VirtualCallSiteAnalysisResult;
+class IndirectCallSitesAnalysisResult;
+
+/**
+ * \class DemandDrivenInputDependency
+ * \brief Answers input dependency queries of single instructions without analysing the whole module.
+ *
+ * An instruction is input dependent if an input source is reachable backwards from it through def-use chains,
+ * control dependencies, memory modified by stores and calls, and call and return edges.
+ * Sources are arguments of functions without known callers, calls with unknown targets or to input dependent
+ * library functions, and memory which can not be attributed to an alloca, an argument or a global.
+ * The analysis is flow insensitive for memory and context insensitive for calls.
+ *
+ * Nodes of each explored slice are memoized, so that following queries stop at them. A query which slice grows
+ * over the limit is answered by the whole module analysis.
+ */
+class DemandDrivenInputDependency
+{
+public:
+    using AliasAnalysisInfoGetter = InputDependencyAnalysisInterface::AliasAnalysisInfoGetter;
+    using PostDominatorTreeGetter = std::function<const llvm::PostDominatorTree* (llvm::Function* F)>;
+    using FullAnalysisGetter = std::function<InputDependencyAnalysisInterface* ()>;
+
+public:
+    DemandDrivenInputDependency(llvm::Module* M);
+
+    DemandDrivenInputDependency(const DemandDrivenInputDependency&) = delete;
+    DemandDrivenInputDependency& operator =(const DemandDrivenInputDependency&) = delete;
+
+    void setVirtualCallSiteAnalysisResult(const VirtualCallSiteAnalysisResult* virtualCallSiteAnalysisRes);
+    void setIndirectCallSiteAnalysisResult(const IndirectCallSitesAnalysisResult* indirectCallSiteAnalysisRes);
+    void setAliasAnalysisInfoGetter(const AliasAnalysisInfoGetter& aliasAnalysisInfoGetter);
+    void setPostDominatorTreeGetter(const PostDominatorTreeGetter& postDomTreeGetter);
+    /// Whole module analysis for queries exceeding the slice limit. Called once, on the first such query.
+    void setFullAnalysisGetter(const FullAnalysisGetter& fullAnalysisGetter);
+    /// Maximal number of nodes in a slice, 0 means unlimited
+    void setSliceLimit(unsigned long limit);
+
+public:
+    bool isInputDependent(llvm::Instruction* I);
+    bool isInputDependent(llvm::BasicBlock* block);
+
+    unsigned long getQueriesCount() const
+    {
+        return m_queriesCount;
+    }
+
+    unsigned long getFallbacksCount() const
+    {
+        return m_fallbacksCount;
+    }
+
+    unsigned long getMemoizedNodesCount() const
+    {
+        return m_memo.size();
+    }
+
+private:
+    struct SliceNode
+    {
+        enum Kind {
+            VALUE,
+            CONTROL, // value is a basic block, controlled by input dependent branches
+            MEMORY   // value is a pointer in function, memory it points to is input dependent
+        };
+
+        Kind kind;
+        llvm::Value* value;
+        llvm::Function* function;
+
+        bool operator ==(const SliceNode& node) const
+        {
+            return kind == node.kind && value == node.value && function == node.function;
+        }
+    };
+
+    struct SliceNodeHash
+    {
+        std::size_t operator()(const SliceNode& node) const
+        {
+            return std::hash<llvm::Value*>()(node.value) ^ (std::hash<llvm::Function*>()(node.function) << 1) ^ node.kind;
+        }
+    };
+
+    using SliceNodes = std::vector<SliceNode>;
+    using Instructions = std::vector<llvm::Instruction*>;
+
+    enum class SliceResult {
+        INPUT_DEP,
+        INPUT_INDEP,
+        LIMIT_EXCEEDED
+    };
+
+private:
+    SliceResult slice(const SliceNode& query);
+    /// Collects nodes node depends on. Returns true if node itself is an input source.
+    bool collectDependencies(const SliceNode& node, SliceNodes& deps);
+    bool collectValueDependencies(llvm::Value* value, SliceNodes& deps);
+    bool collectInstructionDependencies(llvm::Instruction* I, SliceNodes& deps);
+    bool collectArgumentDependencies(llvm::Argument* arg, SliceNodes& deps);
+    bool collectCallDependencies(llvm::Instruction* callInstr, SliceNodes& deps);
+    bool collectControlDependencies(llvm::BasicBlock* block, SliceNodes& deps);
+    bool collectMemoryDependencies(llvm::Value* pointer, llvm::Function* F, SliceNodes& deps);
+    bool collectCallModDependencies(llvm::Instruction* callInstr, SliceNodes& deps);
+    void addActualArgumentDependencies(llvm::Value* actualArg, llvm::Function* F, SliceNodes& deps);
+
+    bool getCallees(llvm::Instruction* callInstr, FunctionSet& callees) const;
+    /// Returns direct call sites of F, or empty list if F may have callers which are not known
+    const Instructions& getCallSites(llvm::Function* F);
+    const Instructions& getControllingTerminators(llvm::BasicBlock* block);
+    const FunctionSet& getReferencingFunctions(llvm::GlobalVariable* global);
+    /// Returns true if address of global may be stored, returned or converted to integer
+    bool doesAddressEscape(llvm::GlobalVariable* global);
+
+    bool isInputDependentByFullAnalysis(llvm::Instruction* I);
+    bool isInputDependentByFullAnalysis(llvm::BasicBlock* block);
+    InputDependencyAnalysisInterface* getFullAnalysis();
+
+private:
+    using ControlDependencies = std::unordered_map<llvm::BasicBlock*, Instructions>;
+
+    llvm::Module* m_module;
+    const VirtualCallSiteAnalysisResult* m_virtualCallSiteAnalysisRes;
+    const IndirectCallSitesAnalysisResult* m_indirectCallSiteAnalysisRes;
+    AliasAnalysisInfoGetter m_aliasAnalysisInfoGetter;
+    PostDominatorTreeGetter m_postDomTreeGetter;
+    FullAnalysisGetter m_fullAnalysisGetter;
+    InputDependencyAnalysisInterface* m_fullAnalysis;
+    unsigned long m_sliceLimit;
+
+    std::unordered_map<SliceNode, bool, SliceNodeHash> m_memo;
+    std::unordered_map<llvm::Function*, Instructions> m_callSites;
+    std::unordered_map<llvm::Function*, ControlDependencies> m_controlDependencies;
+    std::unordered_map<llvm::GlobalVariable*, FunctionSet> m_referencingFunctions;
+    std::unordered_map<llvm::GlobalVariable*, bool> m_addressEscapes;
+    unsigned long m_queriesCount;
+    unsigned long m_fallbacksCount;
+}; // class DemandDrivenInputDependency
+
+} // namespace input_dependency
+
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "input-dependency/Analysis/DemandDrivenInputDependency.h"
+#include "input-dependency/Analysis/FunctionAnalyses.h"
+#include "input-dependency/Analysis/InputDependencyAnalysisInterface.h"
+
+#include "llvm/Pass.h"
+
+#include <memory>
+#include <unordered_map>
+
+namespace llvm {
+class CallGraph;
+class Module;
+class TargetLibraryInfoImpl;
+}
+
+namespace input_dependency {
+
+class IndirectCallSitesAnalysis;
+
+/**
+ * \class DemandDrivenInputDependencyPass
+ * \brief Provides demand driven input dependency queries, for passes asking about a few instructions only.
+ *
+ * Whole module input dependency analysis is run only if a query exceeds the slice limit.
+ * Queries are valid after runOnModule, e.g. from passes requiring this pass. Function level analyses of queried
+ * functions are built by the pass itself and kept with it, not taken from the pass manager.
+ */
+class DemandDrivenInputDependencyPass : public llvm::ModulePass
+{
+public:
+    static char ID;
+
+    DemandDrivenInputDependencyPass()
+        : llvm::ModulePass(ID)
+    {
+    }
+
+public:
+    void getAnalysisUsage(llvm::AnalysisUsage& AU) const override;
+    bool runOnModule(llvm::Module& M) override;
+    bool doFinalization(llvm::Module& M) override;
+
+public:
+    DemandDrivenInputDependency& getDemandDrivenInputDependency()
+    {
+        return *m_demandAnalysis;
+    }
+
+private:
+    FunctionAnalyses& getFunctionAnalyses(llvm::Function* F);
+    InputDependencyAnalysisInterface* runFullAnalysis();
+    void printQueriedFunctions();
+    void verifyWithFullAnalysis();
+
+private:
+    llvm::Module* m_module;
+    llvm::CallGraph* m_callGraph;
+    const IndirectCallSitesAnalysis* m_indirectCallAnalysis;
+    std::unique_ptr<llvm::TargetLibraryInfoImpl> m_TLII;
+    std::unordered_map<llvm::Function*, std::unique_ptr<FunctionAnalyses>> m_functionAnalyses;
+    std::unique_ptr<DemandDrivenInputDependency> m_demandAnalysis;
+    std::unique_ptr<InputDependencyAnalysisInterface> m_fullAnalysis;
+};
+
+} // namespace input_dependency
+
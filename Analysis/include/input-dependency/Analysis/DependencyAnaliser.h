@@ -107,9 +107,13 @@ protected:
     void updateGlobalsAfterFunctionExecution(llvm::Function* F,
                                              const ArgumentDependenciesMap& functionArgDeps,
                                              bool is_recursive);
+    void updateGlobalsAfterFallbackFunction(llvm::Function* F);
     void updateCallInputDependentOutArgDependencies(llvm::CallInst* callInst);
     void updateInvokeInputDependentOutArgDependencies(llvm::InvokeInst* invokeInst);
 
+    /// Marks function passed as a callback input dependent, once analysis of this function finishes within budget
+    void markInputDependentFunction(llvm::Function* F);
+
     void updateLibFunctionCallInstOutArgDependencies(llvm::CallInst* callInst, llvm::Function* F, const ArgumentDependenciesMap& argDepMap);
     void updateLibFunctionInvokeInstOutArgDependencies(llvm::InvokeInst* callInst, llvm::Function* F, const ArgumentDependenciesMap& argDepMap);
     void updateLibFunctionCallInstructionDependencies(llvm::CallInst* callInst, llvm::Function* F, const ArgumentDependenciesMap& argDepMap);
@@ -121,6 +125,7 @@ private:
     //TODO: make const
     ArgumentDependenciesMap gatherFunctionCallSiteInfo(llvm::CallInst* callInst, llvm::Function* F);
     ArgumentDependenciesMap gatherFunctionInvokeSiteInfo(llvm::InvokeInst* invokeInst, llvm::Function* F);
+    /// Dependencies of all globals referenced by F, including transitively, at the call site
     GlobalVariableDependencyMap gatherGlobalsForFunctionCall(llvm::Function* F);
 
     using ArgumentValueGetter = std::function<llvm::Value* (unsigned formalArgNo)>;
@@ -132,6 +137,10 @@ private:
                                                  const ArgumentValueGetter& actualArgumentGetter);
     void updateInputDepLibFunctionCallOutArgDependencies(llvm::Function* F,
                                                          const DependencyAnaliser::ArgumentValueGetter& actualArgumentGetter);
+    /// Updates dependencies of a call to function found trivially input independent by the prepass
+    void updateInputIndepFunctionCallDependencies(llvm::Instruction* callInstr,
+                                                  llvm::Function* F,
+                                                  const ArgumentValueGetter& actualArgumentGetter);
     using ArgumentValueGetterByIndex = std::function<llvm::Value* (unsigned index)>;
     void updateFunctionInputDepOutArgDependencies(llvm::FunctionType* FType,
                                                   const ArgumentValueGetterByIndex& actualArgumentGetter);
@@ -5,6 +5,8 @@
 
 namespace input_dependency {
 
+class MemoryUsage;
+
 /**
 * \class DependencyAnalysisResult
 * Interface for providing dependency analysis information.
@@ -41,6 +43,8 @@ public:
     virtual void finalizeResults(const ArgumentDependenciesMap& dependentArgs) = 0;
     virtual void finalizeGlobals(const GlobalVariableDependencyMap& globalsDeps) = 0;
     virtual void dumpResults() const = 0;
+    /// Adds estimated memory held by results to given usage
+    virtual void accountMemory(MemoryUsage& usage) const = 0;
     /// \}
 
     /// \name Abstract interface for getting analysis results
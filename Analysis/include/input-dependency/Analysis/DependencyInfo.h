@@ -133,6 +133,15 @@ public:
         m_dependency = dep;
     }
 
+    /// Sets to INPUT_DEP, the top of the lattice, dropping argument dependencies.
+    /// Value dependencies can not change INPUT_DEP either, but are kept until globals are finalized, to report global
+    /// dependent instructions.
+    void saturate()
+    {
+        m_dependency = INPUT_DEP;
+        m_argumentDependencies.clear();
+    }
+
     // for debugging
     std::string getDependencyName() const
     {
@@ -152,6 +161,12 @@ public:
 public:
     void mergeDependencies(const DepInfo& info)
     {
+        if (isInputDep() || info.isInputDep()) {
+            saturate();
+            this->m_valueDependencies.insert(info.m_valueDependencies.begin(),
+                                             info.m_valueDependencies.end());
+            return;
+        }
         this->m_dependency = std::max(this->m_dependency, info.m_dependency);
         this->m_valueDependencies.insert(info.m_valueDependencies.begin(),
                                          info.m_valueDependencies.end());
@@ -161,6 +176,12 @@ public:
 
     void mergeDependencies(DepInfo&& info)
     {
+        if (isInputDep() || info.isInputDep()) {
+            saturate();
+            this->m_valueDependencies.insert(info.m_valueDependencies.begin(),
+                                             info.m_valueDependencies.end());
+            return;
+        }
         this->m_dependency = std::max(this->m_dependency, info.m_dependency);
         this->m_valueDependencies.insert(info.m_valueDependencies.begin(),
                                          info.m_valueDependencies.end());
@@ -170,6 +191,9 @@ public:
 
     void mergeDependencies(const ArgumentSet& argDeps)
     {
+        if (isInputDep()) {
+            return;
+        }
         this->m_argumentDependencies.insert(argDeps.begin(), argDeps.end());
     }
 
@@ -180,10 +204,13 @@ public:
 
     void mergeDependency(Dependency dep)
     {
+        if (dep == INPUT_DEP) {
+            saturate();
+            return;
+        }
         this->m_dependency = std::max(this->m_dependency, dep);
     }
 
-
 private:
     Dependency m_dependency;
     ArgumentSet m_argumentDependencies;
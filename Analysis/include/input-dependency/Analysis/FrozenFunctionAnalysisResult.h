@@ -0,0 +1,109 @@
+#pragma once
+
+#include "input-dependency/Analysis/FunctionInputDependencyResultInterface.h"
+
+#include "llvm/ADT/DenseMap.h"
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace llvm {
+
+class Function;
+class BasicBlock;
+class Instruction;
+
+} // namespace llvm
+
+namespace input_dependency {
+
+/**
+* \class FrozenFunctionAnalysisResult
+* \brief Compact, read-only form of finalized function analysis results.
+*
+* Keeps only classification flags of instructions and blocks, call site dependencies and statistics counts.
+* Intermediate value dependencies of block and loop results are not kept, thus frozen results can not be
+* refined any further, e.g. cloned for given arguments.
+* Instructions and blocks created after freezing are reported as input dependent.
+**/
+class FrozenFunctionAnalysisResult final : public FunctionInputDependencyResultInterface
+{
+public:
+    /// Freezes results of finalized analysis \p result.
+    explicit FrozenFunctionAnalysisResult(FunctionInputDependencyResultInterface& result);
+
+    FrozenFunctionAnalysisResult(const FrozenFunctionAnalysisResult&) = delete;
+    FrozenFunctionAnalysisResult& operator =(const FrozenFunctionAnalysisResult&) = delete;
+
+public:
+    void analyze() override {}
+    llvm::Function* getFunction() override;
+    const llvm::Function* getFunction() const override;
+    bool isInputDepFunction() const override;
+    void setIsInputDepFunction(bool isInputDep) override;
+    bool isExtractedFunction() const override;
+    void setIsExtractedFunction(bool isExtracted) override;
+    bool isInputDependent(llvm::Instruction* instr) const override;
+    bool isInputDependent(const llvm::Instruction* instr) const override;
+    bool isInputIndependent(llvm::Instruction* instr) const override;
+    bool isInputIndependent(const llvm::Instruction* instr) const override;
+    bool isInputDependentBlock(llvm::BasicBlock* block) const override;
+    bool isControlDependent(llvm::Instruction* I) const override;
+    bool isDataDependent(llvm::Instruction* I) const override;
+    bool isArgumentDependent(llvm::Instruction* I) const override;
+    bool isArgumentDependent(llvm::BasicBlock* block) const override;
+    bool isGlobalDependent(llvm::Instruction* I) const override;
+    InstructionClassification getInstructionClassification() override;
+
+    FunctionSet getCallSitesData() const override;
+    FunctionCallDepInfo getFunctionCallDepInfo(llvm::Function* F) const override;
+    bool changeFunctionCall(const llvm::Instruction* callInstr, llvm::Function* oldF, llvm::Function* newF) override;
+
+    long unsigned get_input_dep_blocks_count() const override;
+    long unsigned get_input_indep_blocks_count() const override;
+    long unsigned get_unreachable_blocks_count() const override;
+    long unsigned get_unreachable_instructions_count() const override;
+    long unsigned get_input_dep_count() const override;
+    long unsigned get_input_indep_count() const override;
+    long unsigned get_data_indep_count() const override;
+    long unsigned get_input_unknowns_count() const override;
+    void accountMemory(MemoryUsage& usage) const override;
+
+private:
+    enum InstructionFlags : uint8_t {
+        INPUT_DEP = 1 << 0,
+        INPUT_INDEP = 1 << 1,
+        DATA_DEP = 1 << 2,
+        ARGUMENT_DEP = 1 << 3,
+        GLOBAL_DEP = 1 << 4
+    };
+
+    enum BlockFlags : uint8_t {
+        INPUT_DEP_BLOCK = 1 << 0,
+        ARGUMENT_DEP_BLOCK = 1 << 1
+    };
+
+    bool hasInstructionFlag(const llvm::Instruction* I, uint8_t flag, bool unknown) const;
+    bool hasBlockFlag(const llvm::BasicBlock* B, uint8_t flag, bool unknown) const;
+
+private:
+    llvm::Function* m_F;
+    bool m_is_inputDep;
+    bool m_is_extracted;
+    llvm::DenseMap<const llvm::Instruction*, uint8_t> m_instructionFlags;
+    llvm::DenseMap<const llvm::BasicBlock*, uint8_t> m_blockFlags;
+    FunctionSet m_calledFunctions;
+    std::unordered_map<llvm::Function*, FunctionCallDepInfo> m_functionCallDepInfo;
+
+    long unsigned m_inputDepBlocksCount;
+    long unsigned m_inputIndepBlocksCount;
+    long unsigned m_unreachableBlocksCount;
+    long unsigned m_unreachableInstructionsCount;
+    long unsigned m_inputDepCount;
+    long unsigned m_inputIndepCount;
+    long unsigned m_dataIndepCount;
+    long unsigned m_inputUnknownsCount;
+}; // class FrozenFunctionAnalysisResult
+
+} // namespace input_dependency
+
@@ -70,6 +70,7 @@ public:
     long unsigned get_input_indep_count() const override;
     long unsigned get_data_indep_count() const override;
     long unsigned get_input_unknowns_count() const override;
+    void accountMemory(MemoryUsage& usage) const override;
 
     FunctionAnaliser* toFunctionAnalysisResult() override
     {
@@ -107,6 +108,7 @@ public:
 
     /// \name Intermediate input dep results interface
     /// \{
+    bool hasCallArgumentInfo(llvm::Function* F) const;
     const DependencyAnaliser::ArgumentDependenciesMap& getCallArgumentInfo(llvm::Function* F) const;
     DependencyAnaliser::GlobalVariableDependencyMap getCallGlobalsInfo(llvm::Function* F) const;
     bool isOutArgInputIndependent(llvm::Argument* arg) const;
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/AssumptionCache.h"
+#include "llvm/Analysis/BasicAliasAnalysis.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/PostDominators.h"
+#include "llvm/Analysis/TargetLibraryInfo.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Module.h"
+
+namespace input_dependency {
+
+/**
+ * \class FunctionAnalyses
+ * \brief Function level analyses needed by input dependency analysis, built without a pass manager.
+ *
+ * Results stay valid as long as the object and the function body live, independent of any pass run.
+ * Alias analysis is basic alias analysis only.
+ */
+struct FunctionAnalyses
+{
+    FunctionAnalyses(llvm::Function& F, const llvm::TargetLibraryInfoImpl& TLII)
+        : DT(F)
+        , LI(DT)
+        , AC(F)
+        , TLI(TLII)
+        , BAR(F.getParent()->getDataLayout(), F, TLI, AC, &DT, &LI)
+        , AAR(TLI)
+    {
+        PDT.recalculate(F);
+        AAR.addAAResult(BAR);
+    }
+
+    FunctionAnalyses(const FunctionAnalyses&) = delete;
+    FunctionAnalyses& operator =(const FunctionAnalyses&) = delete;
+
+    llvm::DominatorTree DT;
+    llvm::PostDominatorTree PDT;
+    llvm::LoopInfo LI;
+    llvm::AssumptionCache AC;
+    llvm::TargetLibraryInfo TLI;
+    llvm::BasicAAResult BAR;
+    llvm::AAResults AAR;
+};
+
+} // namespace input_dependency
+
@@ -2,6 +2,10 @@
 
 #include "input-dependency/Analysis/ValueDepInfo.h"
 
+#include "llvm/ADT/DenseMap.h"
+
+#include <vector>
+
 namespace llvm {
 
 class Argument;
@@ -13,13 +17,24 @@ class InvokeInst;
 
 namespace input_dependency {
 
+/**
+ * \class FunctionCallDepInfo
+ * \brief Argument and global dependencies of all call sites of a function.
+ *
+ * Call site dependencies are kept in vectors indexed by call site ordinal, the ordinal of a call instruction being
+ * looked up in a dense map. Removing a call site moves the last call site to its ordinal, thus iteration order is
+ * unspecified.
+ * Dependencies merged over all call sites are maintained as call sites are added, merged argument dependencies being
+ * indexed by formal argument number. Merged dependencies are recomputed on next request after call sites are removed,
+ * finalized or mutably accessed.
+ */
 class FunctionCallDepInfo
 {
 public:
     using ArgumentDependenciesMap = std::unordered_map<llvm::Argument*, ValueDepInfo>;
     using GlobalVariableDependencyMap = std::unordered_map<llvm::GlobalVariable*, ValueDepInfo>;
-    using CallSiteArgumentsDependenciesMap = std::unordered_map<const llvm::Instruction*, ArgumentDependenciesMap>;
-    using CallSiteGloblasDependenciesMap = std::unordered_map<const llvm::Instruction*, GlobalVariableDependencyMap>;
+    using CallSiteArgumentsDependencies = std::vector<std::pair<const llvm::Instruction*, ArgumentDependenciesMap>>;
+    using CallSiteGlobalsDependencies = std::vector<std::pair<const llvm::Instruction*, GlobalVariableDependencyMap>>;
 
 public:
     FunctionCallDepInfo();
@@ -50,8 +65,8 @@ public:
     void removeCall(const llvm::Instruction* callInst);
 
     const InstrSet& getCallSites() const;
-    const CallSiteArgumentsDependenciesMap& getCallsArgumentDependencies() const;
-    const CallSiteGloblasDependenciesMap& getCallsGlobalsDependencies() const;
+    const CallSiteArgumentsDependencies& getCallsArgumentDependencies() const;
+    const CallSiteGlobalsDependencies& getCallsGlobalsDependencies() const;
 
     const ArgumentDependenciesMap& getArgumentDependenciesForCall(const llvm::CallInst* callInst) const;
     const ArgumentDependenciesMap& getArgumentDependenciesForInvoke(const llvm::InvokeInst* invokeInst) const;
@@ -81,16 +96,32 @@ private:
     bool isValidInstruction(const llvm::Instruction* instr) const;
     void addCallSiteArguments(const llvm::Instruction* instr, const ArgumentDependenciesMap& argDeps);
     void addCallSiteGlobals(const llvm::Instruction* instr, const GlobalVariableDependencyMap& globalDeps);
+    const ArgumentDependenciesMap& findArgumentsDependencies(const llvm::Instruction* instr) const;
+    const GlobalVariableDependencyMap& findGlobalsDependencies(const llvm::Instruction* instr) const;
+
+    void mergeArgumentDependencies(const ArgumentDependenciesMap& argDeps) const;
+    void mergeGlobalsDependencies(const GlobalVariableDependencyMap& globalDeps) const;
+    void updateMergedDependencies() const;
+    void verifyMergedDependencies() const;
 
     template <class Key>
     void markAllInputDependent(std::unordered_map<Key, ValueDepInfo>& argDeps);
 
 private:
+    using CallSiteOrdinals = llvm::DenseMap<const llvm::Instruction*, unsigned>;
+
     const llvm::Function* m_F;
-    CallSiteArgumentsDependenciesMap m_callsArgumentsDeps;
-    CallSiteGloblasDependenciesMap m_callsGlobalsDeps;
+    CallSiteArgumentsDependencies m_callsArgumentsDeps;
+    CallSiteGlobalsDependencies m_callsGlobalsDeps;
+    CallSiteOrdinals m_callsArgumentsOrdinals;
+    CallSiteOrdinals m_callsGlobalsOrdinals;
     InstrSet m_callSites;
     bool m_isCallback;
+
+    /// Indexed by argument number, null argument for arguments not passed at any call site
+    mutable std::vector<std::pair<llvm::Argument*, ValueDepInfo>> m_mergedArgumentsDeps;
+    mutable GlobalVariableDependencyMap m_mergedGlobalsDeps;
+    mutable bool m_mergedDepsValid;
 };
 
 } // namespace input_dependency
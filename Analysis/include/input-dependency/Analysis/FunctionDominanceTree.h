@@ -2,46 +2,32 @@
 
 #include "llvm/Pass.h"
 
-#include <memory>
 #include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
 namespace llvm {
+class CallGraph;
 class Function;
 class Module;
 }
 
 namespace input_dependency {
 
+/**
+ * \class FunctionDominanceTree
+ * \brief Dominator tree over call graph.
+ *
+ * Function A dominates function B if every call chain from program entry to B goes through A.
+ * Functions are densely indexed, call graph is kept in CSR form, dominators are computed with
+ * Cooper-Harvey-Kennedy iterative algorithm over reverse post order.
+ * Dominance queries are constant time using DFS interval numbering of the dominator tree.
+ * Index 0 is a virtual root calling all entry functions (functions called from external calling node),
+ * as well as functions not reachable from any entry.
+ */
 class FunctionDominanceTree
 {
 public:
-    class DomNode;
-    using DomNodeT = std::shared_ptr<DomNode>;
-
-    class DomNode
-    {
-    public:
-        using Dominators = std::unordered_set<DomNodeT>;
-
-    public:
-        DomNode(llvm::Function* f);
-
-    public:
-        void add_dominator(DomNodeT dom);
-        bool postdominates(DomNodeT dom) const;
-
-        Dominators& get_dominators();
-        const Dominators& get_dominators() const;
-        llvm::Function* get_function();
-
-        void dump() const;
-
-    private:
-        llvm::Function* function;
-        //  functions calling current function
-        Dominators dominators;
-    };
+    using FunctionList = std::vector<llvm::Function*>;
 
 public:
     FunctionDominanceTree() = default;
@@ -50,16 +36,45 @@ public:
     FunctionDominanceTree& operator =(const FunctionDominanceTree&) = delete;
 
 public:
-    void add_function(llvm::Function*, DomNodeT doms);
-    DomNodeT get_or_create_function_dominance_node(llvm::Function* f);
-    void add_function_dominator(llvm::Function* f, DomNodeT domNode);
-    DomNodeT get_function_dominators(llvm::Function* f);
-    const DomNodeT get_function_dominators(llvm::Function* f) const;
+    void build(llvm::Module& M, llvm::CallGraph& CG);
+
+    bool has_function(llvm::Function* f) const;
+    /// Returns immediate dominator of f, nullptr if f is dominated only by virtual root
+    llvm::Function* get_immediate_dominator(llvm::Function* f) const;
+    /// Returns true if dom dominates f. Every function dominates itself.
+    bool dominates(llvm::Function* dom, llvm::Function* f) const;
+    /// Returns functions immediately dominated by f
+    FunctionList get_dominated_functions(llvm::Function* f) const;
+    /// Returns functions calling f
+    FunctionList get_callers(llvm::Function* f) const;
 
     void dump() const;
 
 private:
-    std::unordered_map<llvm::Function*, DomNodeT> function_dominators;
+    static constexpr unsigned ROOT = 0;
+    static constexpr unsigned UNDEF = ~0u;
+
+    unsigned get_index(llvm::Function* f) const;
+    void compute_reverse_post_order(std::vector<unsigned>& rpo) const;
+    void compute_dominators(const std::vector<unsigned>& rpo);
+    void compute_dfs_intervals();
+    unsigned intersect(unsigned node1, unsigned node2, const std::vector<unsigned>& rpo_numbers) const;
+
+private:
+    // index 0 is virtual root with nullptr function
+    FunctionList m_functions;
+    std::unordered_map<llvm::Function*, unsigned> m_indices;
+    // CSR call graph. Successors of function i are m_callees[m_calleeOffsets[i], m_calleeOffsets[i + 1])
+    std::vector<unsigned> m_calleeOffsets;
+    std::vector<unsigned> m_callees;
+    std::vector<unsigned> m_callerOffsets;
+    std::vector<unsigned> m_callers;
+    // dominator tree
+    std::vector<unsigned> m_idoms;
+    std::vector<unsigned> m_childOffsets;
+    std::vector<unsigned> m_children;
+    std::vector<unsigned> m_dfsIn;
+    std::vector<unsigned> m_dfsOut;
 };
 
 
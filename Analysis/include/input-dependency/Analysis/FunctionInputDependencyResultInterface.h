@@ -1,6 +1,7 @@
 #pragma once
 
 #include "input-dependency/Analysis/FunctionCallDepInfo.h"
+#include "input-dependency/Analysis/InstructionClassification.h"
 
 namespace llvm {
 
@@ -16,7 +17,9 @@ namespace input_dependency {
 class FunctionAnaliser;
 class ClonedFunctionAnalysisResult;
 class InputDependentFunctionAnalysisResult;
+class InputIndependentFunctionAnalysisResult;
 class CachedFunctionAnalysisResult;
+class MemoryUsage;
 
 /// Defines interface to request for input dependency information
 class FunctionInputDependencyResultInterface
@@ -45,6 +48,11 @@ public:
     virtual bool isArgumentDependent(llvm::Instruction* I) const = 0;
     virtual bool isArgumentDependent(llvm::BasicBlock* block) const = 0;
     virtual bool isGlobalDependent(llvm::Instruction* I) const = 0;
+    /// Classification of all instructions of the function at once, in instruction order
+    virtual InstructionClassification getInstructionClassification()
+    {
+        return InstructionClassification(*this);
+    }
     // these functions may be moved to separate interface, as they are relevent only for some implementations of the this interface
     virtual FunctionSet getCallSitesData() const = 0;
     virtual FunctionCallDepInfo getFunctionCallDepInfo(llvm::Function* F) const = 0;
@@ -64,6 +72,11 @@ public:
     virtual long unsigned get_data_indep_count() const = 0;
     virtual long unsigned get_input_unknowns_count() const = 0;
 
+    // memory accounting for statistics
+    virtual void accountMemory(MemoryUsage& usage) const
+    {
+    }
+
     // cast interface
     virtual FunctionAnaliser* toFunctionAnalysisResult()
     {
@@ -80,6 +93,11 @@ public:
         return nullptr;
     }
 
+    virtual InputIndependentFunctionAnalysisResult* toInputIndependentFunctionAnalysisResult()
+    {
+        return nullptr;
+    }
+
     virtual CachedFunctionAnalysisResult* toCachedInputDependentFunctionAnalysisResult()
     {
         return nullptr;
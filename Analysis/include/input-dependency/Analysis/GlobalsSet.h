@@ -0,0 +1,170 @@
+#pragma once
+
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
+
+#include <cassert>
+#include <iterator>
+#include <vector>
+
+namespace llvm {
+class GlobalVariable;
+class Module;
+}
+
+namespace input_dependency {
+
+/**
+ * \class GlobalsIndex
+ * \brief Dense indices of global variables, shared by all GlobalsSet of an analysis run.
+ *
+ * Globals of the analysed module are indexed in module order before analysis; globals met otherwise are indexed on
+ * first use. Indices are never reused within a run.
+ */
+class GlobalsIndex
+{
+public:
+    static GlobalsIndex& get();
+
+private:
+    friend class AnalysisContext;
+    GlobalsIndex() = default;
+
+public:
+    void add_module(llvm::Module& M);
+
+    unsigned get_index(llvm::GlobalVariable* global);
+    /// Index of global, or -1 if global has not been indexed
+    int find_index(llvm::GlobalVariable* global) const;
+
+    llvm::GlobalVariable* get_global(unsigned index) const
+    {
+        return m_globals[index];
+    }
+
+    unsigned size() const
+    {
+        return m_globals.size();
+    }
+
+private:
+    llvm::DenseMap<llvm::GlobalVariable*, unsigned> m_indices;
+    std::vector<llvm::GlobalVariable*> m_globals;
+}; // class GlobalsIndex
+
+/**
+ * \class GlobalsSet
+ * \brief Set of global variables, as a bitset over GlobalsIndex.
+ *
+ * Referenced and modified globals of functions, loops and blocks are merged at every call site and on every
+ * propagation up to the function; merges are bitwise or of the sets instead of hash set insertions.
+ * Only the mod/ref sets are bitsets: dependencies of globals at call sites are still gathered per referenced global
+ * of the callee, see DependencyAnaliser::gatherGlobalsForFunctionCall.
+ * Iteration is in index order.
+ * A set is bound to the index of the analysis context active on its first insertion, and stays valid when used from
+ * another context, e.g. when results are read after the run.
+ */
+class GlobalsSet
+{
+public:
+    using value_type = llvm::GlobalVariable*;
+
+    class const_iterator : public std::iterator<std::forward_iterator_tag, llvm::GlobalVariable*>
+    {
+    public:
+        const_iterator(const GlobalsIndex* globalsIndex, const llvm::BitVector& bits, int index)
+            : m_globalsIndex(globalsIndex)
+            , m_bits(&bits)
+            , m_index(index)
+        {
+        }
+
+        llvm::GlobalVariable* operator*() const
+        {
+            return m_globalsIndex->get_global(m_index);
+        }
+
+        const_iterator& operator++()
+        {
+            m_index = m_bits->find_next(m_index);
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator it = *this;
+            ++*this;
+            return it;
+        }
+
+        bool operator ==(const const_iterator& other) const
+        {
+            return m_index == other.m_index;
+        }
+
+        bool operator !=(const const_iterator& other) const
+        {
+            return m_index != other.m_index;
+        }
+
+    private:
+        const GlobalsIndex* m_globalsIndex;
+        const llvm::BitVector* m_bits;
+        int m_index;
+    };
+
+    using iterator = const_iterator;
+
+public:
+    bool insert(llvm::GlobalVariable* global);
+
+    void insert(const GlobalsSet& globals)
+    {
+        if (globals.empty()) {
+            return;
+        }
+        assert(!m_globalsIndex || m_globalsIndex == globals.m_globalsIndex);
+        m_globalsIndex = globals.m_globalsIndex;
+        m_bits |= globals.m_bits;
+    }
+
+    bool count(llvm::GlobalVariable* global) const;
+
+    bool empty() const
+    {
+        return m_bits.none();
+    }
+
+    unsigned size() const
+    {
+        return m_bits.count();
+    }
+
+    void clear()
+    {
+        m_bits.clear();
+    }
+
+    const llvm::BitVector& getBits() const
+    {
+        return m_bits;
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(m_globalsIndex, m_bits, m_bits.find_first());
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(m_globalsIndex, m_bits, -1);
+    }
+
+private:
+    /// Index the set's bits refer to, null until the first insertion
+    GlobalsIndex* m_globalsIndex = nullptr;
+    llvm::BitVector m_bits;
+}; // class GlobalsSet
+
+} // namespace input_dependency
+
@@ -1,6 +1,10 @@
 #pragma once
 
+#include "input-dependency/Analysis/AnalysisContext.h"
+
+#include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "llvm/IR/Function.h"
 
@@ -14,8 +18,7 @@ class InputDepConfig
 public:
     static InputDepConfig& get()
     {
-        static InputDepConfig config;
-        return config;
+        return AnalysisContext::get().get_config();
     }
 
 public:
@@ -31,6 +34,17 @@ public:
         goto_unsafe = g_unsafe;
     }
 
+    /// Irreducible regions not converging in given number of iterations are considered input dependent.
+    void set_irreducible_region_iterations(unsigned iterations)
+    {
+        irreducible_region_iterations = iterations;
+    }
+
+    unsigned get_irreducible_region_iterations() const
+    {
+        return irreducible_region_iterations;
+    }
+
     void set_lib_config_file(const std::string& config_file)
     {
         lib_config_file = config_file;
@@ -56,6 +70,131 @@ public:
         return use_cache;
     }
 
+    void set_reachables_only(bool reachables_only)
+    {
+        analyze_reachables_only = reachables_only;
+    }
+
+    bool is_reachables_only() const
+    {
+        return analyze_reachables_only;
+    }
+
+    void set_entry_points(const std::vector<std::string>& entry_points)
+    {
+        m_entry_points = entry_points;
+    }
+
+    const std::vector<std::string>& get_entry_points() const
+    {
+        return m_entry_points;
+    }
+
+    void set_exported_entry_points(bool exported)
+    {
+        exported_entry_points = exported;
+    }
+
+    bool is_exported_entry_points() const
+    {
+        return exported_entry_points;
+    }
+
+    /// Statistics of the analysed module are written to given file, even without -dependency-stats.
+    /// Used by drivers analysing several modules, to write statistics of each module to separate file.
+    void set_stats_file(const std::string& file)
+    {
+        stats_file = file;
+    }
+
+    bool has_stats_file() const
+    {
+        return !stats_file.empty();
+    }
+
+    const std::string& get_stats_file() const
+    {
+        return stats_file;
+    }
+
+    /// Summary of the analysed module is written to given file, to be linked with summaries of other modules.
+    void set_summary_file(const std::string& file)
+    {
+        summary_file = file;
+    }
+
+    bool has_summary_file() const
+    {
+        return !summary_file.empty();
+    }
+
+    const std::string& get_summary_file() const
+    {
+        return summary_file;
+    }
+
+    /// Thin link results of the module, used in finalization of arguments and globals and as library info.
+    void set_link_file(const std::string& file)
+    {
+        link_file = file;
+    }
+
+    bool has_link_file() const
+    {
+        return !link_file.empty();
+    }
+
+    const std::string& get_link_file() const
+    {
+        return link_file;
+    }
+
+    void set_compact_results(bool compact)
+    {
+        compact_results = compact;
+    }
+
+    /// Called by passes which need full function analysers after finalization, e.g. to clone results for arguments.
+    void request_function_analisers()
+    {
+        function_analisers_requested = true;
+    }
+
+    /// Results are compacted after finalization, unless some pass needs full function analysers.
+    bool is_compact_results() const
+    {
+        return compact_results && !function_analisers_requested;
+    }
+
+    /// Dependencies merged over call sites are checked against merging all call sites again on each request
+    void set_verify_merged_call_deps(bool verify)
+    {
+        verify_merged_call_deps = verify;
+    }
+
+    bool is_verify_merged_call_deps() const
+    {
+        return verify_merged_call_deps;
+    }
+
+    void add_merged_call_deps_check(bool matches)
+    {
+        ++merged_call_deps_checks;
+        if (!matches) {
+            ++merged_call_deps_differences;
+        }
+    }
+
+    unsigned long get_merged_call_deps_checks() const
+    {
+        return merged_call_deps_checks;
+    }
+
+    unsigned long get_merged_call_deps_differences() const
+    {
+        return merged_call_deps_differences;
+    }
+
     void add_input_dep_function(llvm::Function* F)
     {
         m_input_dep_functions.insert(F);
@@ -77,10 +216,23 @@ public:
     }
 
 private:
-    bool goto_unsafe;
-    bool cache_input_dep;
+    bool goto_unsafe = false;
+    // Lattice is shallow, regions converge in a few iterations.
+    unsigned irreducible_region_iterations = 16;
+    bool cache_input_dep = false;
     std::string lib_config_file;
-    bool use_cache;
+    std::string stats_file;
+    std::string summary_file;
+    std::string link_file;
+    bool use_cache = false;
+    bool analyze_reachables_only = false;
+    bool exported_entry_points = false;
+    bool compact_results = true;
+    bool function_analisers_requested = false;
+    bool verify_merged_call_deps = false;
+    unsigned long merged_call_deps_checks = 0;
+    unsigned long merged_call_deps_differences = 0;
+    std::vector<std::string> m_entry_points;
     std::unordered_set<llvm::Function*> m_input_dep_functions;
     std::unordered_set<llvm::Function*> m_extracted_functions;
 };
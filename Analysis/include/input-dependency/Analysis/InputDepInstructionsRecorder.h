@@ -1,10 +1,13 @@
 #pragma once
 
+#include "input-dependency/Analysis/AnalysisContext.h"
+
 #include <unordered_set>
 
 namespace llvm {
 class Instruction;
 class BasicBlock;
+class Function;
 }
 
 namespace input_dependency {
@@ -14,11 +17,11 @@ class InputDepInstructionsRecorder
 public:
     static InputDepInstructionsRecorder& get()
     {
-        static InputDepInstructionsRecorder recorder;
-        return recorder;
+        return AnalysisContext::get().get_instructions_recorder();
     }
 
 private:
+    friend class AnalysisContext;
     InputDepInstructionsRecorder() = default;
 
 public:
@@ -40,12 +43,14 @@ public:
     
     void record(llvm::Instruction* I);
     void record(llvm::BasicBlock* B);
+    /// Removes recorded instructions of F, e.g. when its analysis is aborted
+    void erase(llvm::Function* F);
 
     void dump_dbg_info() const;
 
 private:
     std::unordered_set<llvm::Instruction*> m_input_dep_instructions;
-    bool m_record;
+    bool m_record = false;
 };
 
 }
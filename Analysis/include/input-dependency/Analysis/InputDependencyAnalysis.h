@@ -1,7 +1,11 @@
 #pragma once
 
+#include "input-dependency/Analysis/AnalysisCostRecorder.h"
 #include "input-dependency/Analysis/InputDependencyAnalysisInterface.h"
 #include "input-dependency/Analysis/DependencyAnaliser.h"
+#include "input-dependency/Analysis/ThinLink.h"
+
+#include <cassert>
 
 namespace llvm {
 class CallGraph;
@@ -26,6 +30,9 @@ public:
     using LoopInfoGetter = std::function<llvm::LoopInfo* (llvm::Function* F)>;
     using PostDominatorTreeGetter = std::function<const llvm::PostDominatorTree* (llvm::Function* F)>;
     using DominatorTreeGetter = std::function<const llvm::DominatorTree* (llvm::Function* F)>;
+    /// Returns false if body of F can not be materialized
+    using FunctionMaterializer = std::function<bool (llvm::Function* F)>;
+    using FunctionReleaser = std::function<void (llvm::Function* F)>;
 
 public:
     InputDependencyAnalysis(llvm::Module* M);
@@ -37,6 +44,14 @@ public:
     void setLoopInfoGetter(const LoopInfoGetter& loopInfoGetter);
     void setPostDominatorTreeGetter(const PostDominatorTreeGetter& postDomTreeGetter);
     void setDominatorTreeGetter(const DominatorTreeGetter& domTreeGetter);
+    /**
+     * \brief Streaming mode, for modules loaded lazily.
+     * Bodies of functions are materialized just before analysis of their SCC. Once a function and all its callers are
+     * analysed and summarized, its results are dropped and its body is released. Results are not finalized, module
+     * summary is the only output. Analysis stops without writing the summary if a function can not be materialized.
+     * \note Call graph should be built without function bodies; indirect calls are considered input dependent.
+     */
+    void setStreaming(const FunctionMaterializer& materializer, const FunctionReleaser& releaser);
 
 public:
     void run() override;
@@ -62,9 +77,26 @@ public:
 
     bool insertAnalysisInfo(llvm::Function* F, InputDepResType analysis_info) override;
 
+public:
+    /// Merges finalized argument or global dependencies of a call site into mergeTo
+    template <class DependencyMapType>
+    static void mergeDependencyMaps(DependencyMapType& mergeTo, const DependencyMapType& mergeFrom);
+
 private:
+    void collectReachableFunctions();
+    bool isReachableFunction(llvm::Function* F) const;
     void runOnFunction(llvm::Function* F);
+    void runOnUnreachableFunction(llvm::Function* F);
+    void runOnBudgetExceededFunction(llvm::Function* F, const std::string& reason);
+    void runOnInputIndependentFunction(llvm::Function* F);
+    void countAnalysisTiers() const;
     void doFinalization();
+    /// Replaces finalized function analisers with compact frozen results.
+    void compactResults();
+    void accountRetainedMemory() const;
+    void writeModuleSummary() const;
+    void runStreaming();
+    void releaseFunction(llvm::Function* F);
 
     void finalizeForArguments(llvm::Function* F, InputDepResType& FA);
     void finalizeForGlobals(llvm::Function* F, InputDepResType& FA);
@@ -73,9 +105,9 @@ private:
     DependencyAnaliser::ArgumentDependenciesMap getFunctionCallInfo(llvm::Function* F);
     DependencyAnaliser::GlobalVariableDependencyMap getFunctionCallGlobalsInfo(llvm::Function* F);
 
-    template <class DependencyMapType>
-    void mergeDependencyMaps(DependencyMapType& mergeTo, const DependencyMapType& mergeFrom);
+    void addInputDependentGlobalsInfo(llvm::Function* F, DependencyAnaliser::GlobalVariableDependencyMap& globalDeps);
     void addMissingGlobalsInfo(llvm::Function* F, DependencyAnaliser::GlobalVariableDependencyMap& globalDeps);
+    FunctionAnaliser* getGlobalsInitAnaliser();
 
 private:
     llvm::Module* m_module;
@@ -93,8 +125,35 @@ private:
     CalleeCallersMap m_calleeCallersInfo;
     std::vector<llvm::Function*> m_moduleFunctions;
     std::unordered_set<llvm::Function*> m_processedInputDepFunctions;
+    // functions reachable from entry points, used only if analysis is restricted to reachable functions
+    bool m_reachablesOnly;
+    FunctionSet m_reachableFunctions;
+    // analysis results of initializer of C++ globals, looked up once
+    bool m_globalsInitAnaliserFound;
+    FunctionAnaliser* m_globalsInitAnaliser;
+    bool m_streaming;
+    FunctionMaterializer m_materializer;
+    FunctionReleaser m_releaser;
+    // dependencies coming from other modules, if module was thin linked
+    ThinLinkResult m_linkResult;
 }; // class InputDependencyAnalysis
 
+template <class DependencyMapType>
+void InputDependencyAnalysis::mergeDependencyMaps(DependencyMapType& mergeTo, const DependencyMapType& mergeFrom)
+{
+    for (const auto& item : mergeFrom) {
+        // only input dependent arguments were collected
+        assert(item.second.isDefined());
+        //assert(item.second.isInputDep() || item.second.isInputIndep() || item.second.isInputArgumentDep());
+        auto res = mergeTo.insert(item);
+        if (!res.second) {
+            res.first->second.mergeDependencies(item.second);
+        }
+        assert(!res.first->second.isValueDep());
+    }
+    AnalysisCostRecorder::get().count_map_merge(mergeFrom.size());
+}
+
 
 } // namespace input_dependency
 
@@ -15,6 +15,9 @@ namespace input_dependency {
 
 //class InputDependencyAnalysisInterface;
 
+/// Applies command line options of the analysis to its configuration
+void configure_run();
+
 class InputDependencyAnalysisPass : public llvm::ModulePass
 {
 public:
@@ -31,6 +34,7 @@ public:
 public:
     void getAnalysisUsage(llvm::AnalysisUsage& AU) const override;
     bool runOnModule(llvm::Module& M) override;
+    bool doFinalization(llvm::Module& M) override;
 
 public:
     InputDependencyAnalysisType getInputDependencyAnalysis()
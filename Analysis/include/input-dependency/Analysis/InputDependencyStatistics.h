@@ -1,6 +1,7 @@
 #pragma once
 
 #include "input-dependency/Analysis/Statistics.h"
+#include "input-dependency/Analysis/AnalysisCostRecorder.h"
 #include "input-dependency/Analysis/InputDependencyAnalysis.h"
 
 #include "llvm/Pass.h"
@@ -70,6 +71,8 @@ public:
 
     void setLoopInfoGetter(const LoopInfoGetter& loop_info_getter);
     void setFunctions(const std::unordered_set<llvm::Function*>& functions);
+    /// Sets number of functions listed in top costs section. Analysis costs are not reported if 0.
+    void setTopFunctionsCount(unsigned count);
 
 public:
     void report() override;
@@ -93,6 +96,19 @@ public:
 
     virtual void reportDataInpdependentCoverage();
 
+    /// Reports analysis cost counters of each function recorded by AnalysisCostRecorder,
+    /// and top slowest and largest functions of the module.
+    virtual void reportAnalysisCost();
+
+    /// Reports memory of analysis phases and memory retained by results, recorded by MemoryAccounting.
+    virtual void reportMemoryUsage();
+
+    /// Reports functions which exceeded analysis budget and were considered input dependent.
+    virtual void reportBudgetFallbacks();
+
+    /// Reports number of functions decided by the prepass and number of fully analysed functions.
+    virtual void reportAnalysisTiers();
+
     /// Invalidates stat data cached so far. Note cached data will persist, unless this function is called.
     virtual void invalidate_stats_data();
 
@@ -102,6 +118,7 @@ private:
     void report_input_indep_coverage_data(const input_indep_coverage_data& data);
     void report_input_dep_coverage_data(const input_dep_coverage_data& data);
     void report_data_indep_coverage_data(const data_independent_coverage_data& data);
+    void report_analysis_cost_data(const std::string& name, const FunctionAnalysisCost& cost);
     void update_module_coverage_data(input_dep_coverage_data& module_coverage_data,
                                      const input_dep_coverage_data& function_coverage_data) const;
     void update_module_coverage_data(input_indep_coverage_data& module_coverage_data,
@@ -114,6 +131,7 @@ private:
     InputDependencyAnalysisInfo* m_IDA; 
     LoopInfoGetter m_loopInfoGetter;
     std::unordered_set<llvm::Function*> m_functions;
+    unsigned m_topFunctionsCount = 0;
 
     // caching stats
     std::unordered_map<llvm::Function*, input_indep_coverage_data> m_function_input_indep_function_coverage_data;
@@ -129,6 +147,10 @@ public:
     void reportInputInDepCoverage() override {}
     void reportInputDepCoverage() override {}
     void reportDataInpdependentCoverage() override {}
+    void reportAnalysisCost() override {}
+    void reportMemoryUsage() override {}
+    void reportBudgetFallbacks() override {}
+    void reportAnalysisTiers() override {}
     void invalidate_stats_data() override {}
 
     void flush() override {}
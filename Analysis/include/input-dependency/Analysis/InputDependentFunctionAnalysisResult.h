@@ -103,9 +103,28 @@ public:
         return false;
     }
 
+    void setCalledFunctions(const FunctionSet& calledFunctions)
+    {
+        m_calledFunctions = calledFunctions;
+    }
+
+    InstructionClassification getInstructionClassification() override
+    {
+        // instructions may be added after the result is created, e.g. by extraction
+        unsigned count = 0;
+        for (auto& B : *m_F) {
+            count += B.size();
+        }
+        InstructionClassification classification(count);
+        classification.setAll(InstructionClassification::INPUT_DEP);
+        classification.setAll(InstructionClassification::CONTROL_DEP);
+        classification.setAll(InstructionClassification::DATA_DEP);
+        return classification;
+    }
+
     FunctionSet getCallSitesData() const override
     {
-        return FunctionSet();    
+        return m_calledFunctions;
     }
 
     FunctionCallDepInfo getFunctionCallDepInfo(llvm::Function* F) const override
@@ -162,6 +181,7 @@ private:
     llvm::Function* m_F;
     bool m_is_extracted;
     long unsigned m_instructions_count;
+    FunctionSet m_calledFunctions;
 }; // class InputDependentFunctionAnalysisResult
 
 } // namespace input_dependency
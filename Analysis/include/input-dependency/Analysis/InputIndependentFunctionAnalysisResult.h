@@ -0,0 +1,212 @@
+#pragma once
+
+#include "input-dependency/Analysis/FunctionInputDependencyResultInterface.h"
+#include "input-dependency/Analysis/BasicBlocksUtils.h"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/CFG.h"
+
+#include <unordered_set>
+#include <vector>
+
+namespace input_dependency {
+
+/**
+ * \class InputIndependentFunctionAnalysisResult
+ * \brief Result for functions found trivially input independent by the prepass.
+ *
+ * All instructions reachable from the entry block are input independent. As with function analiser, blocks not
+ * reachable from the entry are considered input dependent.
+ */
+class InputIndependentFunctionAnalysisResult final : public FunctionInputDependencyResultInterface
+{
+public:
+    InputIndependentFunctionAnalysisResult(llvm::Function* F)
+        : m_F(F)
+        , m_is_inputDep(false)
+        , m_is_extracted(false)
+        , m_input_indep_count(0)
+        , m_instructions_count(0)
+    {
+        std::vector<llvm::BasicBlock*> blocks{&m_F->getEntryBlock()};
+        m_reachableBlocks.insert(&m_F->getEntryBlock());
+        while (!blocks.empty()) {
+            auto* block = blocks.back();
+            blocks.pop_back();
+            m_input_indep_count += block->getInstList().size();
+            for (auto succ = succ_begin(block); succ != succ_end(block); ++succ) {
+                if (m_reachableBlocks.insert(*succ).second) {
+                    blocks.push_back(*succ);
+                }
+            }
+        }
+        for (auto& B : *m_F) {
+            m_instructions_count += B.getInstList().size();
+            if (m_reachableBlocks.find(&B) != m_reachableBlocks.end()) {
+                continue;
+            }
+            for (auto succ = succ_begin(&B); succ != succ_end(&B); ++succ) {
+                if (m_reachableBlocks.find(*succ) != m_reachableBlocks.end()) {
+                    BasicBlocksUtils::get().addUnreachableBlock(&B);
+                    break;
+                }
+            }
+        }
+    }
+
+public:
+    void analyze() override {}
+
+    llvm::Function* getFunction() override
+    {
+        return m_F;
+    }
+
+    const llvm::Function* getFunction() const override
+    {
+        return m_F;
+    }
+
+    bool isInputDepFunction() const override
+    {
+        return m_is_inputDep;
+    }
+
+    void setIsInputDepFunction(bool isInputDep) override
+    {
+        m_is_inputDep = isInputDep;
+    }
+
+    bool isExtractedFunction() const override
+    {
+        return m_is_extracted;
+    }
+
+    void setIsExtractedFunction(bool isExtracted) override
+    {
+        m_is_extracted = isExtracted;
+    }
+
+    bool isInputDependent(llvm::Instruction* instr) const override
+    {
+        return isInputDependentBlock(instr->getParent());
+    }
+
+    bool isInputDependent(const llvm::Instruction* instr) const override
+    {
+        return isInputDependentBlock(const_cast<llvm::BasicBlock*>(instr->getParent()));
+    }
+
+    bool isInputIndependent(llvm::Instruction* instr) const override
+    {
+        return !isInputDependent(instr);
+    }
+
+    bool isInputIndependent(const llvm::Instruction* instr) const override
+    {
+        return !isInputDependent(instr);
+    }
+
+    bool isInputDependentBlock(llvm::BasicBlock* block) const override
+    {
+        return m_reachableBlocks.find(block) == m_reachableBlocks.end();
+    }
+
+    bool isControlDependent(llvm::Instruction* I) const override
+    {
+        return m_is_inputDep || isInputDependentBlock(I->getParent());
+    }
+
+    bool isDataDependent(llvm::Instruction* I) const override
+    {
+        return isInputDependent(I);
+    }
+
+    bool isArgumentDependent(llvm::Instruction* I) const override
+    {
+        return false;
+    }
+
+    bool isArgumentDependent(llvm::BasicBlock* block) const override
+    {
+        return false;
+    }
+
+    bool isGlobalDependent(llvm::Instruction* I) const override
+    {
+        return false;
+    }
+
+    void setCalledFunctions(const FunctionSet& calledFunctions)
+    {
+        m_calledFunctions = calledFunctions;
+    }
+
+    FunctionSet getCallSitesData() const override
+    {
+        return m_calledFunctions;
+    }
+
+    FunctionCallDepInfo getFunctionCallDepInfo(llvm::Function* F) const override
+    {
+        return FunctionCallDepInfo();
+    }
+
+    InputIndependentFunctionAnalysisResult* toInputIndependentFunctionAnalysisResult() override
+    {
+        return this;
+    }
+
+    long unsigned get_input_dep_blocks_count() const override
+    {
+        return m_F->getBasicBlockList().size() - m_reachableBlocks.size();
+    }
+
+    long unsigned get_input_indep_blocks_count() const override
+    {
+        return m_reachableBlocks.size();
+    }
+
+    long unsigned get_unreachable_blocks_count() const override
+    {
+        return BasicBlocksUtils::get().getFunctionUnreachableBlocksCount(m_F);
+    }
+
+    long unsigned get_unreachable_instructions_count() const override
+    {
+        return BasicBlocksUtils::get().getFunctionUnreachableInstructionsCount(m_F);
+    }
+
+    long unsigned get_input_dep_count() const override
+    {
+        return m_instructions_count - m_input_indep_count;
+    }
+
+    long unsigned get_input_indep_count() const override
+    {
+        return m_input_indep_count;
+    }
+
+    long unsigned get_data_indep_count() const override
+    {
+        return m_input_indep_count;
+    }
+
+    long unsigned get_input_unknowns_count() const override
+    {
+        return 0;
+    }
+
+private:
+    llvm::Function* m_F;
+    bool m_is_inputDep;
+    bool m_is_extracted;
+    long unsigned m_input_indep_count;
+    long unsigned m_instructions_count;
+    std::unordered_set<llvm::BasicBlock*> m_reachableBlocks;
+    FunctionSet m_calledFunctions;
+}; // class InputIndependentFunctionAnalysisResult
+
+} // namespace input_dependency
+
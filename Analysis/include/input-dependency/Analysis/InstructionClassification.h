@@ -0,0 +1,68 @@
+#pragma once
+
+#include "llvm/ADT/BitVector.h"
+
+#include <array>
+
+namespace input_dependency {
+
+class FunctionInputDependencyResultInterface;
+
+/**
+ * \class InstructionClassification
+ * \brief Classification of all instructions of a function, one bitset per classification plane.
+ *
+ * Bits are indexed by position of instruction in the function, counting instructions of blocks in function order.
+ * Consumers iterating a function's instructions test bits instead of querying results one instruction at a time.
+ */
+class InstructionClassification
+{
+public:
+    enum Plane {
+        INPUT_DEP,
+        INPUT_INDEP,
+        CONTROL_DEP,
+        DATA_DEP,
+        ARGUMENT_DEP,
+        GLOBAL_DEP,
+        PLANES_COUNT
+    };
+
+public:
+    /// Classification of \p instructionsCount instructions, none of them set in any plane
+    explicit InstructionClassification(unsigned instructionsCount);
+    /// Classification collected with per instruction queries of \p result
+    explicit InstructionClassification(FunctionInputDependencyResultInterface& result);
+
+public:
+    unsigned size() const
+    {
+        return m_planes[INPUT_DEP].size();
+    }
+
+    bool test(Plane plane, unsigned index) const
+    {
+        return m_planes[plane].test(index);
+    }
+
+    void set(Plane plane, unsigned index)
+    {
+        m_planes[plane].set(index);
+    }
+
+    void setAll(Plane plane)
+    {
+        m_planes[plane].set();
+    }
+
+    const llvm::BitVector& getPlane(Plane plane) const
+    {
+        return m_planes[plane];
+    }
+
+private:
+    std::array<llvm::BitVector, PLANES_COUNT> m_planes;
+}; // class InstructionClassification
+
+} // namespace input_dependency
+
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+#include <string>
 #include <unordered_map>
 
 namespace llvm {
@@ -17,12 +19,16 @@ class LibraryInfoManager
 {
 public:
     using LibFunctionInfoMap = std::unordered_map<std::string, LibFunctionInfo>;
+    using SharedLibFunctionInfoMap = std::shared_ptr<const LibFunctionInfoMap>;
 
 public:
     static LibraryInfoManager& get();
 
 private:
+    friend class AnalysisContext;
     LibraryInfoManager();
+    /// Uses library function models loaded by another manager
+    explicit LibraryInfoManager(const SharedLibFunctionInfoMap& libraryModels);
 
     LibraryInfoManager(const LibraryInfoManager& ) = delete;
     LibraryInfoManager(LibraryInfoManager&& ) = delete;
@@ -37,14 +43,19 @@ public:
 public:
     void resolveLibFunctionInfo(llvm::Function* F, const std::string& demangledName);
 
+    /// Unresolved library function models. These are read only and can be shared with managers of other contexts.
+    const SharedLibFunctionInfoMap& getLibraryModels() const
+    {
+        return m_libraryModels;
+    }
+
 private:
     void setup();
 
-    void addLibFunctionInfo(const LibFunctionInfo& funcInfo);
-    void addLibFunctionInfo(LibFunctionInfo&& funcInfo);
-
 private:
-    LibFunctionInfoMap m_libraryInfo;
+    SharedLibFunctionInfoMap m_libraryModels;
+    // models resolved with functions of analysed module
+    LibFunctionInfoMap m_resolvedInfo;
 }; // class LibraryInfoManager
 
 } // namespace input_dependency
@@ -16,6 +16,7 @@ class PostDominatorTree;
 
 namespace input_dependency {
 
+class CFGTraversalOrder;
 class VirtualCallSiteAnalysisResult;
 class IndirectCallSitesAnalysisResult;
 
@@ -30,7 +31,8 @@ public:
                        const Arguments& inputs,
                        const FunctionAnalysisGetter& Fgetter,
                        llvm::Loop& L,
-                       llvm::LoopInfo& LI);
+                       llvm::LoopInfo& LI,
+                       const CFGTraversalOrder& traversalOrder);
 
     LoopAnalysisResult(const LoopAnalysisResult&) = delete;
     LoopAnalysisResult(LoopAnalysisResult&& ) = delete;
@@ -55,6 +57,7 @@ public:
     void finalizeResults(const DependencyAnaliser::ArgumentDependenciesMap& dependentArgs) override;
     void finalizeGlobals(const DependencyAnaliser::GlobalVariableDependencyMap& globalsDeps) override;
     void dumpResults() const override;
+    void accountMemory(MemoryUsage& usage) const override;
 
     /// \}
 
@@ -152,6 +155,7 @@ private:
     const FunctionAnalysisGetter& m_FAG;
     llvm::Loop& m_L;
     llvm::LoopInfo& m_LI;
+    const CFGTraversalOrder& m_traversalOrder;
     std::unordered_set<llvm::BasicBlock*> m_latches;
 
     DependencyAnaliser::ArgumentDependenciesMap m_outArgDependencies;
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "input-dependency/Analysis/AnalysisContext.h"
+#include "input-dependency/Analysis/DependencyAnaliser.h"
+
+#include <string>
+#include <vector>
+
+namespace input_dependency {
+
+/**
+ * \class MemoryUsage
+ * \brief Estimated memory held by analysis results, by kind of data structure.
+ *
+ * Estimates are computed from sizes and bucket counts of containers, and do not include allocator overhead.
+ */
+class MemoryUsage
+{
+public:
+    /// value, argument and global dependency maps of block, loop and function results
+    unsigned long value_maps = 0;
+    /// dependencies of function calls, FunctionCallDepInfo
+    unsigned long call_dep_info = 0;
+    /// element dependencies of composite values
+    unsigned long composite_values = 0;
+    /// sets of input dependent, input independent and data dependent instructions
+    unsigned long result_sets = 0;
+
+public:
+    unsigned long total() const
+    {
+        return value_maps + call_dep_info + composite_values + result_sets;
+    }
+
+    void addValueDependencies(const DependencyAnaliser::ValueDependencies& deps);
+    void addArgumentDependencies(const DependencyAnaliser::ArgumentDependenciesMap& deps);
+    void addGlobalDependencies(const DependencyAnaliser::GlobalVariableDependencyMap& deps);
+    void addValueDep(const ValueDepInfo& dep);
+    void addFunctionCallsInfo(const DependencyAnaliser::FunctionCallsArgumentDependencies& callsInfo);
+    void addFunctionCallInfo(const FunctionCallDepInfo& callInfo);
+    void addInstructionDependencies(const DependencyAnaliser::InstrDependencyMap& deps);
+
+    template <class Set>
+    void addResultSet(const Set& set)
+    {
+        result_sets += container_bytes(set);
+    }
+
+    /// Approximate size of node based hash container, without memory held by its elements.
+    template <class Container>
+    static unsigned long container_bytes(const Container& container)
+    {
+        return container.size() * (sizeof(typename Container::value_type) + 2 * sizeof(void*))
+            + container.bucket_count() * sizeof(void*);
+    }
+
+    template <class T>
+    static unsigned long container_bytes(const std::vector<T>& container)
+    {
+        return container.capacity() * sizeof(T);
+    }
+
+    static unsigned long container_bytes(const GlobalsSet& globals)
+    {
+        return globals.getBits().getMemorySize();
+    }
+
+    /// Memory held by argument and value sets of dep info.
+    static unsigned long dep_bytes(const DepInfo& dep);
+
+private:
+    template <class DependencyMap>
+    void add_dependency_map(const DependencyMap& deps, unsigned long& bytes);
+    void add_value_dep(const ValueDepInfo& dep, unsigned long& bytes);
+};
+
+/**
+ * \class MemoryAccounting
+ * \brief Collects process memory of analysis phases and memory retained by analysis results.
+ *
+ * For each phase records resident set size before and after the phase, and growth of the process peak resident set
+ * size during it. Peak is not reset, thus growth is zero for phases staying below an earlier peak. Memory is of the
+ * whole process: when several workers analyze concurrently, phases include memory of other workers.
+ */
+class MemoryAccounting
+{
+public:
+    struct PhaseMemory
+    {
+        std::string name;
+        unsigned long rss_before_kb;
+        unsigned long peak_growth_kb;
+        unsigned long rss_after_kb;
+    };
+
+    using Phases = std::vector<PhaseMemory>;
+
+    static MemoryAccounting& get()
+    {
+        return AnalysisContext::get().get_memory_accounting();
+    }
+
+    /// Records memory of a phase during its lifetime, if accounting is enabled
+    class Phase
+    {
+    public:
+        explicit Phase(const char* name);
+        ~Phase();
+
+        Phase(const Phase&) = delete;
+        Phase& operator =(const Phase&) = delete;
+
+    private:
+        const char* m_name;
+        bool m_enabled;
+        unsigned long m_rssBefore;
+        unsigned long m_peakBefore;
+    };
+
+private:
+    friend class AnalysisContext;
+    MemoryAccounting() = default;
+
+public:
+    void set_enabled(bool enabled)
+    {
+        m_enabled = enabled;
+    }
+
+    bool is_enabled() const
+    {
+        return m_enabled;
+    }
+
+    void reset();
+
+    const Phases& get_phases() const
+    {
+        return m_phases;
+    }
+
+    void set_retained_memory(const MemoryUsage& usage)
+    {
+        m_retained = usage;
+    }
+
+    const MemoryUsage& get_retained_memory() const
+    {
+        return m_retained;
+    }
+
+private:
+    bool m_enabled = false;
+    Phases m_phases;
+    MemoryUsage m_retained;
+};
+
+} // namespace input_dependency
+
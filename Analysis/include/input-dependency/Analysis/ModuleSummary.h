@@ -0,0 +1,98 @@
+#pragma once
+
+#include "input-dependency/Analysis/InputDependencyAnalysisInterface.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace llvm {
+class Function;
+class Module;
+}
+
+namespace input_dependency {
+
+/**
+ * \class ModuleSummary
+ * \brief Serializable summary of a module's analysis results, linked with summaries of other modules by ThinLink.
+ *
+ * Summary is taken before finalization, thus dependencies are expressed with arguments of the function and globals:
+ * dependencies of return value and out arguments, referenced and modified globals, and dependencies of arguments
+ * passed at call sites, including call sites of functions defined in other modules.
+ */
+class ModuleSummary
+{
+public:
+    /// Dependency on input, on arguments of the function and on globals
+    struct Dependency
+    {
+        bool inputDep = false;
+        std::set<int> arguments;
+        std::set<std::string> globals;
+
+        void merge(const Dependency& dep);
+    };
+
+    using ArgumentDependencies = std::map<int, Dependency>;
+
+    struct CallSite
+    {
+        std::string callee;
+        ArgumentDependencies arguments;
+    };
+
+    struct Function
+    {
+        std::string name;
+        /// Name of the function in library info of other modules
+        std::string libraryName;
+        bool external = false;
+        unsigned argumentsCount = 0;
+        Dependency returnDependency;
+        ArgumentDependencies outArguments;
+        std::set<std::string> referencedGlobals;
+        std::map<std::string, Dependency> modifiedGlobals;
+        /// Called functions, with merged dependencies of all call sites
+        std::vector<CallSite> calls;
+    };
+
+public:
+    ModuleSummary() = default;
+
+    /// Empty summary of M, functions are added one by one
+    explicit ModuleSummary(llvm::Module& M);
+    /// Summarizes results of analysis of M. Results should not be finalized yet.
+    ModuleSummary(llvm::Module& M, const InputDependencyAnalysisInterface::InputDependencyAnalysisInfo& results);
+
+public:
+    void addFunction(llvm::Function* F, FunctionInputDependencyResultInterface& result);
+
+public:
+    const std::string& getModuleName() const
+    {
+        return m_moduleName;
+    }
+
+    const std::vector<Function>& getFunctions() const
+    {
+        return m_functions;
+    }
+
+    bool isLocalGlobal(const std::string& name) const
+    {
+        return m_localGlobals.find(name) != m_localGlobals.end();
+    }
+
+    bool read(const std::string& file);
+    bool write(const std::string& file) const;
+
+private:
+    std::string m_moduleName;
+    std::vector<Function> m_functions;
+    std::set<std::string> m_localGlobals;
+}; // class ModuleSummary
+
+} // namespace input_dependency
+
@@ -33,6 +33,7 @@ public:
     bool isDataDependent(llvm::Instruction* I) const override;
     bool isDataDependent(llvm::Instruction* I, const ArgumentDependenciesMap& depArgs) const override;
     bool isArgumentDependent(llvm::BasicBlock* block) const override;
+    void accountMemory(MemoryUsage& usage) const override;
 
     /// \name Implementation of DependencyAnaliser interface
     /// \{
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "input-dependency/Analysis/AnalysisContext.h"
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Timer.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace llvm {
+class Function;
+}
+
+namespace input_dependency {
+
+/**
+ * \class PhaseTimers
+ * \brief Collects time spent in analysis and transformation phases.
+ *
+ * Time of each phase is accumulated in an llvm TimerGroup, printed with -time-passes or -input-dep-time-phases.
+ * If trace file is set, each run of a phase is recorded as a Chrome trace event, with the function it ran on,
+ * so that the trace can be inspected per function in chrome://tracing or Perfetto.
+ */
+class PhaseTimers
+{
+public:
+    static PhaseTimers& get()
+    {
+        return AnalysisContext::get().get_phase_timers();
+    }
+
+public:
+    PhaseTimers();
+
+    PhaseTimers(const PhaseTimers&) = delete;
+    PhaseTimers& operator =(const PhaseTimers&) = delete;
+
+public:
+    void set_print_timers(bool print);
+    void set_trace_file(const std::string& trace_file);
+    bool is_enabled() const;
+    /// Prints phase timers and writes trace file, if enabled. Clears collected data.
+    void report();
+
+private:
+    friend class PhaseTimer;
+    using Clock = std::chrono::steady_clock;
+
+    llvm::Timer& get_timer(const char* phase);
+    void add_trace_event(const char* phase,
+                         llvm::StringRef detail,
+                         const Clock::time_point& start,
+                         const Clock::time_point& end);
+    void write_trace();
+
+private:
+    struct TraceEvent
+    {
+        const char* phase;
+        std::string detail;
+        double start_us;
+        double duration_us;
+    };
+
+    bool m_printTimers;
+    std::string m_traceFile;
+    Clock::time_point m_startTime;
+    llvm::TimerGroup m_timerGroup;
+    std::unordered_map<std::string, std::unique_ptr<llvm::Timer>> m_timers;
+    std::vector<TraceEvent> m_traceEvents;
+};
+
+/**
+ * \class PhaseTimer
+ * \brief Times given phase during its lifetime. Does nothing if phase timers are disabled.
+ * Phase name should be a string literal. Nested runs of the same phase are timed by the outermost run,
+ * and traced each.
+ */
+class PhaseTimer
+{
+public:
+    explicit PhaseTimer(const char* phase, llvm::StringRef detail = llvm::StringRef());
+    PhaseTimer(const char* phase, const llvm::Function* F);
+    ~PhaseTimer();
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator =(const PhaseTimer&) = delete;
+
+private:
+    const char* m_phase;
+    // copied, as function may be renamed while timed
+    std::string m_detail;
+    bool m_enabled;
+    llvm::Timer* m_timer;
+    PhaseTimers::Clock::time_point m_start;
+};
+
+} // namespace input_dependency
+
@@ -1,9 +1,12 @@
 #pragma once
 
+#include "llvm/ADT/BitVector.h"
 #include "llvm/Pass.h"
 
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace llvm {
 class CallGraph;
@@ -17,10 +20,21 @@ namespace input_dependency {
 
 class InputDependencyAnalysisInterface;
 
+/**
+ * \class ReachableFunctions
+ * \brief Computes functions reachable from given set of root functions.
+ *
+ * Defined functions of the module are densely indexed and reachability is computed with iterative BFS over
+ * compressed (CSR) graph, using bitsets for visited functions.
+ * The graph combines call graph edges, call sites collected by input dependency analysis (indirect calls)
+ * and function address uses (function used in reachable function is considered reachable).
+ * The graph is built once on the first query, and is reused for consequent queries.
+ */
 class ReachableFunctions
 {
 public:
     using FunctionSet = std::unordered_set<llvm::Function*>;
+    using FunctionList = std::vector<llvm::Function*>;
 
 public:
     ReachableFunctions(llvm::Module* M,
@@ -35,18 +49,54 @@ public:
     void setInputDependencyAnalysisResult(InputDependencyAnalysisInterface* inputDepAnalysis);
 
     FunctionSet getReachableFunctions(llvm::Function* F);
-    
+    /// Returns functions reachable from any of given roots, computed in one traversal.
+    FunctionSet getReachableFunctions(const FunctionList& roots);
+    /// Returns bitset of reachable functions, indexed by \link getFunctionIndex.
+    llvm::BitVector getReachableFunctionsMask(const FunctionList& roots);
+
+    unsigned getFunctionsCount() const
+    {
+        return m_functions.size();
+    }
+
+    /// Returns -1 for functions without index (declarations, functions of other modules)
+    int getFunctionIndex(llvm::Function* F) const;
+    llvm::Function* getFunction(unsigned idx) const
+    {
+        return m_functions[idx];
+    }
+
+    /// Invalidates constructed graph, it will be rebuilt on next query.
+    void invalidate();
+
+    /**
+     * \brief Collects entry functions of the module.
+     * \param names names of entry functions. If empty main is used, otherwise main is entry only if listed.
+     * \param exported if true all externally visible functions are considered entry points too.
+     * Global constructors and destructors are always entry points.
+     */
+    static FunctionList collectEntryPoints(llvm::Module* M,
+                                           const std::vector<std::string>& names,
+                                           bool exported);
+
 private:
-    void collect_reachable_functions(llvm::CallGraphNode* callNode,
-                                     FunctionSet& reachable_functions);
-    void collect_indirectly_reachable_functions(FunctionSet& reachable_functions);
-    void collect_functions_with_uses(FunctionSet& reachable_functions);
-    FunctionSet getUserFunctions(llvm::User* user);
+    void build_graph();
+    void collect_call_edges(llvm::Function* F,
+                            std::vector<unsigned>& successors) const;
+    void collect_use_edges(std::vector<std::vector<unsigned>>& use_successors) const;
+    FunctionSet getUserFunctions(llvm::User* user) const;
 
 private:
     llvm::Module* m_module;
     llvm::CallGraph* m_callGraph;
     InputDependencyAnalysisInterface* m_inputDepAnalysis;
+
+    bool m_graphBuilt;
+    FunctionList m_functions;
+    std::unordered_map<llvm::Function*, unsigned> m_functionIndices;
+    // CSR representation: successors of function i are m_edges[m_edgeOffsets[i], m_edgeOffsets[i + 1])
+    std::vector<unsigned> m_edgeOffsets;
+    std::vector<unsigned> m_edges;
 };
 
 class ReachableFunctionsPass : public llvm::ModulePass
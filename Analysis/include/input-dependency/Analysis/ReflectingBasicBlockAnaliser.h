@@ -33,6 +33,7 @@ public:
 
 public:
     //void dumpResults() const override; // delete later, will use parent's
+    void accountMemory(MemoryUsage& usage) const override;
     void reflect(const DependencyAnaliser::ValueDependencies& dependencies,
                  const DepInfo& mandatory_deps) override;
     bool isReflected() const override
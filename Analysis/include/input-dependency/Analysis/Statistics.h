@@ -40,6 +40,7 @@ public:
         virtual void open(const std::string& file_name);
         virtual void write_entry(const key& k, double value) = 0;
         virtual void write_entry(const key& k, unsigned value) = 0;
+        virtual void write_entry(const key& k, unsigned long value) = 0;
         virtual void write_entry(const key& k, const std::string& value) = 0;
         virtual void write_entry(const key& k, const std::vector<std::string>& value) = 0;
         virtual void flush() = 0;
@@ -97,6 +98,7 @@ public:
 protected:
     void write_entry(const std::string& class_key, const std::string& key, double value);
     void write_entry(const std::string& class_key, const std::string& key, unsigned value);
+    void write_entry(const std::string& class_key, const std::string& key, unsigned long value);
     void write_entry(const std::string& class_key, const std::string& key, const std::string& value);
     void write_entry(const std::string& class_key, const std::string& key, const std::vector<std::string>& value);
 
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "input-dependency/Analysis/ModuleSummary.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace input_dependency {
+
+/**
+ * \class ThinLink
+ * \brief Links summaries of modules, without loading their IR.
+ *
+ * Dependencies of function arguments and globals are propagated over call sites of all modules until fixed point.
+ * Results written for each module are inputs for its finalization: argument dependencies coming from call sites in
+ * other modules, dependencies of globals, and return and out argument dependencies of functions defined in other
+ * modules, in the format of library function configuration.
+ */
+class ThinLink
+{
+public:
+    void addModule(ModuleSummary&& summary);
+    void link();
+    bool writeModuleResult(unsigned module, const std::string& file) const;
+
+    const std::vector<ModuleSummary>& getModules() const
+    {
+        return m_modules;
+    }
+
+    unsigned getIterationsCount() const
+    {
+        return m_iterations;
+    }
+
+    unsigned long getCrossModuleCallsCount() const
+    {
+        return m_crossModuleCalls;
+    }
+
+private:
+    struct FunctionNode
+    {
+        const ModuleSummary::Function* summary = nullptr;
+        std::vector<unsigned> modules;
+        std::vector<bool> argumentDeps;
+        std::vector<bool> crossModuleArgumentDeps;
+        bool hasCallers = false;
+        bool hasCrossModuleCallers = false;
+    };
+
+private:
+    std::string getFunctionKey(unsigned module, const ModuleSummary::Function& function) const;
+    /// Node of function called with given name from module, null for functions not defined in any module.
+    const FunctionNode* getCallee(unsigned module, const std::string& name) const;
+    FunctionNode* getCallee(unsigned module, const std::string& name);
+    std::string getGlobalKey(unsigned module, const std::string& name) const;
+    bool isDefinedInModule(const FunctionNode& node, unsigned module) const;
+    bool isInputDep(const ModuleSummary::Dependency& dep, const FunctionNode& function, unsigned module) const;
+    bool isInputDepGlobal(const std::string& key) const;
+    bool propagate();
+
+private:
+    std::vector<ModuleSummary> m_modules;
+    std::unordered_map<std::string, FunctionNode> m_functions;
+    std::unordered_map<std::string, bool> m_globalDeps;
+    unsigned m_iterations = 0;
+    unsigned long m_crossModuleCalls = 0;
+}; // class ThinLink
+
+/**
+ * \class ThinLinkResult
+ * \brief Thin link results of a module, read by the analysis to finalize arguments and globals.
+ */
+class ThinLinkResult
+{
+public:
+    using ArgumentDependencies = std::unordered_map<unsigned, bool>;
+
+public:
+    bool read(const std::string& file);
+
+    /// Dependencies of arguments coming from call sites in other modules, null if function is not called there.
+    const ArgumentDependencies* getArgumentDependencies(const std::string& function) const;
+    bool isInputDepGlobal(const std::string& global) const;
+
+private:
+    std::unordered_map<std::string, ArgumentDependencies> m_argumentDeps;
+    std::unordered_map<std::string, bool> m_globalDeps;
+}; // class ThinLinkResult
+
+} // namespace input_dependency
+
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "input-dependency/Analysis/GlobalsSet.h"
+
 #include <functional>
 #include <vector>
 #include <unordered_set>
@@ -33,7 +35,6 @@ class FunctionAnaliser;
 
 using Arguments = std::vector<llvm::Argument*>;
 using ValueSet = std::unordered_set<llvm::Value*>;
-using GlobalsSet = std::unordered_set<llvm::GlobalVariable*>;
 using ArgumentSet = std::unordered_set<llvm::Argument*>;
 using FunctionAnalysisGetter = std::function<FunctionAnaliser* (llvm::Function*)>;
 using FunctionSet = std::unordered_set<llvm::Function*>;
@@ -0,0 +1,150 @@
+#include "input-dependency/Analysis/AnalysisBudget.h"
+
+#include "input-dependency/Analysis/FunctionAnaliser.h"
+
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/Instructions.h"
+
+namespace input_dependency {
+
+namespace {
+
+void collect_globals(llvm::Value* value, GlobalsSet& globals)
+{
+    if (auto* global = llvm::dyn_cast<llvm::GlobalVariable>(value)) {
+        globals.insert(global);
+        return;
+    }
+    // globals used in constant expressions, e.g. GEPs and casts
+    if (auto* constant = llvm::dyn_cast<llvm::ConstantExpr>(value)) {
+        for (auto& op : constant->operands()) {
+            collect_globals(op.get(), globals);
+        }
+    }
+}
+
+llvm::Function* get_called_function(llvm::Instruction& I)
+{
+    if (auto* callInst = llvm::dyn_cast<llvm::CallInst>(&I)) {
+        return callInst->getCalledFunction();
+    }
+    if (auto* invokeInst = llvm::dyn_cast<llvm::InvokeInst>(&I)) {
+        return invokeInst->getCalledFunction();
+    }
+    return nullptr;
+}
+
+}
+
+AnalysisBudget::Scope::Scope(llvm::Function* F)
+{
+    auto& budget = AnalysisBudget::get();
+    if (!budget.has_budget()) {
+        return;
+    }
+    budget.m_enforced = true;
+    budget.m_aliasQueries = 0;
+    budget.m_loopReflectedValues = 0;
+    budget.m_start = std::chrono::steady_clock::now();
+    budget.m_deferredEffects.clear();
+}
+
+AnalysisBudget::Scope::~Scope()
+{
+    AnalysisBudget::get().m_enforced = false;
+}
+
+void AnalysisBudget::reset()
+{
+    m_budget = FunctionAnalysisBudget();
+    m_enforced = false;
+    m_deferredEffects.clear();
+    m_fallbacks.clear();
+}
+
+bool AnalysisBudget::exceeds_instructions_budget(llvm::Function* F) const
+{
+    if (m_budget.instructions == 0) {
+        return false;
+    }
+    unsigned long instructions_count = 0;
+    for (auto& B : *F) {
+        instructions_count += B.getInstList().size();
+    }
+    return instructions_count > m_budget.instructions;
+}
+
+void AnalysisBudget::check_wall_time() const
+{
+    if (!m_enforced || m_budget.wall_ms == 0) {
+        return;
+    }
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start);
+    if (elapsed.count() > m_budget.wall_ms) {
+        throw BudgetExceededException("wall time");
+    }
+}
+
+void AnalysisBudget::commit_side_effects()
+{
+    assert(!m_enforced);
+    std::vector<std::function<void ()>> effects;
+    effects.swap(m_deferredEffects);
+    for (const auto& effect : effects) {
+        effect();
+    }
+}
+
+const AnalysisBudget::FallbackSummary&
+AnalysisBudget::add_fallback_function(llvm::Function* F,
+                                      const std::string& reason,
+                                      const FunctionAnalysisGetter& FAG)
+{
+    FallbackSummary summary;
+    summary.reason = reason;
+    for (auto& B : *F) {
+        for (auto& I : B) {
+            for (auto& op : I.operands()) {
+                collect_globals(op.get(), summary.referencedGlobals);
+            }
+            if (auto* calledF = get_called_function(I)) {
+                summary.calledFunctions.insert(calledF);
+            }
+        }
+    }
+    // without analysis any referenced global may be modified, e.g. through pointers
+    for (auto* global : summary.referencedGlobals) {
+        if (!global->isConstant()) {
+            summary.modifiedGlobals.insert(global);
+        }
+    }
+    // callees are analyzed before callers, except for recursive calls
+    for (auto* calledF : summary.calledFunctions) {
+        if (auto* calleeAnaliser = FAG(calledF)) {
+            const auto& refGlobals = calleeAnaliser->getReferencedGlobals();
+            summary.referencedGlobals.insert(refGlobals);
+            const auto& modGlobals = calleeAnaliser->getModifiedGlobals();
+            summary.modifiedGlobals.insert(modGlobals);
+        } else if (auto* calleeSummary = get_fallback_summary(calledF)) {
+            summary.referencedGlobals.insert(calleeSummary->referencedGlobals);
+            summary.modifiedGlobals.insert(calleeSummary->modifiedGlobals);
+        }
+    }
+    auto& fallback = m_fallbacks[F];
+    fallback = std::move(summary);
+    return fallback;
+}
+
+const AnalysisBudget::FallbackSummary* AnalysisBudget::get_fallback_summary(llvm::Function* F) const
+{
+    auto pos = m_fallbacks.find(F);
+    if (pos == m_fallbacks.end()) {
+        return nullptr;
+    }
+    return &pos->second;
+}
+
+} // namespace input_dependency
+
@@ -0,0 +1,74 @@
+#include "input-dependency/Analysis/AnalysisContext.h"
+
+#include "input-dependency/Analysis/AnalysisBudget.h"
+#include "input-dependency/Analysis/AnalysisCostRecorder.h"
+#include "input-dependency/Analysis/AnalysisTiers.h"
+#include "input-dependency/Analysis/BasicBlocksUtils.h"
+#include "input-dependency/Analysis/GlobalsSet.h"
+#include "input-dependency/Analysis/InputDepConfig.h"
+#include "input-dependency/Analysis/InputDepInstructionsRecorder.h"
+#include "input-dependency/Analysis/LibFunctionInfo.h"
+#include "input-dependency/Analysis/LibraryInfoManager.h"
+#include "input-dependency/Analysis/MemoryAccounting.h"
+#include "input-dependency/Analysis/PhaseTimer.h"
+
+namespace input_dependency {
+
+namespace {
+
+thread_local AnalysisContext* active_context = nullptr;
+
+}
+
+AnalysisContext::AnalysisContext()
+    : m_config(new InputDepConfig())
+    , m_blocksUtils(new BasicBlocksUtils())
+    , m_instructionsRecorder(new InputDepInstructionsRecorder())
+    , m_budget(new AnalysisBudget())
+    , m_costRecorder(new AnalysisCostRecorder())
+    , m_tiers(new AnalysisTiers())
+    , m_memoryAccounting(new MemoryAccounting())
+    , m_phaseTimers(new PhaseTimers())
+    , m_globalsIndex(new GlobalsIndex())
+{
+}
+
+AnalysisContext::~AnalysisContext()
+{
+}
+
+AnalysisContext& AnalysisContext::get()
+{
+    if (active_context) {
+        return *active_context;
+    }
+    static AnalysisContext default_context;
+    return default_context;
+}
+
+AnalysisContext::Scope::Scope(AnalysisContext& context)
+    : m_previous(active_context)
+{
+    active_context = &context;
+}
+
+AnalysisContext::Scope::~Scope()
+{
+    active_context = m_previous;
+}
+
+LibraryInfoManager& AnalysisContext::get_library_info()
+{
+    if (!m_libraryInfo) {
+        m_libraryInfo.reset(new LibraryInfoManager());
+    }
+    return *m_libraryInfo;
+}
+
+void AnalysisContext::share_library_info(AnalysisContext& context)
+{
+    m_libraryInfo.reset(new LibraryInfoManager(context.get_library_info().getLibraryModels()));
+}
+
+} // namespace input_dependency
+
@@ -0,0 +1,57 @@
+#include "input-dependency/Analysis/AnalysisCostRecorder.h"
+
+#include "llvm/Support/Process.h"
+
+namespace input_dependency {
+
+AnalysisCostRecorder::AnalysisCostRecorder()
+    : m_record(false)
+    , m_current(&m_scratch)
+{
+}
+
+void AnalysisCostRecorder::reset()
+{
+    m_record = false;
+    m_costs.clear();
+    m_scratch = FunctionAnalysisCost();
+    m_current = &m_scratch;
+}
+
+AnalysisCostRecorder::Scope::Scope(llvm::Function* F)
+    : m_cost(nullptr)
+    , m_previous(nullptr)
+    , m_mallocUsage(0)
+{
+    auto& recorder = AnalysisCostRecorder::get();
+    if (!recorder.m_record) {
+        return;
+    }
+    // map nodes are stable, so the pointer stays valid while other functions are added
+    m_cost = &recorder.m_costs[F];
+    if (m_cost == recorder.m_current) {
+        // nested in a scope of the same function, which accounts for it
+        m_cost = nullptr;
+        return;
+    }
+    m_previous = recorder.m_current;
+    recorder.m_current = m_cost;
+    m_start = std::chrono::steady_clock::now();
+    m_mallocUsage = llvm::sys::Process::GetMallocUsage();
+}
+
+AnalysisCostRecorder::Scope::~Scope()
+{
+    if (!m_cost) {
+        return;
+    }
+    const std::size_t mallocUsage = llvm::sys::Process::GetMallocUsage();
+    if (mallocUsage > m_mallocUsage) {
+        m_cost->allocated_bytes += mallocUsage - m_mallocUsage;
+    }
+    m_cost->wall_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+    AnalysisCostRecorder::get().m_current = m_previous;
+}
+
+} // namespace input_dependency
+
@@ -0,0 +1,235 @@
+#include "input-dependency/Analysis/AnalysisTiers.h"
+
+#include "input-dependency/Analysis/InputDepConfig.h"
+#include "input-dependency/Analysis/LibFunctionInfo.h"
+#include "input-dependency/Analysis/LibraryInfoManager.h"
+#include "input-dependency/Analysis/LLVMIntrinsicsInfo.h"
+#include "input-dependency/Analysis/Utils.h"
+
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/SCCIterator.h"
+#include "llvm/Analysis/CallGraph.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Operator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace input_dependency {
+
+namespace {
+
+/// Returns true if value references a global variable or a function, directly or through constant expressions
+bool references_globals(llvm::Value* value)
+{
+    if (llvm::isa<llvm::GlobalValue>(value)) {
+        return true;
+    }
+    if (auto* constant = llvm::dyn_cast<llvm::ConstantExpr>(value)) {
+        for (auto& op : constant->operands()) {
+            if (references_globals(op.get())) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool is_local_memory(llvm::Value* pointer, llvm::Function* F)
+{
+    pointer = pointer->stripPointerCasts();
+    while (auto* gep = llvm::dyn_cast<llvm::GEPOperator>(pointer)) {
+        pointer = gep->getPointerOperand()->stripPointerCasts();
+    }
+    auto* alloca = llvm::dyn_cast<llvm::AllocaInst>(pointer);
+    return alloca && alloca->getParent()->getParent() == F;
+}
+
+}
+
+void AnalysisTiers::run(llvm::Module& M, llvm::CallGraph& callGraph)
+{
+    m_inputIndepFunctions.clear();
+    m_calledFunctions.clear();
+    std::fill(std::begin(m_tierCounts), std::end(m_tierCounts), 0);
+
+    std::vector<llvm::Function*> functions;
+    std::unordered_map<llvm::Function*, unsigned> indices;
+    for (auto& F : M) {
+        if (F.isDeclaration()) {
+            continue;
+        }
+        indices[&F] = functions.size();
+        functions.push_back(&F);
+    }
+
+    llvm::BitVector maybe_input_dep(functions.size());
+    CalleeCallersMap callers;
+    for (unsigned i = 0; i < functions.size(); ++i) {
+        auto* F = functions[i];
+        auto& calledFunctions = m_calledFunctions[F];
+        if (F->hasAddressTaken() || has_input_dependencies(F, M, calledFunctions)) {
+            maybe_input_dep.set(i);
+        }
+        for (auto* calledF : calledFunctions) {
+            callers[calledF].insert(F);
+        }
+    }
+    // calls within SCC are analysed before results of callees are available
+    for (auto CGI = llvm::scc_begin(&callGraph); !CGI.isAtEnd(); ++CGI) {
+        const auto& nodes = *CGI;
+        if (nodes.size() < 2) {
+            continue;
+        }
+        for (auto* node : nodes) {
+            auto pos = indices.find(node->getFunction());
+            if (pos != indices.end()) {
+                maybe_input_dep.set(pos->second);
+            }
+        }
+    }
+
+    // callers of functions which may be input dependent may be input dependent too
+    std::vector<llvm::Function*> worklist;
+    for (int i = maybe_input_dep.find_first(); i != -1; i = maybe_input_dep.find_next(i)) {
+        worklist.push_back(functions[i]);
+    }
+    while (!worklist.empty()) {
+        auto* F = worklist.back();
+        worklist.pop_back();
+        for (auto* caller : callers[F]) {
+            const unsigned idx = indices[caller];
+            if (!maybe_input_dep.test(idx)) {
+                maybe_input_dep.set(idx);
+                worklist.push_back(caller);
+            }
+        }
+    }
+
+    for (unsigned i = 0; i < functions.size(); ++i) {
+        if (maybe_input_dep.test(i)) {
+            m_calledFunctions.erase(functions[i]);
+        } else {
+            m_inputIndepFunctions.insert(functions[i]);
+        }
+    }
+}
+
+void AnalysisTiers::reset()
+{
+    m_enabled = false;
+    m_inputIndepFunctions.clear();
+    m_calledFunctions.clear();
+    std::fill(std::begin(m_tierCounts), std::end(m_tierCounts), 0);
+}
+
+const FunctionSet& AnalysisTiers::get_called_functions(llvm::Function* F) const
+{
+    auto pos = m_calledFunctions.find(F);
+    assert(pos != m_calledFunctions.end());
+    return pos->second;
+}
+
+void AnalysisTiers::mark_input_dep_function(llvm::Function* F) const
+{
+    FunctionSet marked;
+    std::vector<llvm::Function*> worklist{F};
+    while (!worklist.empty()) {
+        auto* function = worklist.back();
+        worklist.pop_back();
+        if (!marked.insert(function).second) {
+            continue;
+        }
+        InputDepConfig::get().add_input_dep_function(function);
+        const auto& calledFunctions = get_called_functions(function);
+        worklist.insert(worklist.end(), calledFunctions.begin(), calledFunctions.end());
+    }
+}
+
+bool AnalysisTiers::is_library_call_input_independent(llvm::Function* F) const
+{
+    auto Fname = Utils::demangle_name(F->getName().str());
+    if (Fname.empty()) {
+        Fname = F->getName().str();
+    }
+    if (F->isIntrinsic()) {
+        const auto& intrinsic_name = LLVMIntrinsicsInfo::get_intrinsic_name(Fname);
+        if (!intrinsic_name.empty()) {
+            Fname = intrinsic_name;
+        }
+    }
+    auto& libInfo = LibraryInfoManager::get();
+    if (!libInfo.hasLibFunctionInfo(Fname)) {
+        return false;
+    }
+    const auto& libFInfo = libInfo.getLibFunctionInfo(Fname);
+    if (libFInfo.getReturnDependency().dependency == DepInfo::INPUT_DEP) {
+        return false;
+    }
+    for (const auto& item : libFInfo.getArgumentDependencies()) {
+        if (item.second.dependency == DepInfo::INPUT_DEP) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool AnalysisTiers::has_input_dependencies(llvm::Function* F, llvm::Module& M, FunctionSet& calledFunctions) const
+{
+    for (auto& arg : F->args()) {
+        if (!arg.use_empty()) {
+            return true;
+        }
+    }
+    for (auto& B : *F) {
+        for (auto& I : B) {
+            if (auto* callInst = llvm::dyn_cast<llvm::CallInst>(&I)) {
+                if (callInst->isInlineAsm()) {
+                    return true;
+                }
+                auto* calledF = callInst->getCalledFunction();
+                if (!calledF || calledF == F) {
+                    return true;
+                }
+                // called function is the last operand
+                for (auto& op : callInst->operands()) {
+                    if (op.getOperandNo() + 1 != callInst->getNumOperands() && references_globals(op.get())) {
+                        return true;
+                    }
+                }
+                if (Utils::isLibraryFunction(calledF, &M)) {
+                    if (!is_library_call_input_independent(calledF)) {
+                        return true;
+                    }
+                } else {
+                    calledFunctions.insert(calledF);
+                }
+                continue;
+            }
+            // invokes are input dependent, as they may throw
+            if (llvm::isa<llvm::InvokeInst>(&I)) {
+                return true;
+            }
+            for (auto& op : I.operands()) {
+                if (references_globals(op.get())) {
+                    return true;
+                }
+            }
+            if (auto* loadInst = llvm::dyn_cast<llvm::LoadInst>(&I)) {
+                if (!is_local_memory(loadInst->getPointerOperand(), F)) {
+                    return true;
+                }
+            } else if (I.mayReadFromMemory()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace input_dependency
+
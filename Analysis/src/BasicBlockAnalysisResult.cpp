@@ -1,8 +1,10 @@
 #include "input-dependency/Analysis/BasicBlockAnalysisResult.h"
 
+#include "input-dependency/Analysis/AnalysisCostRecorder.h"
 #include "input-dependency/Analysis/Utils.h"
 #include "input-dependency/Analysis/FunctionAnaliser.h"
 #include "input-dependency/Analysis/InputDepConfig.h"
+#include "input-dependency/Analysis/MemoryAccounting.h"
 
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/IR/Constants.h"
@@ -57,6 +59,19 @@ void BasicBlockAnalysisResult::dumpResults() const
     dump();
 }
 
+void BasicBlockAnalysisResult::accountMemory(MemoryUsage& usage) const
+{
+    usage.addValueDependencies(m_valueDependencies);
+    usage.addValueDependencies(m_initialDependencies);
+    usage.addArgumentDependencies(m_outArgDependencies);
+    usage.addValueDep(m_returnValueDependencies);
+    usage.addFunctionCallsInfo(m_functionCallInfo);
+    usage.addInstructionDependencies(m_inputDependentInstrs);
+    usage.addResultSet(m_inputIndependentInstrs);
+    usage.addResultSet(m_globalDependentInstrs);
+    usage.addResultSet(m_finalInputDependentInstrs);
+}
+
 void BasicBlockAnalysisResult::analyze()
 {
     //llvm::dbgs() << "Analise block " << m_BB->getName() << "\n";
@@ -220,6 +235,7 @@ ValueDepInfo BasicBlockAnalysisResult::getRefInfo(llvm::Instruction* instr)
         if (!dep.first->getType()->isSized()) {
             continue;
         }
+        AnalysisCostRecorder::get().count_alias_query();
         auto modRef = m_AAR.getModRefInfo(instr, dep.first, DL.getTypeStoreSize(dep.first->getType()));
         if (modRef == llvm::ModRefInfo::MustRef || modRef == llvm::ModRefInfo::Ref) {
             info.mergeDependencies(dep.second);
@@ -236,6 +252,7 @@ void BasicBlockAnalysisResult::updateAliasesDependencies(llvm::Value* val, const
         if (valDep.first == val) {
             continue;
         }
+        AnalysisCostRecorder::get().count_alias_query();
         auto alias = m_AAR.alias(val, valDep.first);
         // what about partial alias
         if (alias == llvm::AliasResult::MayAlias) {
@@ -255,6 +272,7 @@ void BasicBlockAnalysisResult::updateAliasesDependencies(llvm::Value* val, const
         if (valDep.first == val) {
             continue;
         }
+        AnalysisCostRecorder::get().count_alias_query();
         auto alias = m_AAR.alias(val, valDep.first);
         if (alias == llvm::AliasResult::MayAlias) {
             //llvm::dbgs() << "May aliases " << *valDep.first << "\n";
@@ -275,6 +293,7 @@ void BasicBlockAnalysisResult::updateAliasesDependencies(llvm::Value* val, llvm:
         if (valDep.first == val) {
             continue;
         }
+        AnalysisCostRecorder::get().count_alias_query();
         auto alias = m_AAR.alias(val, valDep.first);
         if (alias == llvm::AliasResult::MayAlias || alias == llvm::AliasResult::PartialAlias) {
             //llvm::dbgs() << "May aliases " << *valDep.first << "\n";
@@ -291,6 +310,7 @@ void BasicBlockAnalysisResult::updateAliasesDependencies(llvm::Value* val, llvm:
         if (valDep.first == val) {
             continue;
         }
+        AnalysisCostRecorder::get().count_alias_query();
         auto alias = m_AAR.alias(val, valDep.first);
         if (alias == llvm::AliasResult::MayAlias || alias == llvm::AliasResult::PartialAlias) {
             valDep.second.mergeDependencies(elInstr, info);
@@ -307,6 +327,7 @@ void BasicBlockAnalysisResult::updateAliasingOutArgDependencies(llvm::Value* val
         if (arg_idx != -1 && arg_idx != arg.first->getArgNo()) {
             continue;
         }
+        AnalysisCostRecorder::get().count_alias_query();
         auto alias = m_AAR.alias(value, arg.first);
         if (alias != llvm::AliasResult::NoAlias) {
             //llvm::dbgs() << "   May alias\n";
@@ -329,6 +350,7 @@ void BasicBlockAnalysisResult::updateModAliasesDependencies(llvm::StoreInst* sto
         if (!dep.first->getType()->isSized()) {
             continue;
         }
+        AnalysisCostRecorder::get().count_alias_query();
         auto modRef = m_AAR.getModRefInfo(storeInst, dep.first, DL.getTypeStoreSize(dep.first->getType()));
         if (modRef == llvm::ModRefInfo::MustMod || modRef == llvm::ModRefInfo::Mod) {
             // if modifies given value should modify other aliases too, thus no need to set update_aliases flag
@@ -342,6 +364,7 @@ void BasicBlockAnalysisResult::updateModAliasesDependencies(llvm::StoreInst* sto
         if (!dep.first->getType()->isSized()) {
             continue;
         }
+        AnalysisCostRecorder::get().count_alias_query();
         auto modRef = m_AAR.getModRefInfo(storeInst, dep.first, DL.getTypeStoreSize(dep.first->getType()));
         if (modRef == llvm::ModRefInfo::MustMod || modRef == llvm::ModRefInfo::Mod) {
             updateValueDependencies(dep.first, info, false);
@@ -356,10 +379,12 @@ void BasicBlockAnalysisResult::updateRefAliasesDependencies(llvm::Instruction* i
         if (!dep.first->getType()->isSized()) {
             continue;
         }
+        AnalysisCostRecorder::get().count_alias_query();
         auto modRef = m_AAR.getModRefInfo(instr, dep.first, DL.getTypeStoreSize(dep.first->getType()));
         if (modRef == llvm::ModRefInfo::MustRef || modRef == llvm::ModRefInfo::Ref) {
             updateValueDependencies(dep.first, info, false);
         }
+        AnalysisCostRecorder::get().count_alias_query();
         auto alias = m_AAR.alias(instr, dep.first);
         if (alias == llvm::AliasResult::NoAlias) {
             continue;
@@ -377,16 +402,12 @@ void BasicBlockAnalysisResult::markFunctionsForValue(llvm::Value* value)
     }
     auto& functions = functions_pos->second;
     for (auto& F : functions) {
-        auto FA = m_FAG(F);
         // if no FA save for later point?
         llvm::dbgs() << "Set input dependency of a function " << F->getName() << "\n";
-        if (FA) {
-            FA->setIsInputDepFunction(true);
-        }
+        markInputDependentFunction(F);
         auto pos = m_functionCallInfo.insert(std::make_pair(F, FunctionCallDepInfo(*F)));
         pos.first->second.setIsCallback(true);
         m_calledFunctions.insert(F);
-        InputDepConfig::get().add_input_dep_function(F);
     }
 }
 
@@ -396,6 +417,7 @@ void BasicBlockAnalysisResult::markCallbackFunctionsForValue(llvm::Value* value)
         if (valDep.first == value) {
             markFunctionsForValue(value);
         }
+        AnalysisCostRecorder::get().count_alias_query();
         auto alias = m_AAR.alias(value, valDep.first);
         // what about partial alias
         if (alias == llvm::AliasResult::MayAlias || alias == llvm::AliasResult::MustAlias) {
@@ -410,6 +432,7 @@ void BasicBlockAnalysisResult::markCallbackFunctionsForValue(llvm::Value* value)
         if (valDep.first == value) {
             markFunctionsForValue(value);
         }
+        AnalysisCostRecorder::get().count_alias_query();
         auto alias = m_AAR.alias(value, valDep.first);
         // what about partial alias
         if (alias == llvm::AliasResult::MayAlias || alias == llvm::AliasResult::MustAlias) {
@@ -430,6 +453,7 @@ void BasicBlockAnalysisResult::removeCallbackFunctionsForValue(llvm::Value* valu
             m_functionValues.erase(pos);
             continue;
         }
+        AnalysisCostRecorder::get().count_alias_query();
         auto alias = m_AAR.alias(value, valDep.first);
         // must alias only, as in case of structs a callback field "may alias" even with other fields
         if (/*alias == llvm::AliasResult::MayAlias || */alias == llvm::AliasResult::MustAlias) {
@@ -449,6 +473,7 @@ void BasicBlockAnalysisResult::removeCallbackFunctionsForValue(llvm::Value* valu
             m_functionValues.erase(pos);
             continue;
         }
+        AnalysisCostRecorder::get().count_alias_query();
         auto alias = m_AAR.alias(value, valDep.first);
         // what about partial alias
         if (/*alias == llvm::AliasResult::MayAlias || */alias == llvm::AliasResult::MustAlias) {
@@ -10,6 +10,18 @@ void BasicBlocksUtils::addUnreachableBlock(llvm::BasicBlock* block)
     m_unreachableBlocks.insert(block);
 }
 
+void BasicBlocksUtils::removeFunctionUnreachableBlocks(llvm::Function* F)
+{
+    for (auto& B : *F) {
+        m_unreachableBlocks.erase(&B);
+    }
+}
+
+void BasicBlocksUtils::reset()
+{
+    m_unreachableBlocks.clear();
+}
+
 bool BasicBlocksUtils::isBlockUnreachable(llvm::BasicBlock* block) const
 {
     return m_unreachableBlocks.find(block) != m_unreachableBlocks.end();
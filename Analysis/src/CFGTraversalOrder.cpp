@@ -0,0 +1,261 @@
+#include "input-dependency/Analysis/CFGTraversalOrder.h"
+
+#include "llvm/ADT/PostOrderIterator.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/CFG.h"
+#include "llvm/IR/Function.h"
+
+#include <algorithm>
+#include <cassert>
+#include <tuple>
+
+namespace input_dependency {
+
+constexpr unsigned CFGTraversalOrder::UNDEF;
+
+CFGTraversalOrder::CFGTraversalOrder(llvm::Function& F, llvm::LoopInfo& LI)
+    : m_regionsCount(0)
+{
+    // Blocks of each loop level in reverse post order.
+    // Loop header is added to the level of parent loop, as it represents the whole loop there.
+    // Header has the smallest rpo number among its loop blocks, so the order of each level is topological,
+    // when child loops are collapsed to their headers.
+    llvm::DenseMap<llvm::Loop*, Blocks> level_blocks;
+    llvm::ReversePostOrderTraversal<llvm::Function*> rpot(&F);
+    for (auto* B : rpot) {
+        llvm::Loop* loop = LI.getLoopFor(B);
+        if (loop && loop->getHeader() == B) {
+            level_blocks[loop->getParentLoop()].push_back(B);
+        } else {
+            level_blocks[loop].push_back(B);
+        }
+    }
+    llvm::DenseMap<llvm::BasicBlock*, unsigned> regions;
+    order_irreducible_regions(F, LI, level_blocks[nullptr], regions);
+    add_level(nullptr, LI, level_blocks);
+    m_indices.reserve(m_blocks.size());
+    for (unsigned i = 0; i < m_blocks.size(); ++i) {
+        m_indices[m_blocks[i]] = i;
+    }
+    m_regions.assign(m_blocks.size(), UNDEF);
+    for (const auto& item : regions) {
+        m_regions[m_indices[item.first]] = item.second;
+    }
+}
+
+bool CFGTraversalOrder::hasBlock(llvm::BasicBlock* B) const
+{
+    return m_indices.find(B) != m_indices.end();
+}
+
+unsigned CFGTraversalOrder::getBlockIndex(llvm::BasicBlock* B) const
+{
+    auto pos = m_indices.find(B);
+    assert(pos != m_indices.end());
+    return pos->second;
+}
+
+std::pair<unsigned, unsigned> CFGTraversalOrder::getLoopInterval(llvm::Loop* L) const
+{
+    unsigned header_idx = getBlockIndex(L->getHeader());
+    return std::make_pair(header_idx, m_loopEnds[header_idx]);
+}
+
+llvm::BasicBlock* CFGTraversalOrder::getTopLevelLoopHeader(llvm::BasicBlock* B) const
+{
+    auto pos = m_indices.find(B);
+    if (pos == m_indices.end()) {
+        return nullptr;
+    }
+    unsigned header_idx = m_topLevelHeaders[pos->second];
+    return header_idx == UNDEF ? nullptr : m_blocks[header_idx];
+}
+
+CFGTraversalOrder::LevelNodes CFGTraversalOrder::getLevelNodes(llvm::Loop* L) const
+{
+    LevelNodes nodes;
+    unsigned begin = 0;
+    unsigned end = m_blocks.size();
+    if (L) {
+        std::tie(begin, end) = getLoopInterval(L);
+        // header of the level itself
+        nodes.push_back(std::make_pair(m_blocks[begin], nullptr));
+        ++begin;
+    }
+    unsigned idx = begin;
+    while (idx < end) {
+        llvm::Loop* loop = m_loops[idx];
+        if (loop == L) {
+            nodes.push_back(std::make_pair(m_blocks[idx], nullptr));
+            ++idx;
+        } else {
+            // header of immediate subloop, skip its body
+            nodes.push_back(std::make_pair(m_blocks[idx], loop));
+            idx = m_loopEnds[idx];
+        }
+    }
+    return nodes;
+}
+
+int CFGTraversalOrder::getIrreducibleRegion(llvm::BasicBlock* B) const
+{
+    auto pos = m_indices.find(B);
+    if (pos == m_indices.end() || m_regions[pos->second] == UNDEF) {
+        return -1;
+    }
+    return m_regions[pos->second];
+}
+
+void CFGTraversalOrder::order_irreducible_regions(llvm::Function& F,
+                                                  llvm::LoopInfo& LI,
+                                                  Blocks& nodes,
+                                                  llvm::DenseMap<llvm::BasicBlock*, unsigned>& regions)
+{
+    const unsigned size = nodes.size();
+    llvm::DenseMap<llvm::BasicBlock*, unsigned> node_ids;
+    node_ids.reserve(size);
+    for (unsigned i = 0; i < size; ++i) {
+        node_ids[nodes[i]] = i;
+    }
+    // maps block to function level node, top level loops are collapsed to their headers
+    const auto& get_node = [&LI, &node_ids] (llvm::BasicBlock* B) {
+        if (auto* loop = LI.getLoopFor(B)) {
+            while (loop->getParentLoop()) {
+                loop = loop->getParentLoop();
+            }
+            B = loop->getHeader();
+        }
+        auto pos = node_ids.find(B);
+        return pos == node_ids.end() ? UNDEF : pos->second;
+    };
+    std::vector<std::vector<unsigned>> successors(size);
+    for (auto& B : F) {
+        const unsigned src = get_node(&B);
+        if (src == UNDEF) {
+            continue;
+        }
+        for (auto succ = succ_begin(&B); succ != succ_end(&B); ++succ) {
+            const unsigned dst = get_node(*succ);
+            if (dst != UNDEF && dst != src) {
+                successors[src].push_back(dst);
+            }
+        }
+    }
+
+    // iterative Tarjan's SCC algorithm
+    std::vector<unsigned> dfs_numbers(size, UNDEF);
+    std::vector<unsigned> lowlinks(size, 0);
+    std::vector<unsigned> sccs(size, UNDEF);
+    std::vector<unsigned> scc_sizes;
+    std::vector<unsigned> scc_stack;
+    std::vector<bool> on_stack(size, false);
+    // pairs of node and next successor to visit
+    std::vector<std::pair<unsigned, unsigned>> dfs_stack;
+    unsigned counter = 0;
+    for (unsigned root = 0; root < size; ++root) {
+        if (dfs_numbers[root] != UNDEF) {
+            continue;
+        }
+        dfs_numbers[root] = lowlinks[root] = counter++;
+        scc_stack.push_back(root);
+        on_stack[root] = true;
+        dfs_stack.push_back(std::make_pair(root, 0));
+        while (!dfs_stack.empty()) {
+            const unsigned node = dfs_stack.back().first;
+            const unsigned succ_idx = dfs_stack.back().second;
+            if (succ_idx < successors[node].size()) {
+                ++dfs_stack.back().second;
+                const unsigned succ = successors[node][succ_idx];
+                if (dfs_numbers[succ] == UNDEF) {
+                    dfs_numbers[succ] = lowlinks[succ] = counter++;
+                    scc_stack.push_back(succ);
+                    on_stack[succ] = true;
+                    dfs_stack.push_back(std::make_pair(succ, 0));
+                } else if (on_stack[succ]) {
+                    lowlinks[node] = std::min(lowlinks[node], dfs_numbers[succ]);
+                }
+                continue;
+            }
+            dfs_stack.pop_back();
+            if (!dfs_stack.empty()) {
+                const unsigned parent = dfs_stack.back().first;
+                lowlinks[parent] = std::min(lowlinks[parent], lowlinks[node]);
+            }
+            if (lowlinks[node] != dfs_numbers[node]) {
+                continue;
+            }
+            const unsigned scc = scc_sizes.size();
+            scc_sizes.push_back(0);
+            unsigned scc_node;
+            do {
+                scc_node = scc_stack.back();
+                scc_stack.pop_back();
+                on_stack[scc_node] = false;
+                sccs[scc_node] = scc;
+                ++scc_sizes[scc];
+            } while (scc_node != node);
+        }
+    }
+    if (scc_sizes.size() == size) {
+        return;
+    }
+
+    // Place nodes of each irreducible scc together at the position of its first node.
+    // Ordering sccs by the first node in reverse post order keeps the condensed graph order topological.
+    std::vector<Blocks> scc_nodes(scc_sizes.size());
+    for (unsigned i = 0; i < size; ++i) {
+        if (scc_sizes[sccs[i]] > 1) {
+            scc_nodes[sccs[i]].push_back(nodes[i]);
+        }
+    }
+    Blocks ordered_nodes;
+    ordered_nodes.reserve(size);
+    std::vector<unsigned> region_ids(scc_sizes.size(), UNDEF);
+    for (unsigned i = 0; i < size; ++i) {
+        const unsigned scc = sccs[i];
+        if (scc_sizes[scc] == 1) {
+            ordered_nodes.push_back(nodes[i]);
+            continue;
+        }
+        if (region_ids[scc] != UNDEF) {
+            continue;
+        }
+        region_ids[scc] = m_regionsCount++;
+        for (auto* B : scc_nodes[scc]) {
+            ordered_nodes.push_back(B);
+            regions[B] = region_ids[scc];
+        }
+    }
+    nodes.swap(ordered_nodes);
+}
+
+void CFGTraversalOrder::add_level(llvm::Loop* L,
+                                  llvm::LoopInfo& LI,
+                                  const llvm::DenseMap<llvm::Loop*, Blocks>& level_blocks)
+{
+    auto pos = level_blocks.find(L);
+    if (pos == level_blocks.end()) {
+        return;
+    }
+    for (auto* B : pos->second) {
+        llvm::Loop* loop = LI.getLoopFor(B);
+        const unsigned idx = m_blocks.size();
+        m_blocks.push_back(B);
+        m_loops.push_back(loop);
+        m_loopEnds.push_back(idx + 1);
+        m_topLevelHeaders.push_back(UNDEF);
+        if (loop == L) {
+            continue;
+        }
+        // B is the header of immediate subloop
+        add_level(loop, LI, level_blocks);
+        m_loopEnds[idx] = m_blocks.size();
+        if (L == nullptr) {
+            std::fill(m_topLevelHeaders.begin() + idx, m_topLevelHeaders.end(), idx);
+        }
+    }
+}
+
+} // namespace input_dependency
+
@@ -1,6 +1,7 @@
 #include "input-dependency/Analysis/CachedFunctionAnalysisResult.h"
 
 #include "input-dependency/Analysis/constants.h"
+#include "input-dependency/Analysis/MemoryAccounting.h"
 
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/BasicBlock.h"
@@ -243,5 +244,20 @@ long unsigned CachedFunctionAnalysisResult::get_input_unknowns_count() const
     return m_unknownInstructions.size();
 }
 
+void CachedFunctionAnalysisResult::accountMemory(MemoryUsage& usage) const
+{
+    usage.addResultSet(m_inputDepBlocks);
+    usage.addResultSet(m_inputInDepBlocks);
+    usage.addResultSet(m_unreachableBlocks);
+    usage.addResultSet(m_inputDepInstructions);
+    usage.addResultSet(m_inputIndepInstructions);
+    usage.addResultSet(m_controlDepInstructions);
+    usage.addResultSet(m_dataDepInstructions);
+    usage.addResultSet(m_globalDepInstructions);
+    usage.addResultSet(m_argumentDepInstructions);
+    usage.addResultSet(m_unknownInstructions);
+    usage.addResultSet(m_unreachableInstructions);
+}
+
 }
 
@@ -1,5 +1,6 @@
 #include "input-dependency/Analysis/CachedInputDependencyAnalysis.h"
 #include "input-dependency/Analysis/Utils.h"
+#include "input-dependency/Analysis/PhaseTimer.h"
 
 #include "input-dependency/Analysis/CachedFunctionAnalysisResult.h"
 
@@ -23,6 +24,7 @@ void CachedInputDependencyAnalysis::run()
         if (Utils::isLibraryFunction(&F, m_module)) {
             continue;
         }
+        PhaseTimer timer("cached analysis", &F);
         InputDepResType analiser(new CachedFunctionAnalysisResult(&F));
         auto res = m_functionAnalisers.insert(std::make_pair(&F, analiser));
         assert(res.second);
@@ -0,0 +1,178 @@
+#include "input-dependency/Analysis/CallGraphPartitioner.h"
+
+#include "llvm/ADT/SCCIterator.h"
+#include "llvm/Analysis/CallGraph.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace input_dependency {
+
+namespace {
+
+/// Moves between partitions stop after this many passes even if they still reduce the cut
+const unsigned max_refinement_passes = 8;
+
+unsigned long get_function_size(llvm::Function* F)
+{
+    unsigned long size = 0;
+    for (auto& B : *F) {
+        size += B.size();
+    }
+    return size;
+}
+
+}
+
+CallGraphPartitioner::CallGraphPartitioner(llvm::Module& M, llvm::CallGraph& callGraph)
+    : m_module(M)
+    , m_callGraph(callGraph)
+{
+}
+
+void CallGraphPartitioner::partition(unsigned partitionsCount)
+{
+    assert(partitionsCount != 0);
+    collectUnits();
+    unsigned long totalSize = 0;
+    for (auto size : m_unitSizes) {
+        totalSize += size;
+    }
+    // partitions may exceed even share by a tenth, to keep connected SCCs together
+    const unsigned long evenSize = (totalSize + partitionsCount - 1) / partitionsCount;
+    const unsigned long capacity = evenSize + evenSize / 10 + 1;
+    m_partitionSizes.assign(partitionsCount, 0);
+    assignUnits(capacity);
+    unsigned passes = 0;
+    while (passes < max_refinement_passes && refine(capacity)) {
+        ++passes;
+    }
+    llvm::dbgs() << "Partitioned " << m_functionUnits.size() << " functions into " << partitionsCount
+                 << " partitions: " << getCutEdgesCount() << " of " << m_edgesCount << " call edges cut after "
+                 << passes << " refinement passes\n";
+}
+
+unsigned CallGraphPartitioner::getPartition(llvm::Function* F) const
+{
+    auto pos = m_functionUnits.find(F);
+    assert(pos != m_functionUnits.end());
+    return m_unitPartitions[pos->second];
+}
+
+unsigned long CallGraphPartitioner::getCutEdgesCount() const
+{
+    unsigned long cut = 0;
+    for (unsigned unit = 0; unit < m_unitEdges.size(); ++unit) {
+        for (const auto& edge : m_unitEdges[unit]) {
+            // each edge is kept in both directions
+            if (edge.first > unit && m_unitPartitions[edge.first] != m_unitPartitions[unit]) {
+                cut += edge.second;
+            }
+        }
+    }
+    return cut;
+}
+
+void CallGraphPartitioner::collectUnits()
+{
+    m_units.clear();
+    m_unitSizes.clear();
+    m_functionUnits.clear();
+    for (auto CGI = llvm::scc_begin(&m_callGraph); !CGI.isAtEnd(); ++CGI) {
+        std::vector<llvm::Function*> functions;
+        unsigned long size = 0;
+        for (llvm::CallGraphNode* node : *CGI) {
+            llvm::Function* F = node->getFunction();
+            if (F == nullptr || F->isDeclaration()) {
+                continue;
+            }
+            m_functionUnits[F] = m_units.size();
+            functions.push_back(F);
+            size += get_function_size(F);
+        }
+        if (!functions.empty()) {
+            m_units.push_back(std::move(functions));
+            m_unitSizes.push_back(size);
+        }
+    }
+    m_unitEdges.assign(m_units.size(), std::unordered_map<unsigned, unsigned long>());
+    m_edgesCount = 0;
+    for (unsigned unit = 0; unit < m_units.size(); ++unit) {
+        for (auto* F : m_units[unit]) {
+            for (const auto& callee : *m_callGraph[F]) {
+                auto pos = m_functionUnits.find(callee.second->getFunction());
+                if (pos == m_functionUnits.end() || pos->second == unit) {
+                    continue;
+                }
+                ++m_unitEdges[unit][pos->second];
+                ++m_unitEdges[pos->second][unit];
+                ++m_edgesCount;
+            }
+        }
+    }
+}
+
+void CallGraphPartitioner::assignUnits(unsigned long capacity)
+{
+    m_unitPartitions.assign(m_units.size(), m_partitionSizes.size());
+    for (unsigned unit = 0; unit < m_units.size(); ++unit) {
+        const auto& connections = getPartitionConnections(unit);
+        // lightest partition, unless unit is connected to a partition with room for it
+        unsigned best = std::min_element(m_partitionSizes.begin(), m_partitionSizes.end()) - m_partitionSizes.begin();
+        unsigned long bestConnection = 0;
+        for (const auto& item : connections) {
+            if (item.second > bestConnection && m_partitionSizes[item.first] + m_unitSizes[unit] <= capacity) {
+                best = item.first;
+                bestConnection = item.second;
+            }
+        }
+        m_unitPartitions[unit] = best;
+        m_partitionSizes[best] += m_unitSizes[unit];
+    }
+}
+
+bool CallGraphPartitioner::refine(unsigned long capacity)
+{
+    bool moved = false;
+    for (unsigned unit = 0; unit < m_units.size(); ++unit) {
+        const unsigned current = m_unitPartitions[unit];
+        const auto& connections = getPartitionConnections(unit);
+        auto pos = connections.find(current);
+        const unsigned long internal = pos == connections.end() ? 0 : pos->second;
+        unsigned best = current;
+        unsigned long bestConnection = internal;
+        for (const auto& item : connections) {
+            if (item.second > bestConnection && m_partitionSizes[item.first] + m_unitSizes[unit] <= capacity) {
+                best = item.first;
+                bestConnection = item.second;
+            }
+        }
+        if (best != current) {
+            m_partitionSizes[current] -= m_unitSizes[unit];
+            m_partitionSizes[best] += m_unitSizes[unit];
+            m_unitPartitions[unit] = best;
+            moved = true;
+        }
+    }
+    return moved;
+}
+
+std::unordered_map<unsigned, unsigned long> CallGraphPartitioner::getPartitionConnections(unsigned unit) const
+{
+    std::unordered_map<unsigned, unsigned long> connections;
+    for (const auto& edge : m_unitEdges[unit]) {
+        const unsigned partition = m_unitPartitions[edge.first];
+        // units not assigned yet have partition out of range
+        if (partition < m_partitionSizes.size()) {
+            connections[partition] += edge.second;
+        }
+    }
+    return connections;
+}
+
+} // namespace input_dependency
+
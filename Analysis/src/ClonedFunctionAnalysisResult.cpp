@@ -1,6 +1,7 @@
 #include "input-dependency/Analysis/ClonedFunctionAnalysisResult.h"
 
 #include "input-dependency/Analysis/BasicBlocksUtils.h"
+#include "input-dependency/Analysis/MemoryAccounting.h"
 
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/BasicBlock.h"
@@ -240,6 +241,21 @@ long unsigned ClonedFunctionAnalysisResult::get_input_unknowns_count() const
     return m_instructionsCount - get_input_dep_count() - get_input_indep_count();
 }
 
+void ClonedFunctionAnalysisResult::accountMemory(MemoryUsage& usage) const
+{
+    usage.addResultSet(m_inputIndependentInstrs);
+    usage.addResultSet(m_inputDependentInstrs);
+    usage.addResultSet(m_dataDependentInstrs);
+    usage.addResultSet(m_argumentDependentInstrs);
+    usage.addResultSet(m_globalDependentInstrs);
+    usage.addResultSet(m_inputDependentBasicBlocks);
+    usage.addResultSet(m_argumentDependentBasicBlocks);
+    usage.call_dep_info += MemoryUsage::container_bytes(m_functionCallDepInfo);
+    for (const auto& item : m_functionCallDepInfo) {
+        usage.addFunctionCallInfo(item.second);
+    }
+}
+
 
 } // namespace input_dependency
 
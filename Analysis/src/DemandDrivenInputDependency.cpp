@@ -0,0 +1,651 @@
+#include "input-dependency/Analysis/DemandDrivenInputDependency.h"
+
+#include "input-dependency/Analysis/IndirectCallSitesAnalysis.h"
+#include "input-dependency/Analysis/LibFunctionInfo.h"
+#include "input-dependency/Analysis/LibraryInfoManager.h"
+#include "input-dependency/Analysis/LLVMIntrinsicsInfo.h"
+#include "input-dependency/Analysis/Utils.h"
+
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/PostDominators.h"
+#include "llvm/IR/CFG.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Operator.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <deque>
+
+namespace input_dependency {
+
+namespace {
+
+llvm::Value* get_called_value(llvm::Instruction* I)
+{
+    if (auto* callInst = llvm::dyn_cast<llvm::CallInst>(I)) {
+        return callInst->getCalledValue();
+    }
+    if (auto* invokeInst = llvm::dyn_cast<llvm::InvokeInst>(I)) {
+        return invokeInst->getCalledValue();
+    }
+    return nullptr;
+}
+
+unsigned get_num_arg_operands(llvm::Instruction* I)
+{
+    if (auto* callInst = llvm::dyn_cast<llvm::CallInst>(I)) {
+        return callInst->getNumArgOperands();
+    }
+    return llvm::cast<llvm::InvokeInst>(I)->getNumArgOperands();
+}
+
+llvm::Value* get_arg_operand(llvm::Instruction* I, unsigned i)
+{
+    if (auto* callInst = llvm::dyn_cast<llvm::CallInst>(I)) {
+        return callInst->getArgOperand(i);
+    }
+    return llvm::cast<llvm::InvokeInst>(I)->getArgOperand(i);
+}
+
+llvm::Argument* get_function_argument(llvm::Function* F, unsigned i)
+{
+    if (i >= F->arg_size()) {
+        return nullptr;
+    }
+    auto it = F->arg_begin();
+    std::advance(it, i);
+    return &*it;
+}
+
+// Returns object pointer points into, looking through casts and GEPs
+llvm::Value* get_memory_object(llvm::Value* pointer)
+{
+    llvm::Value* object = pointer->stripPointerCasts();
+    while (auto* gep = llvm::dyn_cast<llvm::GEPOperator>(object)) {
+        object = gep->getPointerOperand()->stripPointerCasts();
+    }
+    return object;
+}
+
+std::string get_library_function_name(llvm::Function* F)
+{
+    auto Fname = Utils::demangle_name(F->getName().str());
+    if (Fname.empty()) {
+        Fname = F->getName().str();
+    }
+    if (F->isIntrinsic()) {
+        const auto& intrinsic_name = LLVMIntrinsicsInfo::get_intrinsic_name(Fname);
+        if (!intrinsic_name.empty()) {
+            Fname = intrinsic_name;
+        }
+    }
+    return Fname;
+}
+
+// Returns library function info of declaration F, or nullptr if there is none
+const LibFunctionInfo* get_library_function_info(llvm::Function* F)
+{
+    const auto& Fname = get_library_function_name(F);
+    auto& libInfo = LibraryInfoManager::get();
+    if (!libInfo.hasLibFunctionInfo(Fname)) {
+        return nullptr;
+    }
+    libInfo.resolveLibFunctionInfo(F, Fname);
+    return &libInfo.getLibFunctionInfo(Fname);
+}
+
+llvm::Value* get_branch_condition(llvm::Instruction* terminator)
+{
+    if (auto* branch = llvm::dyn_cast<llvm::BranchInst>(terminator)) {
+        return branch->isConditional() ? branch->getCondition() : nullptr;
+    }
+    if (auto* switchInst = llvm::dyn_cast<llvm::SwitchInst>(terminator)) {
+        return switchInst->getCondition();
+    }
+    if (auto* indirectBr = llvm::dyn_cast<llvm::IndirectBrInst>(terminator)) {
+        return indirectBr->getAddress();
+    }
+    return nullptr;
+}
+
+void collect_referencing_functions(llvm::Value* value, FunctionSet& functions)
+{
+    for (auto* user : value->users()) {
+        if (auto* instr = llvm::dyn_cast<llvm::Instruction>(user)) {
+            functions.insert(instr->getFunction());
+        } else if (llvm::isa<llvm::ConstantExpr>(user)) {
+            collect_referencing_functions(user, functions);
+        }
+    }
+}
+
+// Returns true if address held by value may be stored, returned or converted, i.e. memory it points to may be accessed
+// in functions not referencing it
+bool may_address_escape(llvm::Value* value, ValueSet& visited)
+{
+    if (!visited.insert(value).second) {
+        return false;
+    }
+    for (auto& use : value->uses()) {
+        auto* user = use.getUser();
+        if (llvm::isa<llvm::LoadInst>(user) || llvm::isa<llvm::CmpInst>(user)) {
+            continue;
+        }
+        if (auto* store = llvm::dyn_cast<llvm::StoreInst>(user)) {
+            if (store->getValueOperand() == value) {
+                return true;
+            }
+            continue;
+        }
+        if (llvm::isa<llvm::GEPOperator>(user) || llvm::isa<llvm::BitCastOperator>(user)
+                || llvm::isa<llvm::PHINode>(user) || llvm::isa<llvm::SelectInst>(user)) {
+            if (may_address_escape(user, visited)) {
+                return true;
+            }
+            continue;
+        }
+        if (llvm::isa<llvm::CallInst>(user) || llvm::isa<llvm::InvokeInst>(user)) {
+            auto* callInstr = llvm::cast<llvm::Instruction>(user);
+            auto* callee = llvm::dyn_cast<llvm::Function>(get_called_value(callInstr)->stripPointerCasts());
+            if (!callee || callee->isVarArg()) {
+                return true;
+            }
+            // library functions do not keep passed pointers, modifications through them are collected at call sites
+            if (callee->isDeclaration()) {
+                continue;
+            }
+            auto* arg = get_function_argument(callee, use.getOperandNo());
+            if (!arg || may_address_escape(arg, visited)) {
+                return true;
+            }
+            continue;
+        }
+        // returns, ptrtoint, initializers of other globals
+        return true;
+    }
+    return false;
+}
+
+}
+
+DemandDrivenInputDependency::DemandDrivenInputDependency(llvm::Module* M)
+    : m_module(M)
+    , m_virtualCallSiteAnalysisRes(nullptr)
+    , m_indirectCallSiteAnalysisRes(nullptr)
+    , m_fullAnalysis(nullptr)
+    , m_sliceLimit(0)
+    , m_queriesCount(0)
+    , m_fallbacksCount(0)
+{
+}
+
+void DemandDrivenInputDependency::setVirtualCallSiteAnalysisResult(const VirtualCallSiteAnalysisResult* virtualCallSiteAnalysisRes)
+{
+    m_virtualCallSiteAnalysisRes = virtualCallSiteAnalysisRes;
+}
+
+void DemandDrivenInputDependency::setIndirectCallSiteAnalysisResult(const IndirectCallSitesAnalysisResult* indirectCallSiteAnalysisRes)
+{
+    m_indirectCallSiteAnalysisRes = indirectCallSiteAnalysisRes;
+}
+
+void DemandDrivenInputDependency::setAliasAnalysisInfoGetter(const AliasAnalysisInfoGetter& aliasAnalysisInfoGetter)
+{
+    m_aliasAnalysisInfoGetter = aliasAnalysisInfoGetter;
+}
+
+void DemandDrivenInputDependency::setPostDominatorTreeGetter(const PostDominatorTreeGetter& postDomTreeGetter)
+{
+    m_postDomTreeGetter = postDomTreeGetter;
+}
+
+void DemandDrivenInputDependency::setFullAnalysisGetter(const FullAnalysisGetter& fullAnalysisGetter)
+{
+    m_fullAnalysisGetter = fullAnalysisGetter;
+}
+
+void DemandDrivenInputDependency::setSliceLimit(unsigned long limit)
+{
+    m_sliceLimit = limit;
+}
+
+bool DemandDrivenInputDependency::isInputDependent(llvm::Instruction* I)
+{
+    ++m_queriesCount;
+    auto res = slice(SliceNode{SliceNode::VALUE, I, nullptr});
+    if (res == SliceResult::LIMIT_EXCEEDED) {
+        return isInputDependentByFullAnalysis(I);
+    }
+    return res == SliceResult::INPUT_DEP;
+}
+
+bool DemandDrivenInputDependency::isInputDependent(llvm::BasicBlock* block)
+{
+    ++m_queriesCount;
+    auto res = slice(SliceNode{SliceNode::CONTROL, block, block->getParent()});
+    if (res == SliceResult::LIMIT_EXCEEDED) {
+        return isInputDependentByFullAnalysis(block);
+    }
+    return res == SliceResult::INPUT_DEP;
+}
+
+DemandDrivenInputDependency::SliceResult DemandDrivenInputDependency::slice(const SliceNode& query)
+{
+    auto memo_pos = m_memo.find(query);
+    if (memo_pos != m_memo.end()) {
+        return memo_pos->second ? SliceResult::INPUT_DEP : SliceResult::INPUT_INDEP;
+    }
+    // breadth first, keeping the node each node was reached from, to mark the path to an input source
+    std::unordered_map<SliceNode, SliceNode, SliceNodeHash> reachedFrom;
+    std::deque<SliceNode> worklist;
+    reachedFrom.insert(std::make_pair(query, query));
+    worklist.push_back(query);
+    SliceNodes deps;
+    while (!worklist.empty()) {
+        auto node = worklist.front();
+        worklist.pop_front();
+        deps.clear();
+        bool is_input_dep = collectDependencies(node, deps);
+        for (auto dep_it = deps.begin(); !is_input_dep && dep_it != deps.end(); ++dep_it) {
+            auto dep_memo = m_memo.find(*dep_it);
+            if (dep_memo != m_memo.end()) {
+                is_input_dep = dep_memo->second;
+                continue;
+            }
+            if (reachedFrom.insert(std::make_pair(*dep_it, node)).second) {
+                worklist.push_back(*dep_it);
+            }
+        }
+        if (is_input_dep) {
+            // every node on the path from the query depends on input
+            while (!(node == query)) {
+                m_memo[node] = true;
+                node = reachedFrom.find(node)->second;
+            }
+            m_memo[query] = true;
+            return SliceResult::INPUT_DEP;
+        }
+        if (m_sliceLimit != 0 && reachedFrom.size() > m_sliceLimit) {
+            return SliceResult::LIMIT_EXCEEDED;
+        }
+    }
+    // the whole slice is explored, thus none of its nodes depends on input
+    for (const auto& item : reachedFrom) {
+        m_memo[item.first] = false;
+    }
+    return SliceResult::INPUT_INDEP;
+}
+
+bool DemandDrivenInputDependency::collectDependencies(const SliceNode& node, SliceNodes& deps)
+{
+    switch (node.kind) {
+    case SliceNode::VALUE:
+        return collectValueDependencies(node.value, deps);
+    case SliceNode::CONTROL:
+        return collectControlDependencies(llvm::cast<llvm::BasicBlock>(node.value), deps);
+    case SliceNode::MEMORY:
+        return collectMemoryDependencies(node.value, node.function, deps);
+    }
+    return true;
+}
+
+bool DemandDrivenInputDependency::collectValueDependencies(llvm::Value* value, SliceNodes& deps)
+{
+    if (auto* I = llvm::dyn_cast<llvm::Instruction>(value)) {
+        return collectInstructionDependencies(I, deps);
+    }
+    if (auto* arg = llvm::dyn_cast<llvm::Argument>(value)) {
+        return collectArgumentDependencies(arg, deps);
+    }
+    // constants, globals and functions are addresses or known values
+    return false;
+}
+
+bool DemandDrivenInputDependency::collectInstructionDependencies(llvm::Instruction* I, SliceNodes& deps)
+{
+    deps.push_back(SliceNode{SliceNode::CONTROL, I->getParent(), I->getFunction()});
+    if (auto* load = llvm::dyn_cast<llvm::LoadInst>(I)) {
+        deps.push_back(SliceNode{SliceNode::VALUE, load->getPointerOperand(), nullptr});
+        deps.push_back(SliceNode{SliceNode::MEMORY, load->getPointerOperand(), I->getFunction()});
+        return false;
+    }
+    if (llvm::isa<llvm::CallInst>(I) || llvm::isa<llvm::InvokeInst>(I)) {
+        return collectCallDependencies(I, deps);
+    }
+    if (auto* phi = llvm::dyn_cast<llvm::PHINode>(I)) {
+        // incoming value is chosen by branches leading to the phi
+        for (unsigned i = 0; i < phi->getNumIncomingValues(); ++i) {
+            auto* incomingBlock = phi->getIncomingBlock(i);
+            deps.push_back(SliceNode{SliceNode::VALUE, phi->getIncomingValue(i), nullptr});
+            deps.push_back(SliceNode{SliceNode::CONTROL, incomingBlock, I->getFunction()});
+            if (auto* condition = get_branch_condition(incomingBlock->getTerminator())) {
+                deps.push_back(SliceNode{SliceNode::VALUE, condition, nullptr});
+            }
+        }
+        return false;
+    }
+    for (auto& op : I->operands()) {
+        if (llvm::isa<llvm::Instruction>(op.get()) || llvm::isa<llvm::Argument>(op.get())) {
+            deps.push_back(SliceNode{SliceNode::VALUE, op.get(), nullptr});
+        }
+    }
+    return false;
+}
+
+bool DemandDrivenInputDependency::collectArgumentDependencies(llvm::Argument* arg, SliceNodes& deps)
+{
+    const auto& callSites = getCallSites(arg->getParent());
+    if (callSites.empty()) {
+        // the same as for the whole module analysis, arguments of functions without callers are input dependent
+        return true;
+    }
+    for (auto* callSite : callSites) {
+        if (arg->getArgNo() < get_num_arg_operands(callSite)) {
+            addActualArgumentDependencies(get_arg_operand(callSite, arg->getArgNo()), callSite->getFunction(), deps);
+        }
+    }
+    return false;
+}
+
+bool DemandDrivenInputDependency::collectCallDependencies(llvm::Instruction* callInstr, SliceNodes& deps)
+{
+    FunctionSet callees;
+    if (!getCallees(callInstr, callees)) {
+        return true;
+    }
+    for (auto* callee : callees) {
+        if (!callee->isDeclaration()) {
+            for (auto& B : *callee) {
+                if (auto* ret = llvm::dyn_cast<llvm::ReturnInst>(B.getTerminator())) {
+                    if (auto* retValue = ret->getReturnValue()) {
+                        deps.push_back(SliceNode{SliceNode::VALUE, retValue, nullptr});
+                        deps.push_back(SliceNode{SliceNode::CONTROL, &B, callee});
+                    }
+                }
+            }
+            continue;
+        }
+        auto* libFInfo = get_library_function_info(callee);
+        if (!libFInfo) {
+            return true;
+        }
+        const auto& retDep = libFInfo->getResolvedReturnDependency().getValueDep();
+        if (retDep.isInputIndep()) {
+            continue;
+        }
+        if (!retDep.isInputArgumentDep()) {
+            return true;
+        }
+        for (auto* arg : retDep.getArgumentDependencies()) {
+            if (arg->getArgNo() < get_num_arg_operands(callInstr)) {
+                addActualArgumentDependencies(get_arg_operand(callInstr, arg->getArgNo()), callInstr->getFunction(), deps);
+            }
+        }
+    }
+    return false;
+}
+
+bool DemandDrivenInputDependency::collectControlDependencies(llvm::BasicBlock* block, SliceNodes& deps)
+{
+    for (auto* terminator : getControllingTerminators(block)) {
+        deps.push_back(SliceNode{SliceNode::VALUE, get_branch_condition(terminator), nullptr});
+        deps.push_back(SliceNode{SliceNode::CONTROL, terminator->getParent(), block->getParent()});
+    }
+    return false;
+}
+
+bool DemandDrivenInputDependency::collectMemoryDependencies(llvm::Value* pointer, llvm::Function* F, SliceNodes& deps)
+{
+    if (!pointer->getType()->isPointerTy()) {
+        return true;
+    }
+    // memory on function entry
+    llvm::Value* object = get_memory_object(pointer);
+    if (auto* global = llvm::dyn_cast<llvm::GlobalVariable>(object)) {
+        if (!global->hasDefinitiveInitializer()) {
+            return true;
+        }
+        if (global->isConstant()) {
+            return false;
+        }
+        // memory of global accessed through escaped address is not found in referencing functions
+        if (doesAddressEscape(global)) {
+            return true;
+        }
+        for (auto* referencingF : getReferencingFunctions(global)) {
+            if (referencingF != F) {
+                deps.push_back(SliceNode{SliceNode::MEMORY, global, referencingF});
+            }
+        }
+    } else if (auto* arg = llvm::dyn_cast<llvm::Argument>(object)) {
+        const auto& callSites = getCallSites(arg->getParent());
+        if (callSites.empty()) {
+            return true;
+        }
+        for (auto* callSite : callSites) {
+            if (arg->getArgNo() < get_num_arg_operands(callSite)) {
+                deps.push_back(SliceNode{SliceNode::MEMORY, get_arg_operand(callSite, arg->getArgNo()), callSite->getFunction()});
+            }
+        }
+    } else if (!llvm::isa<llvm::AllocaInst>(object)) {
+        // heap, or memory pointed by loaded pointers
+        return true;
+    }
+
+    // memory modified in function, in any order
+    auto* pointeeTy = pointer->getType()->getPointerElementType();
+    llvm::AAResults* AAR = m_aliasAnalysisInfoGetter ? m_aliasAnalysisInfoGetter(F) : nullptr;
+    const auto& DL = m_module->getDataLayout();
+    for (auto& B : *F) {
+        for (auto& I : B) {
+            if (!I.mayWriteToMemory()) {
+                continue;
+            }
+            if (AAR && pointeeTy->isSized()
+                    && !llvm::isModSet(AAR->getModRefInfo(&I, pointer, DL.getTypeStoreSize(pointeeTy)))) {
+                continue;
+            }
+            deps.push_back(SliceNode{SliceNode::CONTROL, &B, F});
+            if (auto* store = llvm::dyn_cast<llvm::StoreInst>(&I)) {
+                deps.push_back(SliceNode{SliceNode::VALUE, store->getValueOperand(), nullptr});
+            } else if (llvm::isa<llvm::CallInst>(&I) || llvm::isa<llvm::InvokeInst>(&I)) {
+                if (collectCallModDependencies(&I, deps)) {
+                    return true;
+                }
+            } else {
+                for (auto& op : I.operands()) {
+                    deps.push_back(SliceNode{SliceNode::VALUE, op.get(), nullptr});
+                }
+            }
+        }
+    }
+    return false;
+}
+
+bool DemandDrivenInputDependency::collectCallModDependencies(llvm::Instruction* callInstr, SliceNodes& deps)
+{
+    FunctionSet callees;
+    if (!getCallees(callInstr, callees)) {
+        return true;
+    }
+    for (auto* callee : callees) {
+        const LibFunctionInfo* libFInfo = nullptr;
+        if (callee->isDeclaration()) {
+            libFInfo = get_library_function_info(callee);
+            if (!libFInfo) {
+                // the same as the whole module analysis, out arguments of unknown functions are input dependent
+                return true;
+            }
+        }
+        for (unsigned i = 0; i < get_num_arg_operands(callInstr); ++i) {
+            llvm::Value* actualArg = get_arg_operand(callInstr, i);
+            auto* formalArg = get_function_argument(callee, i);
+            if (!formalArg || !actualArg->getType()->isPointerTy()) {
+                continue;
+            }
+            if (!libFInfo) {
+                deps.push_back(SliceNode{SliceNode::MEMORY, formalArg, callee});
+                continue;
+            }
+            if (!libFInfo->hasResolvedArgument(formalArg)) {
+                continue;
+            }
+            const auto& argDep = libFInfo->getResolvedArgumentDependencies(formalArg).getValueDep();
+            if (argDep.isInputIndep()) {
+                continue;
+            }
+            if (!argDep.isInputArgumentDep()) {
+                return true;
+            }
+            for (auto* arg : argDep.getArgumentDependencies()) {
+                if (arg->getArgNo() < get_num_arg_operands(callInstr)) {
+                    addActualArgumentDependencies(get_arg_operand(callInstr, arg->getArgNo()), callInstr->getFunction(), deps);
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void DemandDrivenInputDependency::addActualArgumentDependencies(llvm::Value* actualArg, llvm::Function* F, SliceNodes& deps)
+{
+    deps.push_back(SliceNode{SliceNode::VALUE, actualArg, nullptr});
+    // pointer arguments pass memory they point to as well
+    if (actualArg->getType()->isPointerTy()) {
+        deps.push_back(SliceNode{SliceNode::MEMORY, actualArg, F});
+    }
+}
+
+bool DemandDrivenInputDependency::getCallees(llvm::Instruction* callInstr, FunctionSet& callees) const
+{
+    llvm::Value* calledValue = get_called_value(callInstr);
+    if (auto* F = llvm::dyn_cast<llvm::Function>(calledValue->stripPointerCasts())) {
+        callees.insert(F);
+        return true;
+    }
+    if (m_virtualCallSiteAnalysisRes && m_virtualCallSiteAnalysisRes->hasVirtualCallCandidates(callInstr)) {
+        const auto& candidates = m_virtualCallSiteAnalysisRes->getVirtualCallCandidates(callInstr);
+        callees.insert(candidates.begin(), candidates.end());
+    } else if (m_indirectCallSiteAnalysisRes) {
+        auto* FType = llvm::cast<llvm::FunctionType>(calledValue->getType()->getPointerElementType());
+        if (m_indirectCallSiteAnalysisRes->hasIndirectTargets(FType)) {
+            const auto& targets = m_indirectCallSiteAnalysisRes->getIndirectTargets(FType);
+            callees.insert(targets.begin(), targets.end());
+        }
+    }
+    return !callees.empty();
+}
+
+const DemandDrivenInputDependency::Instructions& DemandDrivenInputDependency::getCallSites(llvm::Function* F)
+{
+    auto pos = m_callSites.find(F);
+    if (pos != m_callSites.end()) {
+        return pos->second;
+    }
+    auto& callSites = m_callSites[F];
+    // indirect callers are not known
+    if (F->hasAddressTaken()) {
+        return callSites;
+    }
+    for (auto* user : F->users()) {
+        if (llvm::isa<llvm::CallInst>(user) || llvm::isa<llvm::InvokeInst>(user)) {
+            callSites.push_back(llvm::cast<llvm::Instruction>(user));
+        }
+    }
+    return callSites;
+}
+
+const DemandDrivenInputDependency::Instructions& DemandDrivenInputDependency::getControllingTerminators(llvm::BasicBlock* block)
+{
+    llvm::Function* F = block->getParent();
+    auto pos = m_controlDependencies.find(F);
+    if (pos != m_controlDependencies.end()) {
+        return pos->second[block];
+    }
+    auto& controlDeps = m_controlDependencies[F];
+    const llvm::PostDominatorTree* PDom = m_postDomTreeGetter ? m_postDomTreeGetter(F) : nullptr;
+    Instructions branches;
+    for (auto& B : *F) {
+        auto* terminator = B.getTerminator();
+        if (!get_branch_condition(terminator)) {
+            continue;
+        }
+        branches.push_back(terminator);
+        if (!PDom) {
+            continue;
+        }
+        // blocks post dominating a successor up to the immediate post dominator of B depend on B's branch
+        auto* BNode = PDom->getNode(&B);
+        auto* stopNode = BNode ? BNode->getIDom() : nullptr;
+        for (auto* succ : llvm::successors(&B)) {
+            for (auto* node = PDom->getNode(succ); node && node != stopNode; node = node->getIDom()) {
+                controlDeps[node->getBlock()].push_back(terminator);
+            }
+        }
+    }
+    // blocks without post dominator tree nodes, e.g. in infinite loops, are controlled by every branch
+    for (auto& B : *F) {
+        if (!PDom || !PDom->getNode(&B)) {
+            controlDeps[&B] = branches;
+        }
+    }
+    return controlDeps[block];
+}
+
+const FunctionSet& DemandDrivenInputDependency::getReferencingFunctions(llvm::GlobalVariable* global)
+{
+    auto pos = m_referencingFunctions.find(global);
+    if (pos != m_referencingFunctions.end()) {
+        return pos->second;
+    }
+    auto& functions = m_referencingFunctions[global];
+    collect_referencing_functions(global, functions);
+    return functions;
+}
+
+bool DemandDrivenInputDependency::doesAddressEscape(llvm::GlobalVariable* global)
+{
+    auto pos = m_addressEscapes.find(global);
+    if (pos != m_addressEscapes.end()) {
+        return pos->second;
+    }
+    ValueSet visited;
+    const bool escapes = may_address_escape(global, visited);
+    m_addressEscapes[global] = escapes;
+    return escapes;
+}
+
+bool DemandDrivenInputDependency::isInputDependentByFullAnalysis(llvm::Instruction* I)
+{
+    auto* fullAnalysis = getFullAnalysis();
+    if (!fullAnalysis) {
+        return true;
+    }
+    return fullAnalysis->isInputDependent(I);
+}
+
+bool DemandDrivenInputDependency::isInputDependentByFullAnalysis(llvm::BasicBlock* block)
+{
+    auto* fullAnalysis = getFullAnalysis();
+    if (!fullAnalysis) {
+        return true;
+    }
+    return fullAnalysis->isInputDependent(block);
+}
+
+InputDependencyAnalysisInterface* DemandDrivenInputDependency::getFullAnalysis()
+{
+    ++m_fallbacksCount;
+    if (!m_fullAnalysis && m_fullAnalysisGetter) {
+        llvm::dbgs() << "Slice exceeds the limit. Running whole module analysis\n";
+        m_fullAnalysis = m_fullAnalysisGetter();
+    }
+    return m_fullAnalysis;
+}
+
+} // namespace input_dependency
+
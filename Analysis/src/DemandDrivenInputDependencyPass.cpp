@@ -0,0 +1,157 @@
+#include "input-dependency/Analysis/DemandDrivenInputDependencyPass.h"
+
+#include "input-dependency/Analysis/IndirectCallSitesAnalysis.h"
+#include "input-dependency/Analysis/InputDependencyAnalysis.h"
+#include "input-dependency/Analysis/InputDependencyAnalysisPass.h"
+
+#include "llvm/ADT/Triple.h"
+#include "llvm/Analysis/CallGraph.h"
+#include "llvm/Analysis/TargetLibraryInfo.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <utility>
+#include <vector>
+
+namespace input_dependency {
+
+static llvm::cl::opt<unsigned> slice_limit(
+    "input-dep-demand-slice-limit",
+    llvm::cl::desc("Maximal number of slice nodes of a demand driven query. Larger queries run whole module analysis. 0 means unlimited"),
+    llvm::cl::value_desc("number of nodes"),
+    llvm::cl::init(10000));
+
+static llvm::cl::list<std::string> queried_functions(
+    "input-dep-demand-functions",
+    llvm::cl::desc("Comma separated list of functions, which instructions are queried and printed"),
+    llvm::cl::value_desc("function names"),
+    llvm::cl::CommaSeparated);
+
+static llvm::cl::opt<bool> verify_demand(
+    "input-dep-demand-verify",
+    llvm::cl::desc("Compare demand driven input dependency of all instructions with the whole module analysis and print differences"),
+    llvm::cl::value_desc("boolean flag"));
+
+char DemandDrivenInputDependencyPass::ID = 0;
+
+void DemandDrivenInputDependencyPass::getAnalysisUsage(llvm::AnalysisUsage& AU) const
+{
+    // function level analyses are built by the pass, as queries come after runOnModule
+    AU.addRequired<IndirectCallSitesAnalysis>();
+    AU.addRequired<llvm::CallGraphWrapperPass>();
+    AU.setPreservesAll();
+}
+
+bool DemandDrivenInputDependencyPass::runOnModule(llvm::Module& M)
+{
+    configure_run();
+    m_module = &M;
+    m_callGraph = &getAnalysis<llvm::CallGraphWrapperPass>().getCallGraph();
+    m_indirectCallAnalysis = &getAnalysis<IndirectCallSitesAnalysis>();
+    m_TLII.reset(new llvm::TargetLibraryInfoImpl(llvm::Triple(M.getTargetTriple())));
+    m_functionAnalyses.clear();
+    m_fullAnalysis.reset();
+    m_demandAnalysis.reset(new DemandDrivenInputDependency(m_module));
+    m_demandAnalysis->setVirtualCallSiteAnalysisResult(&m_indirectCallAnalysis->getVirtualsAnalysisResult());
+    m_demandAnalysis->setIndirectCallSiteAnalysisResult(&m_indirectCallAnalysis->getIndirectsAnalysisResult());
+    m_demandAnalysis->setAliasAnalysisInfoGetter([this] (llvm::Function* F) { return &getFunctionAnalyses(F).AAR; });
+    m_demandAnalysis->setPostDominatorTreeGetter([this] (llvm::Function* F) { return &getFunctionAnalyses(F).PDT; });
+    m_demandAnalysis->setFullAnalysisGetter([this] () { return runFullAnalysis(); });
+    m_demandAnalysis->setSliceLimit(slice_limit);
+    printQueriedFunctions();
+    if (verify_demand) {
+        verifyWithFullAnalysis();
+    }
+    return false;
+}
+
+bool DemandDrivenInputDependencyPass::doFinalization(llvm::Module& M)
+{
+    if (m_demandAnalysis) {
+        llvm::dbgs() << "Demand driven input dependency: " << m_demandAnalysis->getQueriesCount() << " queries, "
+                     << m_demandAnalysis->getFallbacksCount() << " answered by whole module analysis, "
+                     << m_demandAnalysis->getMemoizedNodesCount() << " memoized nodes\n";
+    }
+    return false;
+}
+
+FunctionAnalyses& DemandDrivenInputDependencyPass::getFunctionAnalyses(llvm::Function* F)
+{
+    auto& analyses = m_functionAnalyses[F];
+    if (!analyses) {
+        analyses.reset(new FunctionAnalyses(*F, *m_TLII));
+    }
+    return *analyses;
+}
+
+InputDependencyAnalysisInterface* DemandDrivenInputDependencyPass::runFullAnalysis()
+{
+    if (m_fullAnalysis) {
+        return m_fullAnalysis.get();
+    }
+    auto* analysis = new InputDependencyAnalysis(m_module);
+    m_fullAnalysis.reset(analysis);
+    analysis->setCallGraph(m_callGraph);
+    analysis->setVirtualCallSiteAnalysisResult(&m_indirectCallAnalysis->getVirtualsAnalysisResult());
+    analysis->setIndirectCallSiteAnalysisResult(&m_indirectCallAnalysis->getIndirectsAnalysisResult());
+    analysis->setAliasAnalysisInfoGetter([this] (llvm::Function* F) { return &getFunctionAnalyses(F).AAR; });
+    analysis->setLoopInfoGetter([this] (llvm::Function* F) { return &getFunctionAnalyses(F).LI; });
+    analysis->setPostDominatorTreeGetter([this] (llvm::Function* F) { return &getFunctionAnalyses(F).PDT; });
+    analysis->setDominatorTreeGetter([this] (llvm::Function* F) { return &getFunctionAnalyses(F).DT; });
+    analysis->run();
+    return analysis;
+}
+
+void DemandDrivenInputDependencyPass::printQueriedFunctions()
+{
+    for (const auto& name : queried_functions) {
+        auto* F = m_module->getFunction(name);
+        if (!F || F->isDeclaration()) {
+            llvm::dbgs() << "No definition of function " << name << "\n";
+            continue;
+        }
+        llvm::dbgs() << "Function " << name << "\n";
+        for (auto& B : *F) {
+            for (auto& I : B) {
+                const char* dependency = m_demandAnalysis->isInputDependent(&I) ? "input dep" : "input indep";
+                llvm::dbgs() << "    " << dependency << ": " << I << "\n";
+            }
+        }
+    }
+}
+
+void DemandDrivenInputDependencyPass::verifyWithFullAnalysis()
+{
+    // all demand driven queries are answered before the whole module analysis runs
+    std::vector<std::pair<llvm::Instruction*, bool>> answers;
+    for (auto& F : *m_module) {
+        if (F.isDeclaration()) {
+            continue;
+        }
+        for (auto& B : F) {
+            for (auto& I : B) {
+                answers.push_back(std::make_pair(&I, m_demandAnalysis->isInputDependent(&I)));
+            }
+        }
+    }
+    auto* fullAnalysis = runFullAnalysis();
+    unsigned long differences = 0;
+    for (const auto& answer : answers) {
+        if (answer.second == fullAnalysis->isInputDependent(answer.first)) {
+            continue;
+        }
+        ++differences;
+        llvm::dbgs() << "Demand driven input " << (answer.second ? "dep" : "indep")
+                     << " differs from whole module analysis in function "
+                     << answer.first->getFunction()->getName() << ": " << *answer.first << "\n";
+    }
+    llvm::dbgs() << "Demand driven verification: " << answers.size() << " instructions, "
+                 << differences << " differences\n";
+}
+
+static llvm::RegisterPass<DemandDrivenInputDependencyPass> X("input-dep-demand","answers input dependency queries on demand");
+
+} // namespace input_dependency
@@ -1,5 +1,8 @@
 #include "input-dependency/Analysis/DependencyAnaliser.h"
 
+#include "input-dependency/Analysis/AnalysisBudget.h"
+#include "input-dependency/Analysis/AnalysisCostRecorder.h"
+#include "input-dependency/Analysis/AnalysisTiers.h"
 #include "input-dependency/Analysis/InputDepInstructionsRecorder.h"
 #include "input-dependency/Analysis/InputDepConfig.h"
 #include "input-dependency/Analysis/FunctionAnaliser.h"
@@ -437,6 +440,13 @@ void DependencyAnaliser::processCallInst(llvm::CallInst* callInst)
         updateLibFunctionCallInstructionDependencies(callInst, F, argDepMap);
     } else {
         updateFunctionCallSiteInfo(callInst, F);
+        if (AnalysisTiers::get().is_input_independent(F)) {
+            const auto& argumentValueGetter = [&callInst] (unsigned formalArgNo) -> llvm::Value* {
+                                                    return callInst->getArgOperand(formalArgNo);
+                                                };
+            updateInputIndepFunctionCallDependencies(callInst, F, argumentValueGetter);
+            return;
+        }
         if (m_FAG(F) != nullptr) {
             updateCallSiteOutArgDependencies(callInst, F);
         } else {
@@ -447,6 +457,7 @@ void DependencyAnaliser::processCallInst(llvm::CallInst* callInst)
         if (m_FAG(F) == nullptr || m_FAG(F)->isInputDepFunction()) {
             updateInstructionDependencies(callInst, DepInfo(DepInfo::INPUT_DEP));
             updateValueDependencies(callInst, DepInfo(DepInfo::INPUT_DEP), false);
+            updateGlobalsAfterFallbackFunction(F);
         } else {
             updateCallInstructionDependencies(callInst, F);
             updateGlobalsAfterFunctionCall(callInst, F);
@@ -486,11 +497,17 @@ void DependencyAnaliser::processInvokeInst(llvm::InvokeInst* invokeInst)
         updateLibFunctionInvokeInstructionDependencies(invokeInst, F, argDepMap);
     } else {
         updateFunctionInvokeSiteInfo(invokeInst, F);
-        // cyclic call
-        if (m_FAG(F) == nullptr || m_FAG(F)->isInputDepFunction()) {
+        if (AnalysisTiers::get().is_input_independent(F)) {
+            const auto& argumentValueGetter = [&invokeInst] (unsigned formalArgNo) -> llvm::Value* {
+                                                    return invokeInst->getArgOperand(formalArgNo);
+                                                };
+            updateInputIndepFunctionCallDependencies(invokeInst, F, argumentValueGetter);
+        } else if (m_FAG(F) == nullptr || m_FAG(F)->isInputDepFunction()) {
+            // cyclic call
             updateInvokeInputDependentOutArgDependencies(invokeInst);
             updateInstructionDependencies(invokeInst, DepInfo(DepInfo::INPUT_DEP));
             updateValueDependencies(invokeInst, DepInfo(DepInfo::INPUT_DEP), false);
+            updateGlobalsAfterFallbackFunction(F);
         } else {
             updateInvokeSiteOutArgDependencies(invokeInst, F);
             updateInvokeInstructionDependencies(invokeInst, F);
@@ -512,6 +529,7 @@ void DependencyAnaliser::processCallSiteWithMultipleTargets(llvm::CallInst* call
             updateInstructionDependencies(callInst, DepInfo(DepInfo::INPUT_DEP));
             updateValueDependencies(callInst, DepInfo(DepInfo::INPUT_DEP), false);
             InputDepInstructionsRecorder::get().record(callInst);
+            updateGlobalsAfterFallbackFunction(F);
             // update globals??? May result to inaccuracies 
         } else {
             //llvm::dbgs() << "Analysis results available for indirect call target: " << F->getName() << "\n";
@@ -531,6 +549,7 @@ void DependencyAnaliser::processInvokeSiteWithMultipleTargets(llvm::InvokeInst*
             updateInstructionDependencies(invokeInst, DepInfo(DepInfo::INPUT_DEP));
             updateValueDependencies(invokeInst, DepInfo(DepInfo::INPUT_DEP), false);
             InputDepInstructionsRecorder::get().record(invokeInst);
+            updateGlobalsAfterFallbackFunction(F);
             // update globals??? May result to inaccuracies 
         } else {
             updateInvokeSiteOutArgDependencies(invokeInst, F);
@@ -573,6 +592,7 @@ ArgumentSet DependencyAnaliser::isInput(llvm::Value* val) const
     ArgumentSet set;
     for (auto& arg : m_inputs) {
         if (auto* argVal = llvm::dyn_cast<llvm::Value>(arg)) {
+            AnalysisCostRecorder::get().count_alias_query();
             auto aliasResult = m_AAR.alias(argVal, val);
             // TODO: check for MustAlias for all values not only global
             if (llvm::dyn_cast<llvm::GlobalVariable>(val)) {
@@ -591,7 +611,8 @@ void DependencyAnaliser::updateCallSiteOutArgDependencies(llvm::CallInst* callIn
 {
     auto pos = m_functionCallInfo.find(F);
     assert(pos != m_functionCallInfo.end());
-    const auto& callArgDeps = pos->second.getArgumentDependenciesForCall(callInst);
+    const auto& callDepInfo = pos->second;
+    const auto& callArgDeps = callDepInfo.getArgumentDependenciesForCall(callInst);
 
     const auto& argumentValueGetter = [&callInst] (unsigned formalArgNo) -> llvm::Value* {
                                             if (formalArgNo >= callInst->getNumArgOperands()) {
@@ -606,7 +627,8 @@ void DependencyAnaliser::updateInvokeSiteOutArgDependencies(llvm::InvokeInst* in
 {
     auto pos = m_functionCallInfo.find(F);
     assert(pos != m_functionCallInfo.end());
-    const auto& invokeArgDeps = pos->second.getArgumentDependenciesForInvoke(invokeInst);
+    const auto& callDepInfo = pos->second;
+    const auto& invokeArgDeps = callDepInfo.getArgumentDependenciesForInvoke(invokeInst);
 
     const auto& argumentValueGetter = [&invokeInst] (unsigned formalArgNo) -> llvm::Value* {
                                             if (formalArgNo >= invokeInst->getNumArgOperands()) {
@@ -640,7 +662,8 @@ void DependencyAnaliser::updateCallInstructionDependencies(llvm::CallInst* callI
     }
     auto pos = m_functionCallInfo.find(F);
     assert(pos != m_functionCallInfo.end());
-    resolveReturnedValueDependencies(retDeps, pos->second.getArgumentDependenciesForCall(callInst));
+    const auto& callDepInfo = pos->second;
+    resolveReturnedValueDependencies(retDeps, callDepInfo.getArgumentDependenciesForCall(callInst));
     updateInstructionDependencies(callInst, retDeps.getValueDep());
     updateValueDependencies(callInst, retDeps, false);
 }
@@ -666,7 +689,8 @@ void DependencyAnaliser::updateInvokeInstructionDependencies(llvm::InvokeInst* i
     }
     auto pos = m_functionCallInfo.find(F);
     assert(pos != m_functionCallInfo.end());
-    resolveReturnedValueDependencies(retDeps, pos->second.getArgumentDependenciesForInvoke(invokeInst));
+    const auto& callDepInfo = pos->second;
+    resolveReturnedValueDependencies(retDeps, callDepInfo.getArgumentDependenciesForInvoke(invokeInst));
     updateInstructionDependencies(invokeInst, retDeps.getValueDep());
     updateValueDependencies(invokeInst, retDeps, false);
 }
@@ -676,8 +700,9 @@ void DependencyAnaliser::updateGlobalsAfterFunctionCall(llvm::CallInst* callInst
     assert(F != nullptr);
     auto pos = m_functionCallInfo.find(F);
     assert(pos != m_functionCallInfo.end());
+    const auto& callDepInfo = pos->second;
     bool is_recurs = (F == callInst->getParent()->getParent());
-    updateGlobalsAfterFunctionExecution(F, pos->second.getArgumentDependenciesForCall(callInst), is_recurs);
+    updateGlobalsAfterFunctionExecution(F, callDepInfo.getArgumentDependenciesForCall(callInst), is_recurs);
 }
 
 void DependencyAnaliser::updateGlobalsAfterFunctionInvoke(llvm::InvokeInst* invokeInst, llvm::Function* F)
@@ -685,8 +710,9 @@ void DependencyAnaliser::updateGlobalsAfterFunctionInvoke(llvm::InvokeInst* invo
     assert(F != nullptr);
     auto pos = m_functionCallInfo.find(F);
     assert(pos != m_functionCallInfo.end());
+    const auto& callDepInfo = pos->second;
     bool is_recurs = (F == invokeInst->getParent()->getParent());
-    updateGlobalsAfterFunctionExecution(F, pos->second.getArgumentDependenciesForInvoke(invokeInst), is_recurs);
+    updateGlobalsAfterFunctionExecution(F, callDepInfo.getArgumentDependenciesForInvoke(invokeInst), is_recurs);
 }
 
 void DependencyAnaliser::updateGlobalsAfterFunctionExecution(llvm::Function* F,
@@ -697,10 +723,10 @@ void DependencyAnaliser::updateGlobalsAfterFunctionExecution(llvm::Function* F,
     assert(FA);
 
     const auto& refGlobals = FA->getReferencedGlobals();
-    m_referencedGlobals.insert(refGlobals.begin(), refGlobals.end());
+    m_referencedGlobals.insert(refGlobals);
 
     const auto& modGlobals = FA->getModifiedGlobals();
-    m_modifiedGlobals.insert(modGlobals.begin(), modGlobals.end());
+    m_modifiedGlobals.insert(modGlobals);
 
     for (const auto& global : modGlobals) {
         ValueDepInfo depInfo(global->getType());
@@ -727,6 +753,20 @@ void DependencyAnaliser::updateGlobalsAfterFunctionExecution(llvm::Function* F,
     }
 }
 
+void DependencyAnaliser::updateGlobalsAfterFallbackFunction(llvm::Function* F)
+{
+    // F exceeded its analysis budget, globals it may modify become input dependent
+    const auto* summary = AnalysisBudget::get().get_fallback_summary(F);
+    if (!summary) {
+        return;
+    }
+    m_referencedGlobals.insert(summary->referencedGlobals);
+    m_modifiedGlobals.insert(summary->modifiedGlobals);
+    for (const auto& global : summary->modifiedGlobals) {
+        updateValueDependencies(global, ValueDepInfo(global->getType(), DepInfo(DepInfo::INPUT_DEP)), true);
+    }
+}
+
 void DependencyAnaliser::updateCallInputDependentOutArgDependencies(llvm::CallInst* callInst)
 {
     auto FType = callInst->getFunctionType();
@@ -753,6 +793,41 @@ void DependencyAnaliser::updateFunctionInputDepOutArgDependencies(llvm::Function
     }
 }
 
+void DependencyAnaliser::updateInputIndepFunctionCallDependencies(llvm::Instruction* callInstr,
+                                                                  llvm::Function* F,
+                                                                  const ArgumentValueGetter& argumentValueGetter)
+{
+    // F does not use its arguments. As for unmodified arguments of analysed functions,
+    // out argument depends on the argument itself, resolved to dependencies of the actual argument at call site
+    auto pos = m_functionCallInfo.find(F);
+    assert(pos != m_functionCallInfo.end());
+    const auto& callDepInfo = pos->second;
+    auto* callInst = llvm::dyn_cast<llvm::CallInst>(callInstr);
+    const auto& callArgDeps = callInst ? callDepInfo.getArgumentDependenciesForCall(callInst)
+                                       : callDepInfo.getArgumentDependenciesForInvoke(llvm::cast<llvm::InvokeInst>(callInstr));
+    for (auto& arg : F->args()) {
+        if (!arg.getType()->isPointerTy()) {
+            continue;
+        }
+        llvm::Value* actualArg = argumentValueGetter(arg.getArgNo());
+        ValueDepInfo argDeps(arg.getType(), DepInfo(DepInfo::INPUT_ARGDEP, ArgumentSet{&arg}));
+        resolveReturnedValueDependencies(argDeps, callArgDeps);
+        updateOutArgumentDependencies(actualArg, argDeps);
+        if (auto* instr = llvm::dyn_cast<llvm::Instruction>(actualArg)) {
+            updateRefAliasesDependencies(instr, argDeps);
+        }
+    }
+    if (InputDepConfig::get().is_input_dep_function(F)) {
+        updateInstructionDependencies(callInstr, DepInfo(DepInfo::INPUT_DEP));
+        updateValueDependencies(callInstr, DepInfo(DepInfo::INPUT_DEP), false);
+        return;
+    }
+    updateInstructionDependencies(callInstr, DepInfo(DepInfo::INPUT_INDEP));
+    if (!F->doesNotReturn()) {
+        updateValueDependencies(callInstr, ValueDepInfo(callInstr->getType(), DepInfo(DepInfo::INPUT_INDEP)), false);
+    }
+}
+
 void DependencyAnaliser::updateOutArgumentDependencies(llvm::Value* val, const ValueDepInfo& depInfo)
 {
     // val is the value passed as argument
@@ -784,6 +859,17 @@ void DependencyAnaliser::updateOutArgumentDependencies(llvm::Value* val, const V
     }
 }
 
+void DependencyAnaliser::markInputDependentFunction(llvm::Function* F)
+{
+    const FunctionAnalysisGetter FAG = m_FAG;
+    AnalysisBudget::get().run_side_effect([FAG, F] () {
+        if (auto* FA = FAG(F)) {
+            FA->setIsInputDepFunction(true);
+        }
+        InputDepConfig::get().add_input_dep_function(F);
+    });
+}
+
 void DependencyAnaliser::updateLibFunctionCallInstOutArgDependencies(llvm::CallInst* callInst,
                                                                      llvm::Function* F,
                                                                      const DependencyAnaliser::ArgumentDependenciesMap& argDepMap)
@@ -930,7 +1016,14 @@ void DependencyAnaliser::finalizeValues(const GlobalVariableDependencyMap& globa
         if (!info.isValueDep()) {
             continue;
         }
-        finalizeValueDependencies(globalDeps, info);
+        if (info.isInputDep()) {
+            // value dependencies can not change input dep, nor is global dependence of values reported
+            info.saturate();
+            info.getValueDependencies().clear();
+            AnalysisCostRecorder::get().count_saturated_finalization();
+        } else {
+            finalizeValueDependencies(globalDeps, info);
+        }
         for (auto& el_info : valueDep.second.getCompositeValueDeps()) {
             if (!el_info.isValueDep()) {
                 continue;
@@ -1029,10 +1122,10 @@ DependencyAnaliser::GlobalVariableDependencyMap DependencyAnaliser::gatherGlobal
     }
     assert(FAG);
     auto& callRefGlobals = FAG->getReferencedGlobals();
+    m_referencedGlobals.insert(callRefGlobals);
     GlobalVariableDependencyMap globalsDepMap;
-    for (auto& global : callRefGlobals) {
+    for (auto* global : callRefGlobals) {
         llvm::Value* globalVal = llvm::dyn_cast<llvm::Value>(global);
-        m_referencedGlobals.insert(global);
         assert(globalVal != nullptr);
         auto depInfo = getValueDependencies(globalVal);
         if (!depInfo.isDefined()) {
@@ -1158,22 +1251,14 @@ void DependencyAnaliser::updateLibFunctionCallOutArgDependencies(llvm::Function*
         if (libFInfo.isCallbackArgument(&arg)) {
             if (auto* arg_F = llvm::dyn_cast<llvm::Function>(actualArg)) {
                 llvm::dbgs() << "Set input dependency of a function " << arg_F->getName() << "\n";
-                auto arg_FA = m_FAG(arg_F);
-                if (arg_FA) {
-                    arg_FA->setIsInputDepFunction(true);
-                }
-                InputDepConfig::get().add_input_dep_function(arg_F);
+                markInputDependentFunction(arg_F);
                 auto pos = m_functionCallInfo.insert(std::make_pair(arg_F, FunctionCallDepInfo(*arg_F)));
                 pos.first->second.setIsCallback(true);
                 m_calledFunctions.insert(arg_F);
             } else if (auto* arg_F = getCalledFunctionFromCalledValue(actualArg)) {
                 // TODO: remove code duplication
                 llvm::dbgs() << "Set input dependency of a function " << arg_F->getName() << "\n";
-                auto arg_FA = m_FAG(arg_F);
-                if (arg_FA) {
-                    arg_FA->setIsInputDepFunction(true);
-                }
-                InputDepConfig::get().add_input_dep_function(arg_F);
+                markInputDependentFunction(arg_F);
                 auto pos = m_functionCallInfo.insert(std::make_pair(arg_F, FunctionCallDepInfo(*arg_F)));
                 pos.first->second.setIsCallback(true);
                 m_calledFunctions.insert(arg_F);
@@ -1324,6 +1409,19 @@ void DependencyAnaliser::finalizeInstructions(const GlobalVariableDependencyMap&
             ++instrpos;
             continue;
         }
+        if (instrpos->second.isInputDep()) {
+            // global dependencies can not change input dep, global dependence is reported as for other instructions
+            auto& valueDependencies = instrpos->second.getValueDependencies();
+            if (std::any_of(valueDependencies.begin(), valueDependencies.end(),
+                            [] (llvm::Value* value) { return llvm::isa<llvm::GlobalVariable>(value); })) {
+                m_globalDependentInstrs.insert(instrpos->first);
+            }
+            instrpos->second.saturate();
+            valueDependencies.clear();
+            AnalysisCostRecorder::get().count_saturated_finalization();
+            ++instrpos;
+            continue;
+        }
         if (finalizeValueDependencies(globalDeps, instrpos->second)) {
             m_globalDependentInstrs.insert(instrpos->first);
         }
@@ -0,0 +1,294 @@
+#include "input-dependency/Analysis/FrozenFunctionAnalysisResult.h"
+
+#include "input-dependency/Analysis/MemoryAccounting.h"
+
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Function.h"
+
+namespace input_dependency {
+
+FrozenFunctionAnalysisResult::FrozenFunctionAnalysisResult(FunctionInputDependencyResultInterface& result)
+    : m_F(result.getFunction())
+    , m_is_inputDep(result.isInputDepFunction())
+    , m_is_extracted(result.isExtractedFunction())
+    , m_calledFunctions(result.getCallSitesData())
+    , m_inputDepBlocksCount(result.get_input_dep_blocks_count())
+    , m_inputIndepBlocksCount(result.get_input_indep_blocks_count())
+    , m_unreachableBlocksCount(result.get_unreachable_blocks_count())
+    , m_unreachableInstructionsCount(result.get_unreachable_instructions_count())
+    , m_inputDepCount(result.get_input_dep_count())
+    , m_inputIndepCount(result.get_input_indep_count())
+    , m_dataIndepCount(result.get_data_indep_count())
+    , m_inputUnknownsCount(result.get_input_unknowns_count())
+{
+    m_blockFlags.reserve(m_F->getBasicBlockList().size());
+    for (auto& B : *m_F) {
+        uint8_t blockFlags = 0;
+        if (result.isInputDependentBlock(&B)) {
+            blockFlags |= INPUT_DEP_BLOCK;
+        }
+        if (result.isArgumentDependent(&B)) {
+            blockFlags |= ARGUMENT_DEP_BLOCK;
+        }
+        m_blockFlags[&B] = blockFlags;
+        for (auto& I : B) {
+            uint8_t flags = 0;
+            if (result.isInputDependent(&I)) {
+                flags |= INPUT_DEP;
+            }
+            if (result.isInputIndependent(&I)) {
+                flags |= INPUT_INDEP;
+            }
+            if (result.isDataDependent(&I)) {
+                flags |= DATA_DEP;
+            }
+            if (result.isArgumentDependent(&I)) {
+                flags |= ARGUMENT_DEP;
+            }
+            if (result.isGlobalDependent(&I)) {
+                flags |= GLOBAL_DEP;
+            }
+            m_instructionFlags[&I] = flags;
+        }
+    }
+    for (auto* calledF : m_calledFunctions) {
+        m_functionCallDepInfo.insert(std::make_pair(calledF, result.getFunctionCallDepInfo(calledF)));
+    }
+}
+
+llvm::Function* FrozenFunctionAnalysisResult::getFunction()
+{
+    return m_F;
+}
+
+const llvm::Function* FrozenFunctionAnalysisResult::getFunction() const
+{
+    return m_F;
+}
+
+bool FrozenFunctionAnalysisResult::isInputDepFunction() const
+{
+    return m_is_inputDep;
+}
+
+void FrozenFunctionAnalysisResult::setIsInputDepFunction(bool isInputDep)
+{
+    m_is_inputDep = isInputDep;
+}
+
+bool FrozenFunctionAnalysisResult::isExtractedFunction() const
+{
+    return m_is_extracted;
+}
+
+void FrozenFunctionAnalysisResult::setIsExtractedFunction(bool isExtracted)
+{
+    m_is_extracted = isExtracted;
+}
+
+bool FrozenFunctionAnalysisResult::isInputDependent(llvm::Instruction* instr) const
+{
+    return hasInstructionFlag(instr, INPUT_DEP, true);
+}
+
+bool FrozenFunctionAnalysisResult::isInputDependent(const llvm::Instruction* instr) const
+{
+    return hasInstructionFlag(instr, INPUT_DEP, true);
+}
+
+bool FrozenFunctionAnalysisResult::isInputIndependent(llvm::Instruction* instr) const
+{
+    return hasInstructionFlag(instr, INPUT_INDEP, false);
+}
+
+bool FrozenFunctionAnalysisResult::isInputIndependent(const llvm::Instruction* instr) const
+{
+    return hasInstructionFlag(instr, INPUT_INDEP, false);
+}
+
+bool FrozenFunctionAnalysisResult::isInputDependentBlock(llvm::BasicBlock* block) const
+{
+    return hasBlockFlag(block, INPUT_DEP_BLOCK, true);
+}
+
+bool FrozenFunctionAnalysisResult::isControlDependent(llvm::Instruction* I) const
+{
+    return m_is_inputDep || isInputDependentBlock(I->getParent());
+}
+
+bool FrozenFunctionAnalysisResult::isDataDependent(llvm::Instruction* I) const
+{
+    return hasInstructionFlag(I, DATA_DEP, true);
+}
+
+bool FrozenFunctionAnalysisResult::isArgumentDependent(llvm::Instruction* I) const
+{
+    return hasInstructionFlag(I, ARGUMENT_DEP, false);
+}
+
+bool FrozenFunctionAnalysisResult::isArgumentDependent(llvm::BasicBlock* block) const
+{
+    return hasBlockFlag(block, ARGUMENT_DEP_BLOCK, false);
+}
+
+bool FrozenFunctionAnalysisResult::isGlobalDependent(llvm::Instruction* I) const
+{
+    return hasInstructionFlag(I, GLOBAL_DEP, false);
+}
+
+InstructionClassification FrozenFunctionAnalysisResult::getInstructionClassification()
+{
+    unsigned count = 0;
+    for (auto& B : *m_F) {
+        count += B.size();
+    }
+    InstructionClassification classification(count);
+    unsigned index = 0;
+    for (auto& B : *m_F) {
+        const bool controlDep = m_is_inputDep || isInputDependentBlock(&B);
+        for (auto& I : B) {
+            auto pos = m_instructionFlags.find(&I);
+            // instructions created after freezing are input dependent
+            const uint8_t flags = pos == m_instructionFlags.end() ? (INPUT_DEP | DATA_DEP) : pos->second;
+            if (flags & INPUT_DEP) {
+                classification.set(InstructionClassification::INPUT_DEP, index);
+            }
+            if (flags & INPUT_INDEP) {
+                classification.set(InstructionClassification::INPUT_INDEP, index);
+            }
+            if (controlDep) {
+                classification.set(InstructionClassification::CONTROL_DEP, index);
+            }
+            if (flags & DATA_DEP) {
+                classification.set(InstructionClassification::DATA_DEP, index);
+            }
+            if (flags & ARGUMENT_DEP) {
+                classification.set(InstructionClassification::ARGUMENT_DEP, index);
+            }
+            if (flags & GLOBAL_DEP) {
+                classification.set(InstructionClassification::GLOBAL_DEP, index);
+            }
+            ++index;
+        }
+    }
+    return classification;
+}
+
+FunctionSet FrozenFunctionAnalysisResult::getCallSitesData() const
+{
+    return m_calledFunctions;
+}
+
+FunctionCallDepInfo FrozenFunctionAnalysisResult::getFunctionCallDepInfo(llvm::Function* F) const
+{
+    auto pos = m_functionCallDepInfo.find(F);
+    if (pos == m_functionCallDepInfo.end()) {
+        return FunctionCallDepInfo();
+    }
+    return pos->second;
+}
+
+bool FrozenFunctionAnalysisResult::changeFunctionCall(const llvm::Instruction* callInstr,
+                                                      llvm::Function* oldF,
+                                                      llvm::Function* newF)
+{
+    llvm::Instruction* instr = const_cast<llvm::Instruction*>(callInstr);
+    if (auto call = llvm::dyn_cast<llvm::CallInst>(instr)) {
+        call->setCalledFunction(newF);
+    } else if (auto invoke = llvm::dyn_cast<llvm::InvokeInst>(instr)) {
+        invoke->setCalledFunction(newF);
+    } else {
+        assert(false);
+    }
+    auto callDepInfo_pos = m_functionCallDepInfo.find(oldF);
+    if (callDepInfo_pos == m_functionCallDepInfo.end()) {
+        return false;
+    }
+    // references to map elements stay valid on insertion, iterators may not
+    auto& callDepInfo = callDepInfo_pos->second;
+    auto newCallDepInfo_pos = m_functionCallDepInfo.find(newF);
+    if (newCallDepInfo_pos == m_functionCallDepInfo.end()) {
+        newCallDepInfo_pos = m_functionCallDepInfo.insert(std::make_pair(newF, FunctionCallDepInfo(*newF))).first;
+    }
+    newCallDepInfo_pos->second.addCall(instr, callDepInfo.getArgumentsDependencies(instr));
+    newCallDepInfo_pos->second.addCall(instr, callDepInfo.getGlobalsDependencies(instr));
+    callDepInfo.removeCall(instr);
+    if (callDepInfo.empty()) {
+        m_functionCallDepInfo.erase(oldF);
+        m_calledFunctions.erase(oldF);
+    }
+    m_calledFunctions.insert(newF);
+    return true;
+}
+
+long unsigned FrozenFunctionAnalysisResult::get_input_dep_blocks_count() const
+{
+    return m_inputDepBlocksCount;
+}
+
+long unsigned FrozenFunctionAnalysisResult::get_input_indep_blocks_count() const
+{
+    return m_inputIndepBlocksCount;
+}
+
+long unsigned FrozenFunctionAnalysisResult::get_unreachable_blocks_count() const
+{
+    return m_unreachableBlocksCount;
+}
+
+long unsigned FrozenFunctionAnalysisResult::get_unreachable_instructions_count() const
+{
+    return m_unreachableInstructionsCount;
+}
+
+long unsigned FrozenFunctionAnalysisResult::get_input_dep_count() const
+{
+    return m_inputDepCount;
+}
+
+long unsigned FrozenFunctionAnalysisResult::get_input_indep_count() const
+{
+    return m_inputIndepCount;
+}
+
+long unsigned FrozenFunctionAnalysisResult::get_data_indep_count() const
+{
+    return m_dataIndepCount;
+}
+
+long unsigned FrozenFunctionAnalysisResult::get_input_unknowns_count() const
+{
+    return m_inputUnknownsCount;
+}
+
+void FrozenFunctionAnalysisResult::accountMemory(MemoryUsage& usage) const
+{
+    usage.result_sets += m_instructionFlags.getMemorySize() + m_blockFlags.getMemorySize();
+    usage.addResultSet(m_calledFunctions);
+    usage.call_dep_info += MemoryUsage::container_bytes(m_functionCallDepInfo);
+    for (const auto& item : m_functionCallDepInfo) {
+        usage.addFunctionCallInfo(item.second);
+    }
+}
+
+bool FrozenFunctionAnalysisResult::hasInstructionFlag(const llvm::Instruction* I, uint8_t flag, bool unknown) const
+{
+    auto pos = m_instructionFlags.find(I);
+    if (pos == m_instructionFlags.end()) {
+        return unknown;
+    }
+    return pos->second & flag;
+}
+
+bool FrozenFunctionAnalysisResult::hasBlockFlag(const llvm::BasicBlock* B, uint8_t flag, bool unknown) const
+{
+    auto pos = m_blockFlags.find(B);
+    if (pos == m_blockFlags.end()) {
+        return unknown;
+    }
+    return pos->second & flag;
+}
+
+} // namespace input_dependency
+
@@ -1,16 +1,21 @@
 #include "input-dependency/Analysis/FunctionAnaliser.h"
 
+#include "input-dependency/Analysis/AnalysisCostRecorder.h"
+#include "input-dependency/Analysis/AnalysisTiers.h"
 #include "input-dependency/Analysis/BasicBlockAnalysisResult.h"
 #include "input-dependency/Analysis/DependencyAnalysisResult.h"
 #include "input-dependency/Analysis/DependencyAnaliser.h"
+#include "input-dependency/Analysis/InputDependentBasicBlockAnaliser.h"
 #include "input-dependency/Analysis/LoopAnalysisResult.h"
 #include "input-dependency/Analysis/NonDeterministicBasicBlockAnaliser.h"
 #include "input-dependency/Analysis/IndirectCallSitesAnalysis.h"
 #include "input-dependency/Analysis/BasicBlocksUtils.h"
 #include "input-dependency/Analysis/Utils.h"
 #include "input-dependency/Analysis/ClonedFunctionAnalysisResult.h"
-#include "input-dependency/Analysis/CFGTraversalPath.h"
+#include "input-dependency/Analysis/CFGTraversalOrder.h"
 #include "input-dependency/Analysis/InputDepConfig.h"
+#include "input-dependency/Analysis/MemoryAccounting.h"
+#include "input-dependency/Analysis/PhaseTimer.h"
 #include "input-dependency/Analysis/exception.h"
 
 #include "llvm/ADT/SCCIterator.h"
@@ -28,7 +33,6 @@
 #include "llvm/Transforms/Utils/Cloning.h"
 #include "llvm/Transforms/Utils/ValueMapper.h"
 
-#include <chrono>
 #include <forward_list>
 #include <list>
 
@@ -89,6 +93,39 @@ llvm::Argument* get_mapped_argument(llvm::Argument* arg,
     return mapped_arg;
 }
 
+bool equal_value_deps(const ValueDepInfo& info1, const ValueDepInfo& info2)
+{
+    if (info1.getValueDep() != info2.getValueDep()) {
+        return false;
+    }
+    const auto& elements1 = info1.getCompositeValueDeps();
+    const auto& elements2 = info2.getCompositeValueDeps();
+    if (elements1.size() != elements2.size()) {
+        return false;
+    }
+    for (unsigned i = 0; i < elements1.size(); ++i) {
+        if (!equal_value_deps(elements1[i], elements2[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename DependenciesMap>
+bool equal_dependencies(const DependenciesMap& deps1, const DependenciesMap& deps2)
+{
+    if (deps1.size() != deps2.size()) {
+        return false;
+    }
+    for (const auto& item : deps1) {
+        auto pos = deps2.find(item.first);
+        if (pos == deps2.end() || !equal_value_deps(item.second, pos->second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 }
 
 class FunctionAnaliser::Impl
@@ -215,6 +252,7 @@ public:
     ValueDepInfo getDependencyInfoFromBlock(llvm::Value* val, llvm::BasicBlock* block) const;
     DepInfo getBlockDependencyInfo(llvm::BasicBlock* block) const;
     // Returns collected data for function calls in this function
+    bool hasCallArgumentInfo(llvm::Function* F) const;
     const DependencyAnaliser::ArgumentDependenciesMap& getCallArgumentInfo(llvm::Function* F) const;
     FunctionCallDepInfo getFunctionCallDepInfo(llvm::Function* F) const;
     bool changeFunctionCall(llvm::Instruction* callInstr, llvm::Function* oldF, llvm::Function* newF);
@@ -235,6 +273,7 @@ public:
     long unsigned get_input_unknowns_count() const;
     FunctionInputDependencyResultInterface* cloneForArguments(const DependencyAnaliser::ArgumentDependenciesMap& inputDepArgs);
     void dump() const;
+    void accountMemory(MemoryUsage& usage) const;
 
 private:
     using BlocksInTraversalOrder = std::list<std::pair<llvm::BasicBlock*, llvm::Loop*>>;
@@ -242,6 +281,15 @@ private:
     DependencyAnalysisResultT createBasicBlockAnalysisResult(llvm::BasicBlock* B,
                                                              const DepInfo& depInfo);
     LoopAnalysisResult* createLoopAnalysisResult(const DepInfo& depInfo, llvm::Loop* loop);
+    void collectUnreachableBlocks();
+    void analyzeNode(llvm::BasicBlock* bb, llvm::Loop* loop, bool is_input_dep = false);
+    void analyzeIrreducibleRegion(const CFGTraversalOrder::LevelNodes& nodes,
+                                  unsigned begin, unsigned end);
+    bool isRegionChanged(const CFGTraversalOrder::LevelNodes& nodes,
+                         unsigned begin, unsigned end,
+                         std::vector<DependencyAnaliser::ValueDependencies>& values,
+                         std::vector<DependencyAnaliser::ArgumentDependenciesMap>& out_args,
+                         std::vector<DepInfo>& terminator_deps) const;
     DepInfo getBasicBlockPredecessorInstructionsDeps(llvm::BasicBlock* B) const;
 
     void updateFunctionInputDependencies();
@@ -290,8 +338,8 @@ private:
     bool m_is_extracted;
 
     std::unordered_map<llvm::BasicBlock*, DependencyAnalysisResultT> m_BBAnalysisResults;
-    // LoopInfo will be invalidated after analisis, instead of keeping copy of it, keep this map.
-    std::unordered_map<llvm::BasicBlock*, llvm::BasicBlock*> m_loopBlocks;
+    // LoopInfo will be invalidated after analisis, traversal order keeps loop headers of blocks.
+    std::shared_ptr<CFGTraversalOrder> m_traversalOrder;
     // last block of a function is not always the exit block, as it may be unreachable from entry
     llvm::BasicBlock* m_exit_block;
 }; // class FunctionAnaliser::Impl
@@ -455,6 +503,19 @@ DepInfo FunctionAnaliser::Impl::getBlockDependencyInfo(llvm::BasicBlock* block)
     return analysisRes->getBlockDependencies();
 }
 
+bool FunctionAnaliser::Impl::hasCallArgumentInfo(llvm::Function* F) const
+{
+    if (m_calledFunctionsInfo.find(F) != m_calledFunctionsInfo.end()) {
+        return true;
+    }
+    for (const auto& B : m_BBAnalysisResults) {
+        if (B.second->hasFunctionCallInfo(F)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 const DependencyAnaliser::ArgumentDependenciesMap&
 FunctionAnaliser::Impl::getCallArgumentInfo(llvm::Function* F) const
 {
@@ -529,46 +590,46 @@ const GlobalsSet& FunctionAnaliser::Impl::getModifiedGlobals() const
 
 void FunctionAnaliser::Impl::analyze()
 {
-    typedef std::chrono::high_resolution_clock Clock;
-    auto tic = Clock::now();
+    PhaseTimer timer("function analysis", m_F);
+    AnalysisCostRecorder::Scope cost_scope(m_F);
     collectArguments();
 
-    CFGTraversalPathCreator traversalPath(*m_F);
-    traversalPath.setLoopInfo(m_LI);
-    traversalPath.setDomTree(m_domTree);
-    traversalPath.construct(CFGTraversalPathCreator::CFG);
-    const auto& blocks_in_traversal_order = traversalPath.getBlocksInOrder();
-    m_loopBlocks= traversalPath.getBlocksLoops();
-    llvm::BasicBlock* bb;
-    for (auto& block : blocks_in_traversal_order) {
-        bb = block.first;
-        //llvm::dbgs() << "process block: " << bb->getName() << "\n";
-        const auto& depInfo = getBasicBlockPredecessorInstructionsDeps(bb);
-        if (block.second) {
-            m_BBAnalysisResults[bb].reset(createLoopAnalysisResult(depInfo, block.second));
+    m_traversalOrder.reset(new CFGTraversalOrder(*m_F, *m_LI));
+    collectUnreachableBlocks();
+    const auto& blocks_in_traversal_order = m_traversalOrder->getLevelNodes(nullptr);
+    llvm::BasicBlock* bb = nullptr;
+    llvm::BasicBlock* return_block = nullptr;
+    unsigned idx = 0;
+    while (idx < blocks_in_traversal_order.size()) {
+        bb = blocks_in_traversal_order[idx].first;
+        int region = m_traversalOrder->getIrreducibleRegion(bb);
+        if (region == -1) {
+            analyzeNode(bb, blocks_in_traversal_order[idx].second);
+            ++idx;
         } else {
-            m_BBAnalysisResults[bb] = createBasicBlockAnalysisResult(bb, depInfo);
+            // nodes of irreducible region are contiguous in traversal order
+            unsigned region_end = idx + 1;
+            while (region_end < blocks_in_traversal_order.size()
+                    && m_traversalOrder->getIrreducibleRegion(blocks_in_traversal_order[region_end].first) == region) {
+                ++region_end;
+            }
+            analyzeIrreducibleRegion(blocks_in_traversal_order, idx, region_end);
+            idx = region_end;
+            bb = blocks_in_traversal_order[idx - 1].first;
+        }
+        if (llvm::isa<llvm::ReturnInst>(bb->getTerminator())) {
+            return_block = bb;
         }
-        m_BBAnalysisResults[bb]->setInitialValueDependencies(getBasicBlockPredecessorsDependencies(bb));
-        m_BBAnalysisResults[bb]->setOutArguments(getBasicBlockPredecessorsArguments(bb));
-        m_BBAnalysisResults[bb]->setCallbackFunctions(getBasicBlockPredecessorsCallbackFunctions(bb));
-        m_BBAnalysisResults[bb]->gatherResults();
-
-        updateValueDependencies(bb);
-        updateCalledFunctionsList(m_BBAnalysisResults[bb]);
-        updateReturnValueDependencies(bb);
-        updateOutArgumentDependencies(bb);
     }
-    m_exit_block = bb;
+    // reverse post order may end with a non returning block
+    m_exit_block = return_block ? return_block : bb;
     m_inputs.clear();
-    auto toc = Clock::now();
-    if (getenv("INPUT_DEP_TIME")) {
-        llvm::dbgs() << "Input dep elapsed time " << std::chrono::duration_cast<std::chrono::nanoseconds>(toc - tic).count() << "\n";
-    }
 }
 
 void FunctionAnaliser::Impl::finalizeArguments(const ArgumentDependenciesMap& dependentArgs)
 {
+    PhaseTimer timer("finalize arguments", m_F);
+    AnalysisCostRecorder::Scope cost_scope(m_F);
     //llvm::dbgs() << "finalizing with dependencies\n";
     //for (const auto& arg : dependentArgs) {
     //    llvm::dbgs() << *arg.first << "     " << arg.second.getDependencyName() << "\n";
@@ -587,6 +648,8 @@ void FunctionAnaliser::Impl::finalizeArguments(const ArgumentDependenciesMap& de
 
 void FunctionAnaliser::Impl::finalizeGlobals(const GlobalVariableDependencyMap& globalsDeps)
 {
+    PhaseTimer timer("finalize globals", m_F);
+    AnalysisCostRecorder::Scope cost_scope(m_F);
     for (auto& item : m_BBAnalysisResults) {
         item.second->finalizeGlobals(globalsDeps);
     }
@@ -768,6 +831,28 @@ void FunctionAnaliser::Impl::dump() const
     }
 }
 
+void FunctionAnaliser::Impl::accountMemory(MemoryUsage& usage) const
+{
+    usage.addValueDependencies(m_valueDependencies);
+    usage.addArgumentDependencies(m_outArgDependencies);
+    usage.addValueDep(m_returnValueDependencies);
+    usage.call_dep_info += MemoryUsage::container_bytes(m_calledFunctionsInfo);
+    for (const auto& item : m_calledFunctionsInfo) {
+        usage.addArgumentDependencies(item.second);
+    }
+    usage.call_dep_info += MemoryUsage::container_bytes(m_calledFunctionGlobalsInfo);
+    for (const auto& item : m_calledFunctionGlobalsInfo) {
+        usage.addGlobalDependencies(item.second);
+    }
+    // loop results are shared by blocks of the loop
+    std::unordered_set<const DependencyAnalysisResult*> accounted;
+    for (const auto& item : m_BBAnalysisResults) {
+        if (accounted.insert(item.second.get()).second) {
+            item.second->accountMemory(usage);
+        }
+    }
+}
+
 void FunctionAnaliser::Impl::collectArguments()
 {
     std::for_each(m_F->arg_begin(), m_F->arg_end(),
@@ -802,13 +887,106 @@ LoopAnalysisResult* FunctionAnaliser::Impl::createLoopAnalysisResult(const DepIn
                                                        m_inputs,
                                                        m_FAGetter,
                                                        *loop,
-                                                       *m_LI);
+                                                       *m_LI,
+                                                       *m_traversalOrder);
     if (depInfo.isDefined()) {
         loopA->setLoopDependencies(depInfo);
     }
     return loopA;
 }
 
+void FunctionAnaliser::Impl::analyzeNode(llvm::BasicBlock* bb, llvm::Loop* loop, bool is_input_dep)
+{
+    //llvm::dbgs() << "process block: " << bb->getName() << "\n";
+    const auto& depInfo = is_input_dep ? DepInfo(DepInfo::INPUT_DEP) : getBasicBlockPredecessorInstructionsDeps(bb);
+    if (loop) {
+        m_BBAnalysisResults[bb].reset(createLoopAnalysisResult(depInfo, loop));
+    } else if (is_input_dep) {
+        // saturates values, out arguments and globals modified in the block
+        m_BBAnalysisResults[bb] = DependencyAnalysisResultT(
+                new InputDependentBasicBlockAnaliser(m_F, *m_AAR, *m_virtualCallsInfo, *m_indirectCallsInfo, m_inputs, m_FAGetter, bb));
+    } else {
+        m_BBAnalysisResults[bb] = createBasicBlockAnalysisResult(bb, depInfo);
+    }
+    m_BBAnalysisResults[bb]->setInitialValueDependencies(getBasicBlockPredecessorsDependencies(bb));
+    m_BBAnalysisResults[bb]->setOutArguments(getBasicBlockPredecessorsArguments(bb));
+    m_BBAnalysisResults[bb]->setCallbackFunctions(getBasicBlockPredecessorsCallbackFunctions(bb));
+    m_BBAnalysisResults[bb]->gatherResults();
+
+    updateValueDependencies(bb);
+    updateCalledFunctionsList(m_BBAnalysisResults[bb]);
+    updateReturnValueDependencies(bb);
+    updateOutArgumentDependencies(bb);
+}
+
+void FunctionAnaliser::Impl::analyzeIrreducibleRegion(const CFGTraversalOrder::LevelNodes& nodes,
+                                                      unsigned begin, unsigned end)
+{
+    // Region nodes are re-analyzed with results of the previous iteration for retreating predecessors,
+    // until results of region nodes do not change.
+    std::vector<DependencyAnaliser::ValueDependencies> values(end - begin);
+    std::vector<DependencyAnaliser::ArgumentDependenciesMap> out_args(end - begin);
+    std::vector<DepInfo> terminator_deps(end - begin);
+    const unsigned max_iterations = InputDepConfig::get().get_irreducible_region_iterations();
+    unsigned iteration = 0;
+    do {
+        if (++iteration > max_iterations) {
+            llvm::dbgs() << "Irreducible region at " << nodes[begin].first->getName()
+                         << " in function " << m_F->getName()
+                         << " did not converge. Consider region input dependent.\n";
+            for (unsigned i = begin; i < end; ++i) {
+                analyzeNode(nodes[i].first, nodes[i].second, true);
+            }
+            break;
+        }
+        for (unsigned i = begin; i < end; ++i) {
+            analyzeNode(nodes[i].first, nodes[i].second);
+        }
+    } while (isRegionChanged(nodes, begin, end, values, out_args, terminator_deps));
+}
+
+bool FunctionAnaliser::Impl::isRegionChanged(const CFGTraversalOrder::LevelNodes& nodes,
+                                             unsigned begin, unsigned end,
+                                             std::vector<DependencyAnaliser::ValueDependencies>& values,
+                                             std::vector<DependencyAnaliser::ArgumentDependenciesMap>& out_args,
+                                             std::vector<DepInfo>& terminator_deps) const
+{
+    bool changed = false;
+    for (unsigned i = begin; i < end; ++i) {
+        llvm::BasicBlock* bb = nodes[i].first;
+        const auto& result = m_BBAnalysisResults.find(bb)->second;
+        // for loops terminator of the header is not the exit of the node, use block dependencies instead
+        DepInfo terminator_dep = nodes[i].second ? result->getBlockDependencies()
+                                                 : result->getInstructionDependencies(bb->getTerminator());
+        const unsigned state_idx = i - begin;
+        if (terminator_dep != terminator_deps[state_idx]) {
+            terminator_deps[state_idx] = terminator_dep;
+            changed = true;
+        }
+        if (!equal_dependencies(result->getValuesDependencies(), values[state_idx])) {
+            values[state_idx] = result->getValuesDependencies();
+            changed = true;
+        }
+        if (!equal_dependencies(result->getOutParamsDependencies(), out_args[state_idx])) {
+            out_args[state_idx] = result->getOutParamsDependencies();
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+void FunctionAnaliser::Impl::collectUnreachableBlocks()
+{
+    // predecessors not reachable from entry should not be waited for
+    for (auto* B : m_traversalOrder->getBlocks()) {
+        for (auto pred = pred_begin(B); pred != pred_end(B); ++pred) {
+            if (!m_traversalOrder->hasBlock(*pred)) {
+                BasicBlocksUtils::get().addUnreachableBlock(*pred);
+            }
+        }
+    }
+}
+
 DepInfo FunctionAnaliser::Impl::getBasicBlockPredecessorInstructionsDeps(llvm::BasicBlock* B) const
 {
     DepInfo dep(DepInfo::DepInfo::INPUT_INDEP);
@@ -827,7 +1005,9 @@ DepInfo FunctionAnaliser::Impl::getBasicBlockPredecessorInstructionsDeps(llvm::B
             // means either block is in a loop, or cfg is broken. For the first case is safe to continue.
             // For the second case throw exception or continue based on run configuration
             // TODO: is it safe for loop case to assert that the loop of pred is the same as for B?
+            // predecessor in irreducible region is not analyzed yet on the first iteration of the region
             if (!m_LI->getLoopFor(pb)
+                && m_traversalOrder->getIrreducibleRegion(pb) == -1
                 && !InputDepConfig::get().is_goto_unsafe()
                 && !BasicBlocksUtils::get().isBlockUnreachable(pb)) {
                 // use stringstream to build message
@@ -863,6 +1043,21 @@ void FunctionAnaliser::Impl::updateFunctionInputDependencies()
             continue;
         }
         auto calledFA = m_FAGetter(calledF);
+        if (!calledFA && AnalysisTiers::get().is_input_independent(calledF)) {
+            // result of prepass, marked input dependent at finalization
+            if (m_is_inputDep) {
+                AnalysisTiers::get().mark_input_dep_function(calledF);
+                continue;
+            }
+            const auto& callDepInfo = getFunctionCallDepInfo(calledF);
+            for (const auto& callSite : callDepInfo.getCallSites()) {
+                if (isInputDependentBlock(callSite->getParent())) {
+                    AnalysisTiers::get().mark_input_dep_function(calledF);
+                    break;
+                }
+            }
+            continue;
+        }
         if (!calledFA) {
             InputDepConfig::get().add_input_dep_function(calledF);
             continue;
@@ -1018,7 +1213,7 @@ void FunctionAnaliser::Impl::updateReferencedGlobals()
 {
     for (const auto& BB : m_BBAnalysisResults) {
         const auto& refGlobals = BB.second->getReferencedGlobals();
-        m_referencedGlobals.insert(refGlobals.begin(), refGlobals.end());
+        m_referencedGlobals.insert(refGlobals);
     }
 }
 
@@ -1026,7 +1221,7 @@ void FunctionAnaliser::Impl::updateModifiedGlobals()
 {
     for (const auto& BB : m_BBAnalysisResults) {
         const auto& modGlobals = BB.second->getModifiedGlobals();
-        m_modifiedGlobals.insert(modGlobals.begin(), modGlobals.end());
+        m_modifiedGlobals.insert(modGlobals);
     }
 }
 
@@ -1039,12 +1234,17 @@ FunctionAnaliser::Impl::getBasicBlockPredecessorsDependencies(llvm::BasicBlock*
         auto pos = m_BBAnalysisResults.find(*pred);
         if (pos == m_BBAnalysisResults.end()) {
             //assert(m_LI.getLoopFor(*pred) != nullptr);
-            auto loopHead = m_loopBlocks.find(*pred);
-            if (loopHead == m_loopBlocks.end()) {
+            auto loopHead = m_traversalOrder->getTopLevelLoopHeader(*pred);
+            if (loopHead == nullptr) {
+                ++pred;
+                continue;
+            }
+            pos = m_BBAnalysisResults.find(loopHead);
+            if (pos == m_BBAnalysisResults.end() && m_traversalOrder->getIrreducibleRegion(loopHead) != -1) {
+                // loop in irreducible region, not analyzed yet
                 ++pred;
                 continue;
             }
-            pos = m_BBAnalysisResults.find(loopHead->second);
         }
         assert(pos != m_BBAnalysisResults.end());
         const auto& valueDeps = pos->second->getValuesDependencies();
@@ -1054,6 +1254,7 @@ FunctionAnaliser::Impl::getBasicBlockPredecessorsDependencies(llvm::BasicBlock*
                 res.first->second.mergeDependencies(dep.second);
             }
         }
+        AnalysisCostRecorder::get().count_map_merge(valueDeps.size());
         ++pred;
     }
     // Note: values which have been added from predecessors won't change here
@@ -1074,12 +1275,17 @@ FunctionAnaliser::Impl::getBasicBlockPredecessorsArguments(llvm::BasicBlock* B)
         auto pos = m_BBAnalysisResults.find(*pred);
         if (pos == m_BBAnalysisResults.end()) {
             //assert(m_LI.getLoopFor(*pred) != nullptr);
-            auto loopHead = m_loopBlocks.find(*pred);
-            if (loopHead == m_loopBlocks.end()) {
+            auto loopHead = m_traversalOrder->getTopLevelLoopHeader(*pred);
+            if (loopHead == nullptr) {
+                ++pred;
+                continue;
+            }
+            pos = m_BBAnalysisResults.find(loopHead);
+            if (pos == m_BBAnalysisResults.end() && m_traversalOrder->getIrreducibleRegion(loopHead) != -1) {
+                // loop in irreducible region, not analyzed yet
                 ++pred;
                 continue;
             }
-            pos = m_BBAnalysisResults.find(loopHead->second);
         }
         assert(pos != m_BBAnalysisResults.end());
         const auto& argDeps = pos->second->getOutParamsDependencies();
@@ -1089,6 +1295,7 @@ FunctionAnaliser::Impl::getBasicBlockPredecessorsArguments(llvm::BasicBlock* B)
                 res.first->second.mergeDependencies(dep.second);
             }
         }
+        AnalysisCostRecorder::get().count_map_merge(argDeps.size());
         ++pred;
     }
     return deps;
@@ -1107,12 +1314,17 @@ FunctionAnaliser::Impl::getBasicBlockPredecessorsCallbackFunctions(llvm::BasicBl
         auto pos = m_BBAnalysisResults.find(*pred);
         if (pos == m_BBAnalysisResults.end()) {
             //assert(m_LI.getLoopFor(*pred) != nullptr);
-            auto loopHead = m_loopBlocks.find(*pred);
-            if (loopHead == m_loopBlocks.end()) {
+            auto loopHead = m_traversalOrder->getTopLevelLoopHeader(*pred);
+            if (loopHead == nullptr) {
+                ++pred;
+                continue;
+            }
+            pos = m_BBAnalysisResults.find(loopHead);
+            if (pos == m_BBAnalysisResults.end() && m_traversalOrder->getIrreducibleRegion(loopHead) != -1) {
+                // loop in irreducible region, not analyzed yet
                 ++pred;
                 continue;
             }
-            pos = m_BBAnalysisResults.find(loopHead->second);
         }
         assert(pos != m_BBAnalysisResults.end());
         const auto& pred_callbacks = pos->second->getCallbackFunctions();
@@ -1137,11 +1349,8 @@ FunctionAnaliser::Impl::DependencyAnalysisResultT FunctionAnaliser::Impl::getAna
     if (auto loop = m_LI->getLoopFor(bb)) {
         auto top_loop = Utils::getTopLevelLoop(loop);
         bb = top_loop->getHeader();
-    } else {
-        auto looppos = m_loopBlocks.find(bb);
-        if (looppos != m_loopBlocks.end()) {
-            bb = looppos->second;
-        }
+    } else if (auto loopHead = m_traversalOrder ? m_traversalOrder->getTopLevelLoopHeader(bb) : nullptr) {
+        bb = loopHead;
     }
     pos = m_BBAnalysisResults.find(bb);
     if (pos == m_BBAnalysisResults.end()) {
@@ -1218,6 +1427,11 @@ FunctionSet FunctionAnaliser::getCallSitesData() const
     return m_analiser->getCallSitesData();
 }
 
+bool FunctionAnaliser::hasCallArgumentInfo(llvm::Function* F) const
+{
+    return m_analiser->hasCallArgumentInfo(F);
+}
+
 const DependencyAnaliser::ArgumentDependenciesMap&
 FunctionAnaliser::getCallArgumentInfo(llvm::Function* F) const
 {
@@ -1391,6 +1605,11 @@ void FunctionAnaliser::dump() const
     m_analiser->dump();
 }
 
+void FunctionAnaliser::accountMemory(MemoryUsage& usage) const
+{
+    m_analiser->accountMemory(usage);
+}
+
 llvm::Function* FunctionAnaliser::getFunction()
 {
     return m_analiser->getFunction();
@@ -1,3 +1,4 @@
+#include "input-dependency/Analysis/InputDepConfig.h"
 #include "input-dependency/Analysis/Utils.h"
 
 #include "llvm/IR/Function.h"
@@ -10,6 +11,24 @@ namespace input_dependency {
 
 namespace {
 
+bool equalDependencies(const ValueDepInfo& info1, const ValueDepInfo& info2)
+{
+    if (!(info1.getValueDep() == info2.getValueDep())) {
+        return false;
+    }
+    const auto& elements1 = info1.getCompositeValueDeps();
+    const auto& elements2 = info2.getCompositeValueDeps();
+    if (elements1.size() != elements2.size()) {
+        return false;
+    }
+    for (unsigned i = 0; i < elements1.size(); ++i) {
+        if (!equalDependencies(elements1[i], elements2[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
 // Note, only the dependency info of a global value is going to be finalized, the dependencies of elements are not
 ValueDepInfo getFinalizedDepInfo(const std::unordered_map<llvm::GlobalVariable*, ValueDepInfo>& actualDeps,
                                  ValueSet& valueDeps)
@@ -53,6 +72,10 @@ ValueDepInfo getFinalizedDepInfo(const std::unordered_map<llvm::GlobalVariable*,
                 auto deps = actualDeps.find(global);
                 if (deps != actualDeps.end()) {
                     global_depInfo.mergeDependencies(deps->second);
+                    if (global_depInfo.isInputDep()) {
+                        // saturated, dependencies are dropped
+                        break;
+                    }
                 }
                 ++it;
             }
@@ -119,17 +142,51 @@ void finalizeGlobalsDeps(const FunctionCallDepInfo::GlobalVariableDependencyMap&
     }
 }
 
+template <class CallSiteDeps, class Deps>
+bool insertCallSite(const llvm::Instruction* instr,
+                    const Deps& deps,
+                    CallSiteDeps& callSiteDeps,
+                    llvm::DenseMap<const llvm::Instruction*, unsigned>& ordinals)
+{
+    auto res = ordinals.insert(std::make_pair(instr, callSiteDeps.size()));
+    if (!res.second) {
+        return false;
+    }
+    callSiteDeps.emplace_back(instr, deps);
+    return true;
+}
+
+template <class CallSiteDeps>
+void eraseCallSite(const llvm::Instruction* instr,
+                   CallSiteDeps& callSiteDeps,
+                   llvm::DenseMap<const llvm::Instruction*, unsigned>& ordinals)
+{
+    auto pos = ordinals.find(instr);
+    if (pos == ordinals.end()) {
+        return;
+    }
+    const unsigned ordinal = pos->second;
+    ordinals.erase(pos);
+    if (ordinal != callSiteDeps.size() - 1) {
+        callSiteDeps[ordinal] = std::move(callSiteDeps.back());
+        ordinals[callSiteDeps[ordinal].first] = ordinal;
+    }
+    callSiteDeps.pop_back();
+}
+
 }
 
 FunctionCallDepInfo::FunctionCallDepInfo()
     : m_F(nullptr)
     , m_isCallback(false)
+    , m_mergedDepsValid(true)
 {
 }
 
 FunctionCallDepInfo::FunctionCallDepInfo(const llvm::Function& F)
     : m_F(&F)
     , m_isCallback(false)
+    , m_mergedDepsValid(true)
 {
 }
 
@@ -197,8 +254,9 @@ void FunctionCallDepInfo::addDepInfo(const FunctionCallDepInfo& callsInfo)
 
 void FunctionCallDepInfo::removeCall(const llvm::Instruction* callInst)
 {
-    m_callsArgumentsDeps.erase(callInst);
-    m_callsGlobalsDeps.erase(callInst);
+    eraseCallSite(callInst, m_callsArgumentsDeps, m_callsArgumentsOrdinals);
+    eraseCallSite(callInst, m_callsGlobalsDeps, m_callsGlobalsOrdinals);
+    m_mergedDepsValid = false;
 }
 
 const InstrSet& FunctionCallDepInfo::getCallSites() const
@@ -206,12 +264,12 @@ const InstrSet& FunctionCallDepInfo::getCallSites() const
     return m_callSites;
 }
 
-const FunctionCallDepInfo::CallSiteArgumentsDependenciesMap& FunctionCallDepInfo::getCallsArgumentDependencies() const
+const FunctionCallDepInfo::CallSiteArgumentsDependencies& FunctionCallDepInfo::getCallsArgumentDependencies() const
 {
     return m_callsArgumentsDeps;
 }
 
-const FunctionCallDepInfo::CallSiteGloblasDependenciesMap& FunctionCallDepInfo::getCallsGlobalsDependencies() const
+const FunctionCallDepInfo::CallSiteGlobalsDependencies& FunctionCallDepInfo::getCallsGlobalsDependencies() const
 {
     return m_callsGlobalsDeps;
 }
@@ -219,25 +277,25 @@ const FunctionCallDepInfo::CallSiteGloblasDependenciesMap& FunctionCallDepInfo::
 const FunctionCallDepInfo::ArgumentDependenciesMap&
 FunctionCallDepInfo::getArgumentDependenciesForCall(const llvm::CallInst* callInst) const
 {
-    return const_cast<FunctionCallDepInfo*>(this)->getArgumentsDependencies(callInst);
+    return findArgumentsDependencies(callInst);
 }
 
 const FunctionCallDepInfo::ArgumentDependenciesMap&
 FunctionCallDepInfo::getArgumentDependenciesForInvoke(const llvm::InvokeInst* invokeInst) const
 {
-    return const_cast<FunctionCallDepInfo*>(this)->getArgumentsDependencies(invokeInst);
+    return findArgumentsDependencies(invokeInst);
 }
 
 const FunctionCallDepInfo::GlobalVariableDependencyMap&
 FunctionCallDepInfo::getGlobalsDependenciesForCall(const llvm::CallInst* callInst) const
 {
-    return const_cast<FunctionCallDepInfo*>(this)->getGlobalsDependencies(callInst);
+    return findGlobalsDependencies(callInst);
 }
 
 const FunctionCallDepInfo::GlobalVariableDependencyMap&
 FunctionCallDepInfo::getGlobalsDependenciesForInvoke(const llvm::InvokeInst* invokeInst) const
 {
-    return const_cast<FunctionCallDepInfo*>(this)->getGlobalsDependencies(invokeInst);
+    return findGlobalsDependencies(invokeInst);
 }
 
 FunctionCallDepInfo::ArgumentDependenciesMap&
@@ -275,9 +333,13 @@ FunctionCallDepInfo::ArgumentDependenciesMap FunctionCallDepInfo::getMergedArgum
         }
         return mergedDeps;
     }
-    for (const auto& item : m_callsArgumentsDeps) {
-        for (const auto& argItem : item.second) {
-            mergedDeps[argItem.first].mergeDependencies(argItem.second);
+    updateMergedDependencies();
+    if (InputDepConfig::get().is_verify_merged_call_deps()) {
+        verifyMergedDependencies();
+    }
+    for (const auto& argItem : m_mergedArgumentsDeps) {
+        if (argItem.first) {
+            mergedDeps.insert(argItem);
         }
     }
     return mergedDeps;
@@ -286,13 +348,11 @@ FunctionCallDepInfo::ArgumentDependenciesMap FunctionCallDepInfo::getMergedArgum
 
 FunctionCallDepInfo::GlobalVariableDependencyMap FunctionCallDepInfo::getMergedGlobalsDependencies() const
 {
-    GlobalVariableDependencyMap mergedDeps;
-    for (const auto& item : m_callsGlobalsDeps) {
-        for (const auto& globalItem : item.second) {
-            mergedDeps[globalItem.first].mergeDependencies(globalItem.second);
-        }
+    updateMergedDependencies();
+    if (InputDepConfig::get().is_verify_merged_call_deps()) {
+        verifyMergedDependencies();
     }
-    return mergedDeps;
+    return m_mergedGlobalsDeps;
 }
 
 void FunctionCallDepInfo::finalizeArgumentDependencies(const ArgumentDependenciesMap& actualDeps)
@@ -303,6 +363,7 @@ void FunctionCallDepInfo::finalizeArgumentDependencies(const ArgumentDependencie
     for (auto& callItem : m_callsGlobalsDeps) {
         finalizeArgDeps(actualDeps, callItem.second);
     }
+    m_mergedDepsValid = false;
 }
 
 void FunctionCallDepInfo::finalizeGlobalsDependencies(const GlobalVariableDependencyMap& actualDeps)
@@ -313,6 +374,7 @@ void FunctionCallDepInfo::finalizeGlobalsDependencies(const GlobalVariableDepend
     for (auto& callItem : m_callsGlobalsDeps) {
         finalizeGlobalsDeps(actualDeps, callItem.second);
     }
+    m_mergedDepsValid = false;
 }
 
 bool FunctionCallDepInfo::isValidInstruction(const llvm::Instruction* instr) const
@@ -330,34 +392,118 @@ bool FunctionCallDepInfo::isValidInstruction(const llvm::Instruction* instr) con
 
 void FunctionCallDepInfo::addCallSiteArguments(const llvm::Instruction* instr, const ArgumentDependenciesMap& argDeps)
 {
-    auto res = m_callsArgumentsDeps.insert(std::make_pair(instr, argDeps));
     m_callSites.insert(const_cast<llvm::Instruction*>(instr));
-    if (!res.second) {
+    if (!insertCallSite(instr, argDeps, m_callsArgumentsDeps, m_callsArgumentsOrdinals)) {
         //llvm::dbgs() << "FunctionCallDepInfo: arguments information for call site " << *instr << " is already collected\n";
+        return;
+    }
+    if (m_mergedDepsValid) {
+        mergeArgumentDependencies(argDeps);
     }
 }
 
 void FunctionCallDepInfo::addCallSiteGlobals(const llvm::Instruction* instr, const GlobalVariableDependencyMap& globalDeps)
 {
-    auto res = m_callsGlobalsDeps.insert(std::make_pair(instr, globalDeps));
     m_callSites.insert(const_cast<llvm::Instruction*>(instr));
-    if (!res.second) {
+    if (!insertCallSite(instr, globalDeps, m_callsGlobalsDeps, m_callsGlobalsOrdinals)) {
         //llvm::dbgs() << "FunctionCallDepInfo: globals information for call site " << *instr << " is already collected\n";
+        return;
     }
+    if (m_mergedDepsValid) {
+        mergeGlobalsDependencies(globalDeps);
+    }
+}
+
+const FunctionCallDepInfo::ArgumentDependenciesMap&
+FunctionCallDepInfo::findArgumentsDependencies(const llvm::Instruction* instr) const
+{
+    auto pos = m_callsArgumentsOrdinals.find(instr);
+    assert(pos != m_callsArgumentsOrdinals.end());
+    return m_callsArgumentsDeps[pos->second].second;
+}
+
+const FunctionCallDepInfo::GlobalVariableDependencyMap&
+FunctionCallDepInfo::findGlobalsDependencies(const llvm::Instruction* instr) const
+{
+    auto pos = m_callsGlobalsOrdinals.find(instr);
+    assert(pos != m_callsGlobalsOrdinals.end());
+    return m_callsGlobalsDeps[pos->second].second;
 }
 
 FunctionCallDepInfo::ArgumentDependenciesMap& FunctionCallDepInfo::getArgumentsDependencies(const llvm::Instruction* instr)
 {
-    auto pos = m_callsArgumentsDeps.find(instr);
-    assert(pos != m_callsArgumentsDeps.end());
-    return pos->second;
+    // caller may modify call site dependencies
+    m_mergedDepsValid = false;
+    return const_cast<ArgumentDependenciesMap&>(findArgumentsDependencies(instr));
 }
 
 FunctionCallDepInfo::GlobalVariableDependencyMap& FunctionCallDepInfo::getGlobalsDependencies(const llvm::Instruction* instr)
 {
-    auto pos = m_callsGlobalsDeps.find(instr);
-    assert(pos != m_callsGlobalsDeps.end());
-    return pos->second;
+    m_mergedDepsValid = false;
+    return const_cast<GlobalVariableDependencyMap&>(findGlobalsDependencies(instr));
+}
+
+void FunctionCallDepInfo::mergeArgumentDependencies(const ArgumentDependenciesMap& argDeps) const
+{
+    for (const auto& argItem : argDeps) {
+        const unsigned argNo = argItem.first->getArgNo();
+        if (argNo >= m_mergedArgumentsDeps.size()) {
+            m_mergedArgumentsDeps.resize(argNo + 1);
+        }
+        auto& mergedItem = m_mergedArgumentsDeps[argNo];
+        assert(!mergedItem.first || mergedItem.first == argItem.first);
+        mergedItem.first = argItem.first;
+        mergedItem.second.mergeDependencies(argItem.second);
+    }
+}
+
+void FunctionCallDepInfo::mergeGlobalsDependencies(const GlobalVariableDependencyMap& globalDeps) const
+{
+    for (const auto& globalItem : globalDeps) {
+        m_mergedGlobalsDeps[globalItem.first].mergeDependencies(globalItem.second);
+    }
+}
+
+void FunctionCallDepInfo::updateMergedDependencies() const
+{
+    if (m_mergedDepsValid) {
+        return;
+    }
+    m_mergedArgumentsDeps.clear();
+    m_mergedGlobalsDeps.clear();
+    for (const auto& item : m_callsArgumentsDeps) {
+        mergeArgumentDependencies(item.second);
+    }
+    for (const auto& item : m_callsGlobalsDeps) {
+        mergeGlobalsDependencies(item.second);
+    }
+    m_mergedDepsValid = true;
+}
+
+void FunctionCallDepInfo::verifyMergedDependencies() const
+{
+    const auto mergedArgumentsDeps = m_mergedArgumentsDeps;
+    const auto mergedGlobalsDeps = m_mergedGlobalsDeps;
+    m_mergedDepsValid = false;
+    updateMergedDependencies();
+
+    bool matches = mergedArgumentsDeps.size() == m_mergedArgumentsDeps.size()
+                    && mergedGlobalsDeps.size() == m_mergedGlobalsDeps.size();
+    for (unsigned i = 0; matches && i < m_mergedArgumentsDeps.size(); ++i) {
+        matches = mergedArgumentsDeps[i].first == m_mergedArgumentsDeps[i].first
+                    && equalDependencies(mergedArgumentsDeps[i].second, m_mergedArgumentsDeps[i].second);
+    }
+    for (const auto& globalItem : m_mergedGlobalsDeps) {
+        if (!matches) {
+            break;
+        }
+        auto pos = mergedGlobalsDeps.find(globalItem.first);
+        matches = pos != mergedGlobalsDeps.end() && equalDependencies(pos->second, globalItem.second);
+    }
+    if (!matches) {
+        llvm::dbgs() << "Merged call site dependencies of " << m_F->getName() << " differ from merge of all call sites\n";
+    }
+    InputDepConfig::get().add_merged_call_deps_check(matches);
 }
 
 }
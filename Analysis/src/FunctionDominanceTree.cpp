@@ -1,7 +1,6 @@
 #include "input-dependency/Analysis/FunctionDominanceTree.h"
 
-#include "llvm/ADT/SCCIterator.h"
-#include "llvm/Analysis/CallGraphSCCPass.h"
+#include "llvm/ADT/BitVector.h"
 #include "llvm/Analysis/CallGraph.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Module.h"
@@ -11,88 +10,273 @@
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/Transforms/IPO/PassManagerBuilder.h"
 
+#include <algorithm>
 
 namespace input_dependency {
 
-FunctionDominanceTree::DomNode::DomNode(llvm::Function* f)
-    : function(f)
-{
-}
+constexpr unsigned FunctionDominanceTree::ROOT;
+constexpr unsigned FunctionDominanceTree::UNDEF;
 
-void FunctionDominanceTree::DomNode::add_dominator(DomNodeT dom)
+void FunctionDominanceTree::build(llvm::Module& M, llvm::CallGraph& CG)
 {
-    dominators.insert(dom);
+    m_functions.clear();
+    m_indices.clear();
+    m_functions.push_back(nullptr);
+    for (auto& F : M) {
+        if (F.isDeclaration()) {
+            continue;
+        }
+        m_indices.insert(std::make_pair(&F, m_functions.size()));
+        m_functions.push_back(&F);
+    }
+    const unsigned size = m_functions.size();
+    std::vector<std::vector<unsigned>> callees(size);
+    const auto& add_callees = [this, &callees] (unsigned caller, llvm::CallGraphNode* node) {
+        for (auto& callrecord : *node) {
+            if (!callrecord.second) {
+                continue;
+            }
+            unsigned callee = get_index(callrecord.second->getFunction());
+            if (callee != UNDEF) {
+                callees[caller].push_back(callee);
+            }
+        }
+    };
+    add_callees(ROOT, CG.getExternalCallingNode());
+    for (unsigned idx = 1; idx < size; ++idx) {
+        add_callees(idx, CG[m_functions[idx]]);
+    }
+
+    // functions not reachable from entries are considered to be called from root
+    llvm::BitVector reached(size);
+    std::vector<unsigned> work_list;
+    for (unsigned idx = 0; idx < size; ++idx) {
+        if (reached.test(idx)) {
+            continue;
+        }
+        if (idx != ROOT) {
+            callees[ROOT].push_back(idx);
+        }
+        reached.set(idx);
+        work_list.push_back(idx);
+        while (!work_list.empty()) {
+            unsigned node = work_list.back();
+            work_list.pop_back();
+            for (auto callee : callees[node]) {
+                if (!reached.test(callee)) {
+                    reached.set(callee);
+                    work_list.push_back(callee);
+                }
+            }
+        }
+    }
+
+    // CSR successors and predecessors
+    m_calleeOffsets.assign(1, 0);
+    m_callees.clear();
+    std::vector<unsigned> callers_count(size, 0);
+    for (auto& node_callees : callees) {
+        std::sort(node_callees.begin(), node_callees.end());
+        node_callees.erase(std::unique(node_callees.begin(), node_callees.end()), node_callees.end());
+        m_callees.insert(m_callees.end(), node_callees.begin(), node_callees.end());
+        m_calleeOffsets.push_back(m_callees.size());
+        for (auto callee : node_callees) {
+            ++callers_count[callee];
+        }
+    }
+    m_callerOffsets.assign(size + 1, 0);
+    for (unsigned idx = 0; idx < size; ++idx) {
+        m_callerOffsets[idx + 1] = m_callerOffsets[idx] + callers_count[idx];
+    }
+    m_callers.resize(m_callees.size());
+    std::vector<unsigned> insert_pos(m_callerOffsets.begin(), m_callerOffsets.end() - 1);
+    for (unsigned caller = 0; caller < size; ++caller) {
+        for (unsigned e = m_calleeOffsets[caller]; e != m_calleeOffsets[caller + 1]; ++e) {
+            m_callers[insert_pos[m_callees[e]]++] = caller;
+        }
+    }
+
+    std::vector<unsigned> rpo;
+    compute_reverse_post_order(rpo);
+    compute_dominators(rpo);
+    compute_dfs_intervals();
 }
 
-bool FunctionDominanceTree::DomNode::postdominates(DomNodeT dom) const
+bool FunctionDominanceTree::has_function(llvm::Function* f) const
 {
-    return dominators.find(dom) != dominators.end();
+    return get_index(f) != UNDEF;
 }
 
-FunctionDominanceTree::DomNode::Dominators& FunctionDominanceTree::DomNode::get_dominators()
+llvm::Function* FunctionDominanceTree::get_immediate_dominator(llvm::Function* f) const
 {
-    return dominators;
+    unsigned idx = get_index(f);
+    if (idx == UNDEF) {
+        return nullptr;
+    }
+    return m_functions[m_idoms[idx]];
 }
 
-const FunctionDominanceTree::DomNode::Dominators& FunctionDominanceTree::DomNode::get_dominators() const
+bool FunctionDominanceTree::dominates(llvm::Function* dom, llvm::Function* f) const
 {
-    return dominators;
+    unsigned dom_idx = get_index(dom);
+    unsigned f_idx = get_index(f);
+    if (dom_idx == UNDEF || f_idx == UNDEF) {
+        return false;
+    }
+    return m_dfsIn[dom_idx] <= m_dfsIn[f_idx] && m_dfsOut[f_idx] <= m_dfsOut[dom_idx];
 }
 
-llvm::Function* FunctionDominanceTree::DomNode::get_function()
+FunctionDominanceTree::FunctionList FunctionDominanceTree::get_dominated_functions(llvm::Function* f) const
 {
-    return function;
+    FunctionList functions;
+    unsigned idx = get_index(f);
+    if (idx == UNDEF) {
+        return functions;
+    }
+    for (unsigned e = m_childOffsets[idx]; e != m_childOffsets[idx + 1]; ++e) {
+        functions.push_back(m_functions[m_children[e]]);
+    }
+    return functions;
 }
 
-void FunctionDominanceTree::DomNode::dump() const
+FunctionDominanceTree::FunctionList FunctionDominanceTree::get_callers(llvm::Function* f) const
 {
-    llvm::dbgs() << "Function: " << function->getName() << "\n";
-    for (const auto& caller_node : dominators) {
-        llvm::dbgs() << "   Called from: " << caller_node->get_function()->getName() << "\n";
+    FunctionList functions;
+    unsigned idx = get_index(f);
+    if (idx == UNDEF) {
+        return functions;
+    }
+    for (unsigned e = m_callerOffsets[idx]; e != m_callerOffsets[idx + 1]; ++e) {
+        if (m_callers[e] != ROOT) {
+            functions.push_back(m_functions[m_callers[e]]);
+        }
     }
+    return functions;
 }
 
-void FunctionDominanceTree::add_function(llvm::Function* f, DomNodeT domNode)
+void FunctionDominanceTree::dump() const
 {
-    assert(function_dominators.find(f) == function_dominators.end());
-    function_dominators[f] = domNode;
+    for (unsigned idx = 1; idx < m_functions.size(); ++idx) {
+        llvm::dbgs() << "Function: " << m_functions[idx]->getName() << "\n";
+        if (m_idoms[idx] != ROOT) {
+            llvm::dbgs() << "   Immediate dominator: " << m_functions[m_idoms[idx]]->getName() << "\n";
+        }
+    }
 }
 
-FunctionDominanceTree::DomNodeT FunctionDominanceTree::get_or_create_function_dominance_node(llvm::Function* f)
+unsigned FunctionDominanceTree::get_index(llvm::Function* f) const
 {
-    auto res = function_dominators.insert(std::make_pair(f, DomNodeT(new DomNode(f))));
-    return res.first->second;
+    auto pos = m_indices.find(f);
+    if (pos == m_indices.end()) {
+        return UNDEF;
+    }
+    return pos->second;
 }
 
-void FunctionDominanceTree::add_function_dominator(llvm::Function* f, DomNodeT domNode)
+void FunctionDominanceTree::compute_reverse_post_order(std::vector<unsigned>& rpo) const
 {
-    auto pos = function_dominators.find(f);
-    assert(pos != function_dominators.end());
-    pos->second->add_dominator(domNode);
+    const unsigned size = m_functions.size();
+    rpo.clear();
+    rpo.reserve(size);
+    llvm::BitVector visited(size);
+    // pairs of node and next successor edge to visit
+    std::vector<std::pair<unsigned, unsigned>> stack;
+    stack.push_back(std::make_pair(ROOT, m_calleeOffsets[ROOT]));
+    visited.set(ROOT);
+    while (!stack.empty()) {
+        const unsigned node = stack.back().first;
+        const unsigned edge = stack.back().second;
+        if (edge == m_calleeOffsets[node + 1]) {
+            rpo.push_back(node);
+            stack.pop_back();
+            continue;
+        }
+        ++stack.back().second;
+        const unsigned callee = m_callees[edge];
+        if (!visited.test(callee)) {
+            visited.set(callee);
+            stack.push_back(std::make_pair(callee, m_calleeOffsets[callee]));
+        }
+    }
+    std::reverse(rpo.begin(), rpo.end());
 }
 
-FunctionDominanceTree::DomNodeT FunctionDominanceTree::get_function_dominators(llvm::Function* f)
+void FunctionDominanceTree::compute_dominators(const std::vector<unsigned>& rpo)
 {
-    auto pos = function_dominators.find(f);
-    if (pos != function_dominators.end()) {
-        return pos->second;
+    std::vector<unsigned> rpo_numbers(m_functions.size(), UNDEF);
+    for (unsigned i = 0; i < rpo.size(); ++i) {
+        rpo_numbers[rpo[i]] = i;
+    }
+    m_idoms.assign(m_functions.size(), UNDEF);
+    m_idoms[ROOT] = ROOT;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (unsigned i = 1; i < rpo.size(); ++i) {
+            const unsigned node = rpo[i];
+            unsigned new_idom = UNDEF;
+            for (unsigned e = m_callerOffsets[node]; e != m_callerOffsets[node + 1]; ++e) {
+                const unsigned caller = m_callers[e];
+                if (m_idoms[caller] == UNDEF) {
+                    continue;
+                }
+                new_idom = (new_idom == UNDEF) ? caller : intersect(caller, new_idom, rpo_numbers);
+            }
+            if (new_idom != m_idoms[node]) {
+                m_idoms[node] = new_idom;
+                changed = true;
+            }
+        }
     }
-    return DomNodeT();
 }
 
-const FunctionDominanceTree::DomNodeT FunctionDominanceTree::get_function_dominators(llvm::Function* f) const
+unsigned FunctionDominanceTree::intersect(unsigned node1, unsigned node2, const std::vector<unsigned>& rpo_numbers) const
 {
-    auto pos = function_dominators.find(f);
-    if (pos != function_dominators.end()) {
-        return pos->second;
+    while (node1 != node2) {
+        while (rpo_numbers[node1] > rpo_numbers[node2]) {
+            node1 = m_idoms[node1];
+        }
+        while (rpo_numbers[node2] > rpo_numbers[node1]) {
+            node2 = m_idoms[node2];
+        }
     }
-    return DomNodeT();
+    return node1;
 }
 
-void FunctionDominanceTree::dump() const
+void FunctionDominanceTree::compute_dfs_intervals()
 {
-    for (const auto& function_node : function_dominators) {
-        function_node.second->dump();
+    const unsigned size = m_functions.size();
+    m_childOffsets.assign(size + 1, 0);
+    for (unsigned idx = 1; idx < size; ++idx) {
+        ++m_childOffsets[m_idoms[idx] + 1];
+    }
+    for (unsigned idx = 0; idx < size; ++idx) {
+        m_childOffsets[idx + 1] += m_childOffsets[idx];
+    }
+    m_children.resize(size - 1);
+    std::vector<unsigned> insert_pos(m_childOffsets.begin(), m_childOffsets.end() - 1);
+    for (unsigned idx = 1; idx < size; ++idx) {
+        m_children[insert_pos[m_idoms[idx]]++] = idx;
+    }
+
+    m_dfsIn.assign(size, 0);
+    m_dfsOut.assign(size, 0);
+    unsigned counter = 0;
+    std::vector<std::pair<unsigned, unsigned>> stack;
+    stack.push_back(std::make_pair(ROOT, m_childOffsets[ROOT]));
+    m_dfsIn[ROOT] = counter++;
+    while (!stack.empty()) {
+        const unsigned node = stack.back().first;
+        const unsigned edge = stack.back().second;
+        if (edge == m_childOffsets[node + 1]) {
+            m_dfsOut[node] = counter++;
+            stack.pop_back();
+            continue;
+        }
+        ++stack.back().second;
+        const unsigned child = m_children[edge];
+        m_dfsIn[child] = counter++;
+        stack.push_back(std::make_pair(child, m_childOffsets[child]));
     }
 }
 
@@ -106,28 +290,7 @@ FunctionDominanceTreePass::FunctionDominanceTreePass()
 bool FunctionDominanceTreePass::runOnModule(llvm::Module& M)
 {
     llvm::CallGraph& CG = getAnalysis<llvm::CallGraphWrapperPass>().getCallGraph();
-    llvm::scc_iterator<llvm::CallGraph*> CGI = llvm::scc_begin(&CG);
-    llvm::CallGraphSCC CurSCC(CG, &CGI);
-    while (!CGI.isAtEnd()) {
-        const std::vector<llvm::CallGraphNode *> &NodeVec = *CGI;
-        CurSCC.initialize(NodeVec);
-        for (llvm::CallGraphNode* node : CurSCC) {
-            llvm::Function* F = node->getFunction();
-            if (F == nullptr || F->isDeclaration()) {
-                continue;
-            }
-            auto F_node = dominance_tree.get_or_create_function_dominance_node(F);
-            for (auto& callrecord : *node) {
-                llvm::Function* calledF = callrecord.second->getFunction();
-                if (calledF == nullptr) {
-                    continue;
-                }
-                auto called_node = dominance_tree.get_or_create_function_dominance_node(calledF);
-                called_node->add_dominator(F_node);
-            }
-        }
-        ++CGI;
-    }
+    dominance_tree.build(M, CG);
     //dominance_tree.dump();
     return false;
 }
@@ -0,0 +1,67 @@
+#include "input-dependency/Analysis/GlobalsSet.h"
+
+#include "input-dependency/Analysis/AnalysisContext.h"
+
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/Module.h"
+
+namespace input_dependency {
+
+GlobalsIndex& GlobalsIndex::get()
+{
+    return AnalysisContext::get().get_globals_index();
+}
+
+void GlobalsIndex::add_module(llvm::Module& M)
+{
+    for (auto& global : M.globals()) {
+        get_index(&global);
+    }
+}
+
+unsigned GlobalsIndex::get_index(llvm::GlobalVariable* global)
+{
+    auto res = m_indices.insert(std::make_pair(global, m_globals.size()));
+    if (res.second) {
+        m_globals.push_back(global);
+    }
+    return res.first->second;
+}
+
+int GlobalsIndex::find_index(llvm::GlobalVariable* global) const
+{
+    auto pos = m_indices.find(global);
+    if (pos == m_indices.end()) {
+        return -1;
+    }
+    return pos->second;
+}
+
+bool GlobalsSet::insert(llvm::GlobalVariable* global)
+{
+    if (!m_globalsIndex) {
+        m_globalsIndex = &GlobalsIndex::get();
+    }
+    const unsigned index = m_globalsIndex->get_index(global);
+    if (index >= m_bits.size()) {
+        // room for globals indexed so far, so that merges rarely resize
+        m_bits.resize(m_globalsIndex->size());
+    }
+    if (m_bits.test(index)) {
+        return false;
+    }
+    m_bits.set(index);
+    return true;
+}
+
+bool GlobalsSet::count(llvm::GlobalVariable* global) const
+{
+    if (!m_globalsIndex) {
+        return false;
+    }
+    const int index = m_globalsIndex->find_index(global);
+    return index != -1 && static_cast<unsigned>(index) < m_bits.size() && m_bits.test(index);
+}
+
+} // namespace input_dependency
+
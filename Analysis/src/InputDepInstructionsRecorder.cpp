@@ -1,6 +1,7 @@
 #include "input-dependency/Analysis/InputDepInstructionsRecorder.h"
 #include "input-dependency/Analysis/LoggingUtils.h"
 
+#include "llvm/IR/Function.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
@@ -25,6 +26,17 @@ void InputDepInstructionsRecorder::record(llvm::BasicBlock* B)
     }
 }
 
+void InputDepInstructionsRecorder::erase(llvm::Function* F)
+{
+    if (m_input_dep_instructions.empty()) {
+        return;
+    }
+    for (auto& B : *F) {
+        for (auto& I : B) {
+            m_input_dep_instructions.erase(&I);
+        }
+    }
+}
 
 void InputDepInstructionsRecorder::dump_dbg_info() const
 {
@@ -1,12 +1,20 @@
 #include "input-dependency/Analysis/InputDependencyAnalysis.h"
 
+#include "input-dependency/Analysis/AnalysisBudget.h"
+#include "input-dependency/Analysis/AnalysisTiers.h"
 #include "input-dependency/Analysis/BasicBlocksUtils.h"
+#include "input-dependency/Analysis/FrozenFunctionAnalysisResult.h"
 #include "input-dependency/Analysis/FunctionAnaliser.h"
 #include "input-dependency/Analysis/FunctionInputDependencyResultInterface.h"
 #include "input-dependency/Analysis/IndirectCallSitesAnalysis.h"
 #include "input-dependency/Analysis/InputDepConfig.h"
 #include "input-dependency/Analysis/InputDepInstructionsRecorder.h"
 #include "input-dependency/Analysis/InputDependentFunctionAnalysisResult.h"
+#include "input-dependency/Analysis/InputIndependentFunctionAnalysisResult.h"
+#include "input-dependency/Analysis/MemoryAccounting.h"
+#include "input-dependency/Analysis/ModuleSummary.h"
+#include "input-dependency/Analysis/PhaseTimer.h"
+#include "input-dependency/Analysis/ReachableFunctions.h"
 #include "input-dependency/Analysis/Utils.h"
 #include "input-dependency/Analysis/constants.h"
 
@@ -25,10 +33,17 @@
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
 
+// per function progress is printed with -debug-only=input-dep, as worker threads of drivers analyse modules concurrently
+#define DEBUG_TYPE "input-dep"
+
 namespace input_dependency {
 
 InputDependencyAnalysis::InputDependencyAnalysis(llvm::Module* M)
     : m_module(M)
+    , m_reachablesOnly(false)
+    , m_globalsInitAnaliserFound(false)
+    , m_globalsInitAnaliser(nullptr)
+    , m_streaming(false)
 {
     m_functionAnalysisGetter = [&] (llvm::Function* F) -> FunctionAnaliser* {
         auto pos = m_functionAnalisers.find(F);
@@ -75,27 +90,152 @@ void InputDependencyAnalysis::setDominatorTreeGetter(const DominatorTreeGetter&
     m_domTreeGetter = domTreeGetter;
 }
 
+void InputDependencyAnalysis::setStreaming(const FunctionMaterializer& materializer, const FunctionReleaser& releaser)
+{
+    m_streaming = true;
+    m_materializer = materializer;
+    m_releaser = releaser;
+}
+
 void InputDependencyAnalysis::run()
 {
-    llvm::scc_iterator<llvm::CallGraph*> CGI = llvm::scc_begin(m_callGraph);
-    llvm::CallGraphSCC CurSCC(*m_callGraph, &CGI);
-    while (!CGI.isAtEnd()) {
-        // Copy the current SCC and increment past it so that the pass can hack
-        // on the SCC if it wants to without invalidating our iterator.
-        const std::vector<llvm::CallGraphNode *> &NodeVec = *CGI;
-        CurSCC.initialize(NodeVec);
+    GlobalsIndex::get().add_module(*m_module);
+    if (m_streaming) {
+        runStreaming();
+        return;
+    }
+    if (InputDepConfig::get().has_link_file()) {
+        m_linkResult.read(InputDepConfig::get().get_link_file());
+    }
+    if (InputDepConfig::get().is_reachables_only()) {
+        collectReachableFunctions();
+    }
+    if (AnalysisTiers::get().is_enabled()) {
+        PhaseTimer timer("prepass");
+        AnalysisTiers::get().run(*m_module, *m_callGraph);
+    }
+    {
+        MemoryAccounting::Phase memory("analysis");
+        llvm::scc_iterator<llvm::CallGraph*> CGI = llvm::scc_begin(m_callGraph);
+        llvm::CallGraphSCC CurSCC(*m_callGraph, &CGI);
+        while (!CGI.isAtEnd()) {
+            // Copy the current SCC and increment past it so that the pass can hack
+            // on the SCC if it wants to without invalidating our iterator.
+            const std::vector<llvm::CallGraphNode *> &NodeVec = *CGI;
+            CurSCC.initialize(NodeVec);
+            // SCC is traced with its first function
+            PhaseTimer timer("SCC analysis", NodeVec.front()->getFunction());
+
+            for (llvm::CallGraphNode* node : CurSCC) {
+                llvm::Function* F = node->getFunction();
+                if (F == nullptr || Utils::isLibraryFunction(F, m_module)) {
+                    continue;
+                }
+                if (!isReachableFunction(F)) {
+                    runOnUnreachableFunction(F);
+                    continue;
+                }
+                if (AnalysisTiers::get().is_input_independent(F)) {
+                    runOnInputIndependentFunction(F);
+                    continue;
+                }
+                runOnFunction(F);
+            }
+            ++CGI;
+        }
+    }
+    if (AnalysisTiers::get().is_enabled()) {
+        countAnalysisTiers();
+    }
+    if (InputDepConfig::get().has_summary_file()) {
+        // summary keeps dependencies on arguments and globals, thus is written before finalization
+        writeModuleSummary();
+    }
+    {
+        MemoryAccounting::Phase memory("finalization");
+        doFinalization();
+    }
+    if (InputDepConfig::get().is_verify_merged_call_deps()) {
+        llvm::dbgs() << "Merged call dependencies verification: " << InputDepConfig::get().get_merged_call_deps_checks()
+                     << " checks, " << InputDepConfig::get().get_merged_call_deps_differences() << " differences\n";
+    }
+    if (InputDepConfig::get().is_compact_results()) {
+        compactResults();
+    }
+    accountRetainedMemory();
+    LLVM_DEBUG(llvm::dbgs() << "Finished input dependency analysis\n\n");
+}
 
-        for (llvm::CallGraphNode* node : CurSCC) {
+void InputDependencyAnalysis::runStreaming()
+{
+    MemoryAccounting::Phase memory("analysis");
+    ModuleSummary summary(*m_module);
+    // number of call edges from functions not analysed yet; calls from external node do not need results
+    std::unordered_map<llvm::Function*, unsigned> pendingCallers;
+    for (const auto& item : *m_callGraph) {
+        if (item.first == nullptr) {
+            continue;
+        }
+        for (const auto& callee : *item.second) {
+            if (llvm::Function* F = callee.second->getFunction()) {
+                ++pendingCallers[F];
+            }
+        }
+    }
+    unsigned long released = 0;
+    for (auto CGI = llvm::scc_begin(m_callGraph); !CGI.isAtEnd(); ++CGI) {
+        const std::vector<llvm::CallGraphNode*>& NodeVec = *CGI;
+        PhaseTimer timer("SCC analysis", NodeVec.front()->getFunction());
+        std::vector<llvm::Function*> sccFunctions;
+        for (llvm::CallGraphNode* node : NodeVec) {
             llvm::Function* F = node->getFunction();
             if (F == nullptr || Utils::isLibraryFunction(F, m_module)) {
                 continue;
             }
+            // all functions of SCC are materialized before any is analysed, as they call each other
+            if (!m_materializer(F)) {
+                llvm::dbgs() << "Stopped streaming input dependency analysis: can not materialize "
+                             << F->getName() << "\n";
+                return;
+            }
+            sccFunctions.push_back(F);
+        }
+        for (auto* F : sccFunctions) {
             runOnFunction(F);
         }
-        ++CGI;
+        for (auto* F : sccFunctions) {
+            summary.addFunction(F, *m_functionAnalisers[F]);
+        }
+        std::vector<llvm::Function*> candidates(sccFunctions);
+        for (llvm::CallGraphNode* node : NodeVec) {
+            if (node->getFunction() == nullptr) {
+                continue;
+            }
+            for (const auto& callee : *node) {
+                if (llvm::Function* F = callee.second->getFunction()) {
+                    --pendingCallers[F];
+                    candidates.push_back(F);
+                }
+            }
+        }
+        for (auto* F : candidates) {
+            if (pendingCallers[F] == 0 && m_functionAnalisers.find(F) != m_functionAnalisers.end()) {
+                releaseFunction(F);
+                ++released;
+            }
+        }
     }
-    doFinalization();
-    llvm::dbgs() << "Finished input dependency analysis\n\n";
+    if (summary.write(InputDepConfig::get().get_summary_file())) {
+        llvm::dbgs() << "Wrote module summary to " << InputDepConfig::get().get_summary_file() << "\n";
+    }
+    llvm::dbgs() << "Finished streaming input dependency analysis. Released " << released << " functions\n\n";
+}
+
+void InputDependencyAnalysis::releaseFunction(llvm::Function* F)
+{
+    // no caller is left to query results of F
+    m_functionAnalisers.erase(F);
+    m_releaser(F);
 }
 
 bool InputDependencyAnalysis::isInputDependent(llvm::Function* F, llvm::Instruction* instr) const
@@ -173,10 +313,70 @@ bool InputDependencyAnalysis::insertAnalysisInfo(llvm::Function* F, InputDepResT
     return true;
 }
 
+void InputDependencyAnalysis::collectReachableFunctions()
+{
+    const auto& entry_points = ReachableFunctions::collectEntryPoints(m_module,
+                                                                      InputDepConfig::get().get_entry_points(),
+                                                                      InputDepConfig::get().is_exported_entry_points());
+    if (entry_points.empty()) {
+        llvm::dbgs() << "No entry points found. Analyzing all functions\n";
+        return;
+    }
+    // analysis results are not available yet, reachability is computed with call graph and function uses
+    ReachableFunctions reachableFs(m_module, m_callGraph);
+    m_reachableFunctions = reachableFs.getReachableFunctions(entry_points);
+    m_reachablesOnly = true;
+    llvm::dbgs() << "Number of functions reachable from entry points " << m_reachableFunctions.size()
+                 << " out of " << reachableFs.getFunctionsCount() << "\n";
+}
+
+bool InputDependencyAnalysis::isReachableFunction(llvm::Function* F) const
+{
+    return !m_reachablesOnly || m_reachableFunctions.find(F) != m_reachableFunctions.end();
+}
+
+void InputDependencyAnalysis::runOnUnreachableFunction(llvm::Function* F)
+{
+    llvm::dbgs() << "Skip unreachable function " << F->getName() << "\n";
+    InputDepResType inputDepResult(new InputDependentFunctionAnalysisResult(F));
+    m_functionAnalisers.insert(std::make_pair(F, inputDepResult));
+}
+
+void InputDependencyAnalysis::runOnBudgetExceededFunction(llvm::Function* F, const std::string& reason)
+{
+    llvm::dbgs() << "Function " << F->getName() << " exceeded analysis budget: " << reason
+                 << ". Consider it input dependent\n";
+    // roll back what the aborted analysis recorded outside of its results
+    AnalysisBudget::get().discard_side_effects();
+    InputDepInstructionsRecorder::get().erase(F);
+    BasicBlocksUtils::get().removeFunctionUnreachableBlocks(F);
+    m_functionAnalisers.erase(F);
+    const auto& summary = AnalysisBudget::get().add_fallback_function(F, reason, m_functionAnalysisGetter);
+    auto inputDepResult = new InputDependentFunctionAnalysisResult(F);
+    inputDepResult->setCalledFunctions(summary.calledFunctions);
+    m_functionAnalisers.insert(std::make_pair(F, InputDepResType(inputDepResult)));
+    mergeCallSitesData(F, summary.calledFunctions);
+}
+
+void InputDependencyAnalysis::runOnInputIndependentFunction(llvm::Function* F)
+{
+    LLVM_DEBUG(llvm::dbgs() << "Input independent function " << F->getName() << "\n");
+    m_moduleFunctions.insert(m_moduleFunctions.begin(), F);
+    const auto& calledFunctions = AnalysisTiers::get().get_called_functions(F);
+    auto inputIndepResult = new InputIndependentFunctionAnalysisResult(F);
+    inputIndepResult->setCalledFunctions(calledFunctions);
+    m_functionAnalisers.insert(std::make_pair(F, InputDepResType(inputIndepResult)));
+    mergeCallSitesData(F, calledFunctions);
+}
+
 void InputDependencyAnalysis::runOnFunction(llvm::Function* F)
 {
-    llvm::dbgs() << "Processing function " << F->getName() << "\n";
+    LLVM_DEBUG(llvm::dbgs() << "Processing function " << F->getName() << "\n");
     m_moduleFunctions.insert(m_moduleFunctions.begin(), F);
+    if (AnalysisBudget::get().exceeds_instructions_budget(F)) {
+        runOnBudgetExceededFunction(F, "instructions");
+        return;
+    }
     llvm::AAResults* AAR = m_aliasAnalysisInfoGetter(F);
     llvm::LoopInfo* LI = m_loopInfoGetter(F);
     const llvm::PostDominatorTree* PDom = m_postDomTreeGetter(F);
@@ -191,7 +391,14 @@ void InputDependencyAnalysis::runOnFunction(llvm::Function* F)
     analyzer->setDomTree(dom);
     analyzer->setVirtualCallSiteAnalysisResult(m_virtualCallSiteAnalysisRes);
     analyzer->setIndirectCallSiteAnalysisResult(m_indirectCallSiteAnalysisRes);
-    analyzer->analyze();
+    try {
+        AnalysisBudget::Scope budget_scope(F);
+        analyzer->analyze();
+    } catch (const BudgetExceededException& e) {
+        runOnBudgetExceededFunction(F, e.reason());
+        return;
+    }
+    AnalysisBudget::get().commit_side_effects();
     const auto& calledFunctions = analyzer->getCallSitesData();
     mergeCallSitesData(F, calledFunctions);
 }
@@ -204,13 +411,13 @@ void InputDependencyAnalysis::doFinalization()
             // log message
             continue;
         }
-        llvm::dbgs() << "Finalizing " << F->getName() << "\n";
+        LLVM_DEBUG(llvm::dbgs() << "Finalizing " << F->getName() << "\n");
         if (InputDepConfig::get().is_input_dep_function(F)) {
-            llvm::dbgs() << "Mark Input dependent function " << F->getName() << "\n";
+            LLVM_DEBUG(llvm::dbgs() << "Mark Input dependent function " << F->getName() << "\n");
             pos->second->setIsInputDepFunction(true);
         }
         if (InputDepConfig::get().is_extracted_function(F)) {
-            llvm::dbgs() << "Mark extracted function. " << F->getName() << "\n";
+            LLVM_DEBUG(llvm::dbgs() << "Mark extracted function. " << F->getName() << "\n");
             pos->second->setIsExtractedFunction(true);
         }
         finalizeForGlobals(F, pos->second);
@@ -218,14 +425,91 @@ void InputDependencyAnalysis::doFinalization()
     }
 }
 
+void InputDependencyAnalysis::countAnalysisTiers() const
+{
+    auto& tiers = AnalysisTiers::get();
+    for (const auto& item : m_functionAnalisers) {
+        if (item.second->toInputIndependentFunctionAnalysisResult()) {
+            tiers.add_function_tier(AnalysisTiers::INPUT_INDEP);
+        } else if (item.second->toInputDependentFunctionAnalysisResult()) {
+            tiers.add_function_tier(AnalysisTiers::INPUT_DEP);
+        } else {
+            tiers.add_function_tier(AnalysisTiers::FULL);
+        }
+    }
+    llvm::dbgs() << "Analysis tiers: " << tiers.get_tier_count(AnalysisTiers::INPUT_INDEP) << " input independent, "
+                 << tiers.get_tier_count(AnalysisTiers::INPUT_DEP) << " input dependent, "
+                 << tiers.get_tier_count(AnalysisTiers::FULL) << " fully analyzed functions\n";
+}
+
+void InputDependencyAnalysis::compactResults()
+{
+    PhaseTimer timer("compaction");
+    for (auto& item : m_functionAnalisers) {
+        if (!item.second->toFunctionAnalysisResult()) {
+            continue;
+        }
+        // releases block and loop results of the function analiser
+        item.second.reset(new FrozenFunctionAnalysisResult(*item.second));
+    }
+    // cached analiser has been released
+    m_globalsInitAnaliserFound = false;
+    m_globalsInitAnaliser = nullptr;
+}
+
+void InputDependencyAnalysis::accountRetainedMemory() const
+{
+    if (!MemoryAccounting::get().is_enabled()) {
+        return;
+    }
+    MemoryUsage usage;
+    for (const auto& item : m_functionAnalisers) {
+        item.second->accountMemory(usage);
+    }
+    MemoryAccounting::get().set_retained_memory(usage);
+}
+
+void InputDependencyAnalysis::writeModuleSummary() const
+{
+    PhaseTimer timer("summary");
+    ModuleSummary summary(*m_module, m_functionAnalisers);
+    if (summary.write(InputDepConfig::get().get_summary_file())) {
+        llvm::dbgs() << "Wrote module summary to " << InputDepConfig::get().get_summary_file() << "\n";
+    }
+}
+
 void InputDependencyAnalysis::finalizeForArguments(llvm::Function* F, InputDepResType& FA)
 {
+    AnalysisCostRecorder::Scope cost_scope(F);
+    // callers in other modules, found by thin link
+    const auto* linkedArgDeps = m_linkResult.getArgumentDependencies(F->getName().str());
     auto f_analiser = FA->toFunctionAnalysisResult();
     if (!f_analiser) {
+        if (FA->toInputIndependentFunctionAnalysisResult()
+                && m_calleeCallersInfo.find(F) == m_calleeCallersInfo.end()
+                && !linkedArgDeps
+                && F->getName() != "main") {
+            // the same as for function analisers below, callees become input dependent too
+            FA->setIsInputDepFunction(true);
+            AnalysisTiers::get().mark_input_dep_function(F);
+        }
         return;
     }
 
+    DependencyAnaliser::ArgumentDependenciesMap linkedCallInfo;
+    if (linkedArgDeps) {
+        for (auto& arg : F->args()) {
+            auto pos = linkedArgDeps->find(arg.getArgNo());
+            const bool inputDep = pos != linkedArgDeps->end() && pos->second;
+            linkedCallInfo.insert(std::make_pair(&arg, ValueDepInfo(arg.getType(),
+                                                                    DepInfo(inputDep ? DepInfo::INPUT_DEP : DepInfo::INPUT_INDEP))));
+        }
+    }
     if (m_calleeCallersInfo.find(F) == m_calleeCallersInfo.end()) {
+        if (linkedArgDeps) {
+            f_analiser->finalizeArguments(linkedCallInfo);
+            return;
+        }
         DependencyAnaliser::ArgumentDependenciesMap arg_deps;
         for (auto& arg : F->args()) {
             arg_deps.insert(std::make_pair(&arg, ValueDepInfo(arg.getType(), DepInfo(DepInfo::INPUT_DEP))));
@@ -236,12 +520,14 @@ void InputDependencyAnalysis::finalizeForArguments(llvm::Function* F, InputDepRe
         }
         return;
     }
-    const auto& callInfo = getFunctionCallInfo(F);
+    auto callInfo = getFunctionCallInfo(F);
+    mergeDependencyMaps(callInfo, linkedCallInfo);
     f_analiser->finalizeArguments(callInfo);
 }
 
 void InputDependencyAnalysis::finalizeForGlobals(llvm::Function* F, InputDepResType& FA)
 {
+    AnalysisCostRecorder::Scope cost_scope(F);
     auto f_analiser = FA->toFunctionAnalysisResult();
     if (!f_analiser) {
         return;
@@ -268,7 +554,14 @@ DependencyAnaliser::ArgumentDependenciesMap InputDependencyAnalysis::getFunction
         assert(fpos != m_functionAnalisers.end());
         auto f_analiser = fpos->second->toFunctionAnalysisResult();
         if (!f_analiser) {
-            // assert?
+            if (AnalysisBudget::get().get_fallback_summary(caller)) {
+                // caller exceeded its budget, its call sites pass input dependent arguments
+                DependencyAnaliser::ArgumentDependenciesMap inputDepArgs;
+                for (auto& arg : F->args()) {
+                    inputDepArgs.insert(std::make_pair(&arg, ValueDepInfo(arg.getType(), DepInfo(DepInfo::INPUT_DEP))));
+                }
+                mergeDependencyMaps(argDeps, inputDepArgs);
+            }
             continue;
         }
         auto callInfo = f_analiser->getCallArgumentInfo(F);
@@ -303,6 +596,9 @@ DependencyAnaliser::GlobalVariableDependencyMap InputDependencyAnalysis::getFunc
         assert(fpos != m_functionAnalisers.end());
         auto f_analiser = fpos->second->toFunctionAnalysisResult();
         if (!f_analiser) {
+            if (AnalysisBudget::get().get_fallback_summary(caller)) {
+                addInputDependentGlobalsInfo(F, globalDeps);
+            }
             continue;
         }
         auto globalsInfo = f_analiser->getCallGlobalsInfo(F);
@@ -318,30 +614,40 @@ DependencyAnaliser::GlobalVariableDependencyMap InputDependencyAnalysis::getFunc
     return globalDeps;
 }
 
-template <class DependencyMapType>
-void InputDependencyAnalysis::mergeDependencyMaps(DependencyMapType& mergeTo, const DependencyMapType& mergeFrom)
+void InputDependencyAnalysis::addInputDependentGlobalsInfo(llvm::Function* F,
+                                                           DependencyAnaliser::GlobalVariableDependencyMap& globalDeps)
 {
-    for (const auto item : mergeFrom) {
-        // only input dependent arguments were collected
-        assert(item.second.isDefined());
-        //assert(item.second.isInputDep() || item.second.isInputIndep() || item.second.isInputArgumentDep());
-        auto res = mergeTo.insert(item);
-        if (!res.second) {
-            res.first->second.mergeDependencies(item.second);
-        }
-        assert(!res.first->second.isValueDep());
+    auto pos = m_functionAnalisers.find(F);
+    assert(pos != m_functionAnalisers.end());
+    auto f_analiser = pos->second->toFunctionAnalysisResult();
+    if (!f_analiser) {
+        return;
+    }
+    DependencyAnaliser::GlobalVariableDependencyMap inputDepGlobals;
+    for (const auto& global : f_analiser->getReferencedGlobals()) {
+        inputDepGlobals.insert(std::make_pair(global, ValueDepInfo(global->getType(), DepInfo(DepInfo::INPUT_DEP))));
     }
+    mergeDependencyMaps(globalDeps, inputDepGlobals);
 }
 
-void InputDependencyAnalysis::addMissingGlobalsInfo(llvm::Function* F, DependencyAnaliser::GlobalVariableDependencyMap& globalDeps)
+FunctionAnaliser* InputDependencyAnalysis::getGlobalsInitAnaliser()
 {
-    const std::string globalInitF("__cxx_global_var_init");
-    llvm::Function* initF = m_module->getFunction(globalInitF);
-    InputDependencyAnalysisInfo::iterator initFpos = m_functionAnalisers.end();
-    if (initF) {
-        initFpos = m_functionAnalisers.find(initF);
+    if (m_globalsInitAnaliserFound) {
+        return m_globalsInitAnaliser;
     }
+    m_globalsInitAnaliserFound = true;
+    if (llvm::Function* initF = m_module->getFunction("__cxx_global_var_init")) {
+        auto pos = m_functionAnalisers.find(initF);
+        if (pos != m_functionAnalisers.end()) {
+            m_globalsInitAnaliser = pos->second->toFunctionAnalysisResult();
+        }
+    }
+    return m_globalsInitAnaliser;
+}
 
+void InputDependencyAnalysis::addMissingGlobalsInfo(llvm::Function* F, DependencyAnaliser::GlobalVariableDependencyMap& globalDeps)
+{
+    auto* initF_analiser = getGlobalsInitAnaliser();
     auto pos = m_functionAnalisers.find(F);
     assert(pos != m_functionAnalisers.end());
     auto f_analiser = pos->second->toFunctionAnalysisResult();
@@ -350,15 +656,17 @@ void InputDependencyAnalysis::addMissingGlobalsInfo(llvm::Function* F, Dependenc
     }
     const auto& referencedGlobals = f_analiser->getReferencedGlobals();
     for (const auto& global : referencedGlobals) {
+        if (m_linkResult.isInputDepGlobal(global->getName().str())) {
+            // modified with input in other modules
+            globalDeps[global] = ValueDepInfo(global->getType(), DepInfo(DepInfo::INPUT_DEP));
+            continue;
+        }
         if (globalDeps.find(global) != globalDeps.end()) {
             continue;
         }
-        if (initFpos != m_functionAnalisers.end()) {
-            auto initF_analiser = initFpos->second->toFunctionAnalysisResult();
-            if (initF_analiser->hasGlobalVariableDepInfo(global)) {
-                globalDeps[global] = initF_analiser->getGlobalVariableDependencies(global);
-                continue;
-            }
+        if (initF_analiser && initF_analiser->hasGlobalVariableDepInfo(global)) {
+            globalDeps[global] = initF_analiser->getGlobalVariableDependencies(global);
+            continue;
         }
         globalDeps[global] = ValueDepInfo(global->getType(), DepInfo(DepInfo::INPUT_INDEP));
     }
@@ -1,11 +1,16 @@
 #include "input-dependency/Analysis/InputDependencyAnalysisPass.h"
 
+#include "input-dependency/Analysis/AnalysisBudget.h"
+#include "input-dependency/Analysis/AnalysisCostRecorder.h"
+#include "input-dependency/Analysis/AnalysisTiers.h"
 #include "input-dependency/Analysis/InputDependencyAnalysis.h"
 #include "input-dependency/Analysis/CachedInputDependencyAnalysis.h"
 #include "input-dependency/Analysis/InputDependencyStatistics.h"
 #include "input-dependency/Analysis/IndirectCallSitesAnalysis.h"
 #include "input-dependency/Analysis/InputDepConfig.h"
 #include "input-dependency/Analysis/InputDepInstructionsRecorder.h"
+#include "input-dependency/Analysis/MemoryAccounting.h"
+#include "input-dependency/Analysis/PhaseTimer.h"
 #include "input-dependency/Analysis/ReachableFunctions.h"
 #include "input-dependency/Analysis/constants.h"
 
@@ -28,6 +33,8 @@
 
 #include <cassert>
 
+#define DEBUG_TYPE "input-dep"
+
 namespace input_dependency {
 
 static llvm::cl::opt<bool> goto_unsafe(
@@ -35,6 +42,12 @@ static llvm::cl::opt<bool> goto_unsafe(
     llvm::cl::desc("Process irregular CFG in an unsafe way"),
     llvm::cl::value_desc("boolean flag"));
 
+static llvm::cl::opt<unsigned> irreducible_region_iterations(
+    "input-dep-irreducible-region-iterations",
+    llvm::cl::desc("Consider irreducible regions not converging in given number of iterations input dependent"),
+    llvm::cl::value_desc("number of iterations"),
+    llvm::cl::init(16));
+
 static llvm::cl::opt<std::string> libfunction_config(
     "lib-config",
     llvm::cl::desc("Configuration file for library functions"),
@@ -55,6 +68,56 @@ static llvm::cl::opt<std::string> stats_file(
     llvm::cl::desc("Statistics file"),
     llvm::cl::value_desc("file name"));
 
+static llvm::cl::opt<unsigned> stats_top_functions(
+    "dependency-stats-top",
+    llvm::cl::desc("Record analysis cost of each function and report given number of slowest and largest functions in statistics"),
+    llvm::cl::value_desc("number of functions"),
+    llvm::cl::init(0));
+
+static llvm::cl::opt<bool> stats_memory(
+    "dependency-stats-memory",
+    llvm::cl::desc("Report peak memory of analysis phases and memory retained by results in statistics"),
+    llvm::cl::value_desc("boolean flag"));
+
+static llvm::cl::opt<bool> compact_results(
+    "input-dep-compact-results",
+    llvm::cl::desc("Keep only compact classification of finalized results. Ignored when a pass needs to clone results"),
+    llvm::cl::init(true));
+
+static llvm::cl::opt<unsigned> budget_instructions(
+    "input-dep-budget-instructions",
+    llvm::cl::desc("Consider functions with more instructions input dependent, without analysing them"),
+    llvm::cl::value_desc("number of instructions"),
+    llvm::cl::init(0));
+
+static llvm::cl::opt<unsigned> budget_alias_queries(
+    "input-dep-budget-alias-queries",
+    llvm::cl::desc("Stop analysis of a function after given number of alias queries and consider it input dependent"),
+    llvm::cl::value_desc("number of queries"),
+    llvm::cl::init(0));
+
+static llvm::cl::opt<unsigned> budget_loop_reflections(
+    "input-dep-budget-loop-reflections",
+    llvm::cl::desc("Stop analysis of a function after given number of values reflected in loops and consider it input dependent"),
+    llvm::cl::value_desc("number of iterations"),
+    llvm::cl::init(0));
+
+static llvm::cl::opt<unsigned> budget_time(
+    "input-dep-budget-time-ms",
+    llvm::cl::desc("Stop analysis of a function after given wall time and consider it input dependent"),
+    llvm::cl::value_desc("milliseconds"),
+    llvm::cl::init(0));
+
+static llvm::cl::opt<bool> prepass(
+    "input-dep-prepass",
+    llvm::cl::desc("Find trivially input independent functions with a fast prepass and do not analyse them"),
+    llvm::cl::value_desc("boolean flag"));
+
+static llvm::cl::opt<bool> verify_merged_call_deps(
+    "input-dep-verify-merged-call-deps",
+    llvm::cl::desc("Check dependencies merged over call sites against merging all call sites again. For debugging"),
+    llvm::cl::value_desc("boolean flag"));
+
 static llvm::cl::opt<bool> use_cache(
     "use-cache",
     llvm::cl::desc("Cache input dependency results"),
@@ -65,19 +128,79 @@ static llvm::cl::opt<bool> mark_main_reachables(
         llvm::cl::desc("Mark functions reachable from main"),
         llvm::cl::value_desc("boolean flag"));
 
+static llvm::cl::opt<bool> reachables_only(
+        "reachables-only",
+        llvm::cl::desc("Analyze only functions reachable from entry points. Other functions are considered input dependent"),
+        llvm::cl::value_desc("boolean flag"));
+
+static llvm::cl::list<std::string> entry_points(
+        "entry-points",
+        llvm::cl::desc("Comma separated list of entry functions for -reachables-only. main is used if none is given"),
+        llvm::cl::value_desc("function names"),
+        llvm::cl::CommaSeparated);
+
+static llvm::cl::opt<bool> exported_entry_points(
+        "exported-entry-points",
+        llvm::cl::desc("Consider all externally visible functions as entry points for -reachables-only"),
+        llvm::cl::value_desc("boolean flag"));
+
+static llvm::cl::opt<bool> time_phases(
+        "input-dep-time-phases",
+        llvm::cl::desc("Time analysis and transformation phases. Enabled by -time-passes too"),
+        llvm::cl::value_desc("boolean flag"));
+
+static llvm::cl::opt<std::string> trace_file(
+        "input-dep-trace-file",
+        llvm::cl::desc("Write analysis and transformation phases of each function as Chrome trace events"),
+        llvm::cl::value_desc("file name"));
+
+static llvm::cl::opt<std::string> summary_file(
+        "input-dep-summary",
+        llvm::cl::desc("Write summary of the module for thin link of input dependency results across modules"),
+        llvm::cl::value_desc("file name"));
+
+static llvm::cl::opt<std::string> link_file(
+        "input-dep-link-result",
+        llvm::cl::desc("Use thin link results of the module, written by input-dep-link"),
+        llvm::cl::value_desc("file name"));
+
 void configure_run()
 {
     InputDepInstructionsRecorder::get().set_record();
     InputDepConfig::get().set_goto_unsafe(goto_unsafe);
+    InputDepConfig::get().set_irreducible_region_iterations(irreducible_region_iterations);
     InputDepConfig::get().set_lib_config_file(libfunction_config);
     InputDepConfig::get().set_use_cache(use_cache);
+    InputDepConfig::get().set_reachables_only(reachables_only);
+    InputDepConfig::get().set_entry_points(std::vector<std::string>(entry_points.begin(), entry_points.end()));
+    InputDepConfig::get().set_exported_entry_points(exported_entry_points);
+    InputDepConfig::get().set_compact_results(compact_results);
+    InputDepConfig::get().set_verify_merged_call_deps(verify_merged_call_deps);
+    PhaseTimers::get().set_print_timers(time_phases);
+    PhaseTimers::get().set_trace_file(trace_file);
+    AnalysisCostRecorder::get().set_record(stats && stats_top_functions != 0);
+    MemoryAccounting::get().set_enabled(stats && stats_memory);
+    FunctionAnalysisBudget budget;
+    budget.instructions = budget_instructions;
+    budget.alias_queries = budget_alias_queries;
+    budget.loop_reflected_values = budget_loop_reflections;
+    budget.wall_ms = budget_time;
+    AnalysisBudget::get().set_budget(budget);
+    AnalysisTiers::get().set_enabled(prepass);
+    // drivers may set these for each module
+    if (!summary_file.empty()) {
+        InputDepConfig::get().set_summary_file(summary_file);
+    }
+    if (!link_file.empty()) {
+        InputDepConfig::get().set_link_file(link_file);
+    }
 }
 
 char InputDependencyAnalysisPass::ID = 0;
 
 bool InputDependencyAnalysisPass::runOnModule(llvm::Module& M)
 {
-    llvm::dbgs() << "Running input dependency analysis pass\n";
+    LLVM_DEBUG(llvm::dbgs() << "Running input dependency analysis pass\n");
     configure_run();
     m_module = &M;
 
@@ -105,12 +228,19 @@ bool InputDependencyAnalysisPass::runOnModule(llvm::Module& M)
         mark_main_reachable_functions(reachable_functions);
         modified = true;
     }
-    if (stats) {
+    if (stats || InputDepConfig::get().has_stats_file()) {
         dump_statistics(reachable_functions);
     }
     return modified;
 }
 
+bool InputDependencyAnalysisPass::doFinalization(llvm::Module& M)
+{
+    // transformation passes using the analysis have finished by now
+    PhaseTimers::get().report();
+    return false;
+}
+
 void InputDependencyAnalysisPass::getAnalysisUsage(llvm::AnalysisUsage& AU) const
 {
     AU.setPreservesCFG();
@@ -202,7 +332,7 @@ void InputDependencyAnalysisPass::mark_main_reachable_functions(const std::unord
 
 void InputDependencyAnalysisPass::dump_statistics(const std::unordered_set<llvm::Function*>& functions)
 {
-    std::string file_name = stats_file;
+    std::string file_name = InputDepConfig::get().has_stats_file() ? InputDepConfig::get().get_stats_file() : stats_file;
     if (file_name.empty()) {
         file_name = "stats";
     }
@@ -216,6 +346,7 @@ void InputDependencyAnalysisPass::dump_statistics(const std::unordered_set<llvm:
                                     &m_analysis->getAnalysisInfo());
     stats.setLoopInfoGetter(loopInfoGetter);
     stats.setFunctions(functions);
+    stats.setTopFunctionsCount(stats_top_functions);
     stats.setSectionName("inputdep_stats");
     stats.report();
     stats.flush();
@@ -1,6 +1,9 @@
 #include "input-dependency/Analysis/InputDependencyStatistics.h"
 #include "input-dependency/Analysis/InputDependencyAnalysisPass.h"
+#include "input-dependency/Analysis/AnalysisBudget.h"
+#include "input-dependency/Analysis/AnalysisTiers.h"
 #include "input-dependency/Analysis/FunctionInputDependencyResultInterface.h"
+#include "input-dependency/Analysis/MemoryAccounting.h"
 #include "input-dependency/Analysis/Utils.h"
 
 #include "llvm/IR/Function.h"
@@ -14,6 +17,8 @@
 #include "llvm/PassRegistry.h"
 #include "llvm/Transforms/IPO/PassManagerBuilder.h"
 
+#include <algorithm>
+
 namespace input_dependency {
 
 namespace {
@@ -29,15 +34,10 @@ unsigned get_function_instrs_count(llvm::Function& F)
 unsigned get_argument_dependent_instr_count(llvm::Function& F,
                                             InputDependencyAnalysisInterface::InputDepResType& FA)
 {
-    unsigned argument_dep_instr_count = 0;
-    for (auto& B : F) {
-        for (auto& I : B) {
-            if (!FA->isDataDependent(&I) && FA->isArgumentDependent(&I)) {
-                ++argument_dep_instr_count;
-            }
-        }
-    }
-    return argument_dep_instr_count;
+    const auto& classification = FA->getInstructionClassification();
+    llvm::BitVector argument_dep_instrs = classification.getPlane(InstructionClassification::ARGUMENT_DEP);
+    argument_dep_instrs.reset(classification.getPlane(InstructionClassification::DATA_DEP));
+    return argument_dep_instrs.count();
 }
 
 unsigned get_argument_or_data_dependent_loop_instr_count(llvm::Function& F,
@@ -86,12 +86,29 @@ void InputDependencyStatistics::setFunctions(const std::unordered_set<llvm::Func
     m_functions = functions;
 }
 
+void InputDependencyStatistics::setTopFunctionsCount(unsigned count)
+{
+    m_topFunctionsCount = count;
+}
+
 void InputDependencyStatistics::report()
 {
     reportInputDependencyInfo();
     reportInputDepCoverage();
     reportInputInDepCoverage();
     reportDataInpdependentCoverage();
+    if (m_topFunctionsCount != 0) {
+        reportAnalysisCost();
+    }
+    if (MemoryAccounting::get().is_enabled()) {
+        reportMemoryUsage();
+    }
+    if (AnalysisBudget::get().has_budget()) {
+        reportBudgetFallbacks();
+    }
+    if (AnalysisTiers::get().is_enabled()) {
+        reportAnalysisTiers();
+    }
 }
 
 void InputDependencyStatistics::reportInputDependencyInfo()
@@ -237,6 +254,89 @@ void InputDependencyStatistics::reportDataInpdependentCoverage()
     unsetStatsTypeName();
 }
 
+void InputDependencyStatistics::reportAnalysisCost()
+{
+    setStatsTypeName("analysis_cost");
+    using FunctionCost = std::pair<llvm::Function*, FunctionAnalysisCost>;
+    std::vector<FunctionCost> costs;
+    for (const auto& item : AnalysisCostRecorder::get().get_costs()) {
+        if (skip_function(item.first)) {
+            continue;
+        }
+        report_analysis_cost_data(item.first->getName(), item.second);
+        costs.push_back(item);
+    }
+
+    const std::string module_name = m_module->getName().str();
+    const unsigned top_count = std::min<std::size_t>(m_topFunctionsCount, costs.size());
+    std::vector<std::string> slowest_functions;
+    std::partial_sort(costs.begin(), costs.begin() + top_count, costs.end(),
+                      [] (const FunctionCost& cost1, const FunctionCost& cost2)
+                      { return cost1.second.wall_ms > cost2.second.wall_ms; });
+    for (unsigned i = 0; i < top_count; ++i) {
+        slowest_functions.push_back(costs[i].first->getName().str() + " "
+                                    + std::to_string(costs[i].second.wall_ms) + " ms");
+    }
+    write_entry(module_name, "SlowestFunctions", slowest_functions);
+
+    std::vector<std::string> largest_functions;
+    std::partial_sort(costs.begin(), costs.begin() + top_count, costs.end(),
+                      [] (const FunctionCost& cost1, const FunctionCost& cost2)
+                      { return cost1.second.allocated_bytes > cost2.second.allocated_bytes; });
+    for (unsigned i = 0; i < top_count; ++i) {
+        largest_functions.push_back(costs[i].first->getName().str() + " "
+                                    + std::to_string(costs[i].second.allocated_bytes / 1024) + " KB");
+    }
+    write_entry(module_name, "LargestFunctions", largest_functions);
+    unsetStatsTypeName();
+}
+
+void InputDependencyStatistics::reportMemoryUsage()
+{
+    setStatsTypeName("memory_usage");
+    for (const auto& phase : MemoryAccounting::get().get_phases()) {
+        write_entry(phase.name, "RSSBeforeKB", phase.rss_before_kb);
+        write_entry(phase.name, "PeakGrowthKB", phase.peak_growth_kb);
+        write_entry(phase.name, "RSSAfterKB", phase.rss_after_kb);
+    }
+    const std::string module_name = m_module->getName().str();
+    const auto& retained = MemoryAccounting::get().get_retained_memory();
+    write_entry(module_name, "ValueMapsKB", retained.value_maps / 1024);
+    write_entry(module_name, "CallDepInfoKB", retained.call_dep_info / 1024);
+    write_entry(module_name, "CompositeValuesKB", retained.composite_values / 1024);
+    write_entry(module_name, "ResultSetsKB", retained.result_sets / 1024);
+    write_entry(module_name, "RetainedTotalKB", retained.total() / 1024);
+    unsetStatsTypeName();
+}
+
+void InputDependencyStatistics::reportBudgetFallbacks()
+{
+    setStatsTypeName("analysis_budget");
+    std::vector<std::string> fallback_functions;
+    for (const auto& item : AnalysisBudget::get().get_fallback_functions()) {
+        if (skip_function(item.first)) {
+            continue;
+        }
+        fallback_functions.push_back(item.first->getName().str() + " " + item.second.reason);
+    }
+    std::sort(fallback_functions.begin(), fallback_functions.end());
+    const std::string module_name = m_module->getName().str();
+    write_entry(module_name, "FallbackFunctionsCount", static_cast<unsigned>(fallback_functions.size()));
+    write_entry(module_name, "FallbackFunctions", fallback_functions);
+    unsetStatsTypeName();
+}
+
+void InputDependencyStatistics::reportAnalysisTiers()
+{
+    setStatsTypeName("analysis_tiers");
+    const auto& tiers = AnalysisTiers::get();
+    const std::string module_name = m_module->getName().str();
+    write_entry(module_name, "InputIndepFunctions", static_cast<unsigned>(tiers.get_tier_count(AnalysisTiers::INPUT_INDEP)));
+    write_entry(module_name, "InputDepFunctions", static_cast<unsigned>(tiers.get_tier_count(AnalysisTiers::INPUT_DEP)));
+    write_entry(module_name, "FullyAnalyzedFunctions", static_cast<unsigned>(tiers.get_tier_count(AnalysisTiers::FULL)));
+    unsetStatsTypeName();
+}
+
 void InputDependencyStatistics::invalidate_stats_data()
 {
     m_function_input_dep_function_coverage_data.clear();
@@ -299,6 +399,18 @@ void InputDependencyStatistics::report_data_indep_coverage_data(const data_indep
     write_entry(data.name, "DataIndepCoverage", data_indep_cov);
 }
 
+void InputDependencyStatistics::report_analysis_cost_data(const std::string& name, const FunctionAnalysisCost& cost)
+{
+    write_entry(name, "WallTimeMs", cost.wall_ms);
+    write_entry(name, "AliasQueries", cost.alias_queries);
+    write_entry(name, "MapMerges", cost.map_merges);
+    write_entry(name, "PropagatedValues", cost.propagated_values);
+    write_entry(name, "LoopReflectedValues", cost.loop_reflected_values);
+    write_entry(name, "SaturatedReflections", cost.saturated_reflections);
+    write_entry(name, "SaturatedFinalizations", cost.saturated_finalizations);
+    write_entry(name, "AllocatedKB", cost.allocated_bytes / 1024);
+}
+
 void InputDependencyStatistics::update_module_coverage_data(
                                      input_dep_coverage_data& module_coverage_data,
                                      const input_dep_coverage_data& function_coverage_data) const
@@ -96,13 +96,11 @@ void InputDependentFunctionsPass::process_call(llvm::Function* parentF,
         erase_from_deterministic_functions(targets);
         return;
     }
-    auto domNode = domTree.get_function_dominators(parentF);
-    auto& dominators = domNode->get_dominators();
-    for (auto& dom : dominators) {
+    const auto& callers = domTree.get_callers(parentF);
+    for (auto& dom_F : callers) {
         if (is_non_det_caller) {
             break;
         }
-        auto dom_F = dom->get_function();
         if (functions_called_in_non_det_blocks.find(dom_F) != functions_called_in_non_det_blocks.end()) {
             is_non_det_caller = true;
             break;
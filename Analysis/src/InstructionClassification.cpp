@@ -0,0 +1,60 @@
+#include "input-dependency/Analysis/InstructionClassification.h"
+
+#include "input-dependency/Analysis/FunctionInputDependencyResultInterface.h"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instruction.h"
+
+namespace input_dependency {
+
+namespace {
+
+unsigned get_instructions_count(llvm::Function* F)
+{
+    unsigned count = 0;
+    for (auto& B : *F) {
+        count += B.size();
+    }
+    return count;
+}
+
+}
+
+InstructionClassification::InstructionClassification(unsigned instructionsCount)
+{
+    for (auto& plane : m_planes) {
+        plane.resize(instructionsCount);
+    }
+}
+
+InstructionClassification::InstructionClassification(FunctionInputDependencyResultInterface& result)
+    : InstructionClassification(get_instructions_count(result.getFunction()))
+{
+    unsigned index = 0;
+    for (auto& B : *result.getFunction()) {
+        for (auto& I : B) {
+            if (result.isInputDependent(&I)) {
+                set(INPUT_DEP, index);
+            }
+            if (result.isInputIndependent(&I)) {
+                set(INPUT_INDEP, index);
+            }
+            if (result.isControlDependent(&I)) {
+                set(CONTROL_DEP, index);
+            }
+            if (result.isDataDependent(&I)) {
+                set(DATA_DEP, index);
+            }
+            if (result.isArgumentDependent(&I)) {
+                set(ARGUMENT_DEP, index);
+            }
+            if (result.isGlobalDependent(&I)) {
+                set(GLOBAL_DEP, index);
+            }
+            ++index;
+        }
+    }
+}
+
+} // namespace input_dependency
+
@@ -1,3 +1,4 @@
+#include "input-dependency/Analysis/AnalysisContext.h"
 #include "input-dependency/Analysis/LibFunctionInfo.h"
 #include "input-dependency/Analysis/LibraryInfoManager.h"
 #include "input-dependency/Analysis/CLibraryInfo.h"
@@ -12,8 +13,7 @@ namespace input_dependency {
 
 LibraryInfoManager& LibraryInfoManager::get()
 {
-    static LibraryInfoManager libraryInfo;
-    return libraryInfo;
+    return AnalysisContext::get().get_library_info();
 }
 
 LibraryInfoManager::LibraryInfoManager()
@@ -21,11 +21,17 @@ LibraryInfoManager::LibraryInfoManager()
     setup();
 }
 
+LibraryInfoManager::LibraryInfoManager(const SharedLibFunctionInfoMap& libraryModels)
+    : m_libraryModels(libraryModels)
+{
+}
+
 void LibraryInfoManager::setup()
 {
+    auto libraryModels = std::make_shared<LibFunctionInfoMap>();
     const auto& libFunctionCollector =
-                    [this] (LibFunctionInfo&& libFunctionInfo) {
-                        this->addLibFunctionInfo(std::move(libFunctionInfo));
+                    [&libraryModels] (LibFunctionInfo&& libFunctionInfo) {
+                        libraryModels->emplace(libFunctionInfo.getName(), std::move(libFunctionInfo));
                     };
     // C library functions
     CLibraryInfo clibInfo(libFunctionCollector);
@@ -41,38 +47,38 @@ void LibraryInfoManager::setup()
         LibraryInfoFromConfigFile configInfo(libFunctionCollector, InputDepConfig::get().get_config_file());
         configInfo.setup();
     }
+    // functions defined in other modules, with dependencies computed by thin link
+    if (InputDepConfig::get().has_link_file()) {
+        LibraryInfoFromConfigFile linkInfo(libFunctionCollector, InputDepConfig::get().get_link_file());
+        linkInfo.setup();
+    }
+    m_libraryModels = libraryModels;
 }
 
 bool LibraryInfoManager::hasLibFunctionInfo(const std::string& funcName) const
 {
-    return m_libraryInfo.find(funcName) != m_libraryInfo.end();
+    return m_libraryModels->find(funcName) != m_libraryModels->end();
 }
 
 const LibFunctionInfo& LibraryInfoManager::getLibFunctionInfo(const std::string& funcName) const
 {
-    auto pos = m_libraryInfo.find(funcName);
-    assert(pos != m_libraryInfo.end());
+    auto resolved_pos = m_resolvedInfo.find(funcName);
+    if (resolved_pos != m_resolvedInfo.end()) {
+        return resolved_pos->second;
+    }
+    auto pos = m_libraryModels->find(funcName);
+    assert(pos != m_libraryModels->end());
     return pos->second;
 }
 
 void LibraryInfoManager::resolveLibFunctionInfo(llvm::Function* F, const std::string& demangledName)
 {
-    const auto& libF = getLibFunctionInfo(demangledName);
-    if (libF.isResolved()) {
+    if (m_resolvedInfo.find(demangledName) != m_resolvedInfo.end()) {
         return;
     }
-    const_cast<LibFunctionInfo&>(libF).resolve(F);
-}
-
-void LibraryInfoManager::addLibFunctionInfo(const LibFunctionInfo& funcInfo)
-{
-    m_libraryInfo.emplace(funcInfo.getName(), funcInfo);
-}
-
-void LibraryInfoManager::addLibFunctionInfo(LibFunctionInfo&& funcInfo)
-{
-    m_libraryInfo.emplace(funcInfo.getName(), std::move(funcInfo));
+    // shared models stay unresolved, resolve a copy
+    auto res = m_resolvedInfo.emplace(demangledName, getLibFunctionInfo(demangledName));
+    res.first->second.resolve(F);
 }
 
 } // namespace input_dependency
-
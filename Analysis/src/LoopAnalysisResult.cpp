@@ -1,10 +1,13 @@
 #include "input-dependency/Analysis/LoopAnalysisResult.h"
 
+#include "input-dependency/Analysis/AnalysisCostRecorder.h"
 #include "input-dependency/Analysis/ReflectingBasicBlockAnaliser.h"
 #include "input-dependency/Analysis/InputDependentBasicBlockAnaliser.h"
 #include "input-dependency/Analysis/NonDeterministicReflectingBasicBlockAnaliser.h"
-#include "input-dependency/Analysis/LoopTraversalPath.h"
+#include "input-dependency/Analysis/CFGTraversalOrder.h"
 #include "input-dependency/Analysis/IndirectCallSitesAnalysis.h"
+#include "input-dependency/Analysis/MemoryAccounting.h"
+#include "input-dependency/Analysis/PhaseTimer.h"
 #include "input-dependency/Analysis/Utils.h"
 
 #include "llvm/Analysis/AliasAnalysis.h"
@@ -22,8 +25,6 @@
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
 
-#include <chrono>
-
 namespace input_dependency {
 
 LoopAnalysisResult::LoopAnalysisResult(llvm::Function* F,
@@ -34,7 +35,8 @@ LoopAnalysisResult::LoopAnalysisResult(llvm::Function* F,
                                        const Arguments& inputs,
                                        const FunctionAnalysisGetter& Fgetter,
                                        llvm::Loop& L,
-                                       llvm::LoopInfo& LI)
+                                       llvm::LoopInfo& LI,
+                                       const CFGTraversalOrder& traversalOrder)
                                 : m_F(F)
                                 , m_AAR(AAR)
                                 , m_postDomTree(PDom)
@@ -44,6 +46,7 @@ LoopAnalysisResult::LoopAnalysisResult(llvm::Function* F,
                                 , m_FAG(Fgetter)
                                 , m_L(L)
                                 , m_LI(LI)
+                                , m_traversalOrder(traversalOrder)
                                 , m_returnValueDependencies(F->getReturnType())
                                 , m_globalsUpdated(false)
                                 , m_isReflected(false)
@@ -63,19 +66,18 @@ DepInfo LoopAnalysisResult::getBlockDependencies() const
 
 void LoopAnalysisResult::gatherResults()
 {
-    typedef std::chrono::high_resolution_clock Clock;
-    auto tic = Clock::now();
+    // nested loops are timed as part of outermost loop
+    PhaseTimer timer("loop analysis", m_F);
 
-    LoopTraversalPathCreator pathCreator(m_LI, m_L);
-    pathCreator.construct();
-    auto blocks = pathCreator.getPath();
+    const auto& nodes = m_traversalOrder.getLevelNodes(&m_L);
 
     //llvm::dbgs() << "Loop will be traversed in order\n";
-    //for (const auto& block : blocks) {
-    //    llvm::dbgs() << block->getName() << "\n";
+    //for (const auto& node : nodes) {
+    //    llvm::dbgs() << node.first->getName() << "\n";
     //}
 
-    for (const auto& B : blocks) {
+    for (const auto& node : nodes) {
+        llvm::BasicBlock* B = node.first;
         updateLoopDependecies(B);
         m_BBAnalisers[B] = createDependencyAnaliser(B);
         auto& analiser = m_BBAnalisers[B];
@@ -93,12 +95,6 @@ void LoopAnalysisResult::gatherResults()
     updateCallbacks();
     updateValueDependencies();
     reflectValueDepsOnLoopDeps();
-
-    auto toc = Clock::now();
-    // only for outer most loops, as it includes analysis of child loops
-    if (getenv("LOOP_TIME") && m_L.getLoopDepth() == 1) {
-        llvm::dbgs() << "Loop elapsed time " << std::chrono::duration_cast<std::chrono::nanoseconds>(toc - tic).count() << "\n";
-    }
 }
 
 void LoopAnalysisResult::finalizeResults(const DependencyAnaliser::ArgumentDependenciesMap& dependentArgs)
@@ -127,6 +123,18 @@ void LoopAnalysisResult::dumpResults() const
     }
 }
 
+void LoopAnalysisResult::accountMemory(MemoryUsage& usage) const
+{
+    usage.addArgumentDependencies(m_outArgDependencies);
+    usage.addValueDep(m_returnValueDependencies);
+    usage.addFunctionCallsInfo(m_functionCallInfo);
+    usage.addValueDependencies(m_initialDependencies);
+    usage.addValueDependencies(m_valueDependencies);
+    for (const auto& item : m_BBAnalisers) {
+        item.second->accountMemory(usage);
+    }
+}
+
 void LoopAnalysisResult::setLoopDependencies(const DepInfo& loopDeps)
 {
     m_loopDependencies = loopDeps;
@@ -518,6 +526,7 @@ DependencyAnaliser::ValueDependencies LoopAnalysisResult::getBasicBlockPredecess
                 pos.first->second.getValueDep().mergeDependencies(dep.second.getValueDep());
             }
         }
+        AnalysisCostRecorder::get().count_map_merge(valueDeps.size());
         ++pred;
     }
     // add initial values. Note values which have been added from prdecessors are not going to be changed
@@ -538,6 +547,7 @@ DependencyAnaliser::ArgumentDependenciesMap LoopAnalysisResult::getBasicBlockPre
                     pos.first->second.mergeDependencies(item.second);
                 }
             }
+            AnalysisCostRecorder::get().count_map_merge(m_outArgDependencies.size());
             ++pred;
             continue;
         }
@@ -554,6 +564,7 @@ DependencyAnaliser::ArgumentDependenciesMap LoopAnalysisResult::getBasicBlockPre
                 pos.first->second.mergeDependencies(dep.second);
             }
         }
+        AnalysisCostRecorder::get().count_map_merge(argDeps.size());
         ++pred;
     }
     return deps;
@@ -700,7 +711,7 @@ void LoopAnalysisResult::updateReferencedGlobals()
 {
     for (const auto& item : m_BBAnalisers) {
         const auto& refGlobals = item.second->getReferencedGlobals();
-        m_referencedGlobals.insert(refGlobals.begin(), refGlobals.end());
+        m_referencedGlobals.insert(refGlobals);
     }
 }
 
@@ -708,12 +719,13 @@ void LoopAnalysisResult::updateModifiedGlobals()
 {
     for (const auto& item : m_BBAnalisers) {
         const auto& modGlobals = item.second->getModifiedGlobals();
-        m_modifiedGlobals.insert(modGlobals.begin(), modGlobals.end());
+        m_modifiedGlobals.insert(modGlobals);
     }
 }
 
 void LoopAnalysisResult::reflect()
 {
+    PhaseTimer timer("loop reflection", m_F);
     DependencyAnaliser::ValueDependencies valueDependencies;
     for (const auto& latch : m_latches) {
         auto pos = m_BBAnalisers.find(latch);
@@ -734,6 +746,7 @@ void LoopAnalysisResult::reflect()
                 res.first->second.getValueDep().mergeDependencies(dep.second.getValueDep());
             }
         }
+        AnalysisCostRecorder::get().count_map_merge(valueDeps.size());
         auto initialValueDeps = pos->second->getInitialValuesDependencies();
         for (const auto& dep : initialValueDeps) {
             auto res = valueDependencies.insert(dep);
@@ -741,6 +754,7 @@ void LoopAnalysisResult::reflect()
                 res.first->second.getValueDep().mergeDependencies(dep.second.getValueDep());
             }
         }
+        AnalysisCostRecorder::get().count_map_merge(initialValueDeps.size());
     }
     reflect(valueDependencies, m_loopDependencies);
 }
@@ -753,7 +767,8 @@ LoopAnalysisResult::ReflectingDependencyAnaliserT LoopAnalysisResult::createDepe
         LoopAnalysisResult* loopAnalysisResult = new LoopAnalysisResult(m_F, m_AAR, m_postDomTree,
                                                                         m_virtualCallsInfo,
                                                                         m_indirectCallsInfo,
-                                                                        m_inputs, m_FAG, *block_loop, m_LI);
+                                                                        m_inputs, m_FAG, *block_loop, m_LI,
+                                                                        m_traversalOrder);
         loopAnalysisResult->setLoopDependencies(depInfo);
         collectLoopBlocks(block_loop);
         return ReflectingDependencyAnaliserT(loopAnalysisResult);
@@ -899,7 +914,8 @@ LoopAnalysisResult::ReflectingDependencyAnaliserT LoopAnalysisResult::createInpu
         LoopAnalysisResult* loopAnalysisResult = new LoopAnalysisResult(m_F, m_AAR, m_postDomTree,
                                                                         m_virtualCallsInfo,
                                                                         m_indirectCallsInfo,
-                                                                        m_inputs, m_FAG, *block_loop, m_LI);
+                                                                        m_inputs, m_FAG, *block_loop, m_LI,
+                                                                        m_traversalOrder);
         loopAnalysisResult->setLoopDependencies(DepInfo(DepInfo::INPUT_DEP));
         collectLoopBlocks(block_loop);
         return ReflectingDependencyAnaliserT(loopAnalysisResult);
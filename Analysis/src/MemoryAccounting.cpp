@@ -0,0 +1,154 @@
+#include "input-dependency/Analysis/MemoryAccounting.h"
+
+#include <sys/resource.h>
+
+#include <fstream>
+#include <string>
+
+namespace input_dependency {
+
+namespace {
+
+// Returns value of given field of /proc/self/status in KB, 0 if not available.
+unsigned long read_proc_status_kb(const std::string& field)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, field.size(), field) == 0) {
+            return std::stoul(line.substr(field.size()));
+        }
+    }
+    return 0;
+}
+
+unsigned long current_rss_kb()
+{
+    return read_proc_status_kb("VmRSS:");
+}
+
+unsigned long peak_rss_kb()
+{
+    unsigned long peak = read_proc_status_kb("VmHWM:");
+    if (peak == 0) {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        peak = usage.ru_maxrss;
+    }
+    return peak;
+}
+
+}
+
+unsigned long MemoryUsage::dep_bytes(const DepInfo& dep)
+{
+    return container_bytes(dep.getArgumentDependencies()) + container_bytes(dep.getValueDependencies());
+}
+
+void MemoryUsage::addValueDependencies(const DependencyAnaliser::ValueDependencies& deps)
+{
+    add_dependency_map(deps, value_maps);
+}
+
+void MemoryUsage::addArgumentDependencies(const DependencyAnaliser::ArgumentDependenciesMap& deps)
+{
+    add_dependency_map(deps, value_maps);
+}
+
+void MemoryUsage::addGlobalDependencies(const DependencyAnaliser::GlobalVariableDependencyMap& deps)
+{
+    add_dependency_map(deps, value_maps);
+}
+
+void MemoryUsage::addValueDep(const ValueDepInfo& dep)
+{
+    add_value_dep(dep, value_maps);
+}
+
+void MemoryUsage::addFunctionCallsInfo(const DependencyAnaliser::FunctionCallsArgumentDependencies& callsInfo)
+{
+    call_dep_info += container_bytes(callsInfo);
+    for (const auto& item : callsInfo) {
+        addFunctionCallInfo(item.second);
+    }
+}
+
+void MemoryUsage::addFunctionCallInfo(const FunctionCallDepInfo& callInfo)
+{
+    call_dep_info += container_bytes(callInfo.getCallSites());
+    const auto& argumentsDeps = callInfo.getCallsArgumentDependencies();
+    call_dep_info += container_bytes(argumentsDeps);
+    for (const auto& item : argumentsDeps) {
+        add_dependency_map(item.second, call_dep_info);
+    }
+    const auto& globalsDeps = callInfo.getCallsGlobalsDependencies();
+    call_dep_info += container_bytes(globalsDeps);
+    for (const auto& item : globalsDeps) {
+        add_dependency_map(item.second, call_dep_info);
+    }
+}
+
+void MemoryUsage::addInstructionDependencies(const DependencyAnaliser::InstrDependencyMap& deps)
+{
+    result_sets += container_bytes(deps);
+    for (const auto& item : deps) {
+        result_sets += dep_bytes(item.second);
+    }
+}
+
+template <class DependencyMap>
+void MemoryUsage::add_dependency_map(const DependencyMap& deps, unsigned long& bytes)
+{
+    bytes += container_bytes(deps);
+    for (const auto& item : deps) {
+        add_value_dep(item.second, bytes);
+    }
+}
+
+void MemoryUsage::add_value_dep(const ValueDepInfo& dep, unsigned long& bytes)
+{
+    bytes += dep_bytes(dep.getValueDep());
+    const auto& elements = dep.getCompositeValueDeps();
+    if (elements.empty()) {
+        return;
+    }
+    // elements are accounted as composite values, wherever the value is held
+    composite_values += elements.capacity() * sizeof(ValueDepInfo);
+    for (const auto& element : elements) {
+        add_value_dep(element, composite_values);
+    }
+}
+
+void MemoryAccounting::reset()
+{
+    m_enabled = false;
+    m_phases.clear();
+    m_retained = MemoryUsage();
+}
+
+MemoryAccounting::Phase::Phase(const char* name)
+    : m_name(name)
+    , m_enabled(MemoryAccounting::get().is_enabled())
+    , m_rssBefore(0)
+    , m_peakBefore(0)
+{
+    if (!m_enabled) {
+        return;
+    }
+    m_rssBefore = current_rss_kb();
+    m_peakBefore = peak_rss_kb();
+}
+
+MemoryAccounting::Phase::~Phase()
+{
+    if (!m_enabled) {
+        return;
+    }
+    // peak of the process is shared with other phases and threads, report how much this phase raised it
+    const unsigned long peak = peak_rss_kb();
+    const unsigned long peak_growth = peak > m_peakBefore ? peak - m_peakBefore : 0;
+    MemoryAccounting::get().m_phases.push_back(PhaseMemory{m_name, m_rssBefore, peak_growth, current_rss_kb()});
+}
+
+} // namespace input_dependency
+
@@ -0,0 +1,398 @@
+#include "input-dependency/Analysis/ModuleSummary.h"
+
+#include "input-dependency/Analysis/FunctionAnaliser.h"
+#include "input-dependency/Analysis/FunctionInputDependencyResultInterface.h"
+#include "input-dependency/Analysis/Utils.h"
+
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "nlohmann/json.hpp"
+
+#include <fstream>
+
+namespace input_dependency {
+
+namespace {
+
+using json = nlohmann::json;
+
+void addDependency(const DepInfo& info, ModuleSummary::Dependency& dep)
+{
+    if (info.isInputDep()) {
+        dep.inputDep = true;
+    }
+    for (const auto& arg : info.getArgumentDependencies()) {
+        dep.arguments.insert(arg->getArgNo());
+    }
+    for (const auto& value : info.getValueDependencies()) {
+        if (auto* global = llvm::dyn_cast<llvm::GlobalVariable>(value)) {
+            dep.globals.insert(global->getName().str());
+        } else {
+            // local values are not known outside of the module
+            dep.inputDep = true;
+        }
+    }
+}
+
+void addDependency(const ValueDepInfo& info, ModuleSummary::Dependency& dep)
+{
+    addDependency(info.getValueDep(), dep);
+    for (const auto& element : info.getCompositeValueDeps()) {
+        addDependency(element, dep);
+    }
+}
+
+ModuleSummary::Dependency getDependency(const ValueDepInfo& info)
+{
+    ModuleSummary::Dependency dep;
+    addDependency(info, dep);
+    return dep;
+}
+
+ModuleSummary::Dependency getInputDependency(bool inputDep)
+{
+    ModuleSummary::Dependency dep;
+    dep.inputDep = inputDep;
+    return dep;
+}
+
+std::string getLibraryName(llvm::Function* F)
+{
+    // the same name as used for library info lookup
+    auto name = Utils::demangle_name(F->getName().str());
+    if (name.empty()) {
+        name = F->getName().str();
+    }
+    return name;
+}
+
+llvm::Function* getDirectCallee(llvm::Instruction& I)
+{
+    llvm::Function* callee = nullptr;
+    if (auto* call = llvm::dyn_cast<llvm::CallInst>(&I)) {
+        callee = call->getCalledFunction();
+    } else if (auto* invoke = llvm::dyn_cast<llvm::InvokeInst>(&I)) {
+        callee = invoke->getCalledFunction();
+    }
+    if (callee && callee->isIntrinsic()) {
+        return nullptr;
+    }
+    return callee;
+}
+
+/// Dependency of a value passed at a call site in block B, taken from analysis results of B.
+/// Results of B hold dependencies at the end of B, not at the call. It is the same for values of instructions, but for
+/// memory passed by pointer, a store in B after the call replaces the dependency of the memory at the call.
+ModuleSummary::Dependency getPassedValueDependency(FunctionAnaliser* FA, llvm::Value* value, llvm::BasicBlock* B)
+{
+    ModuleSummary::Dependency dep;
+    if (auto* arg = llvm::dyn_cast<llvm::Argument>(value)) {
+        dep.arguments.insert(arg->getArgNo());
+    } else if (auto* global = llvm::dyn_cast<llvm::GlobalVariable>(value)) {
+        if (FA->hasGlobalVariableDepInfo(global)) {
+            addDependency(FA->getGlobalVariableDependencies(global), dep);
+        } else {
+            dep.globals.insert(global->getName().str());
+        }
+    } else if (auto* constExpr = llvm::dyn_cast<llvm::ConstantExpr>(value)) {
+        for (auto& op : constExpr->operands()) {
+            dep.merge(getPassedValueDependency(FA, op, B));
+        }
+    } else if (auto* instr = llvm::dyn_cast<llvm::Instruction>(value)) {
+        const auto info = FA->getDependencyInfoFromBlock(instr, B);
+        if (info.isDefined()) {
+            addDependency(info, dep);
+        } else {
+            dep.inputDep = FA->isInputDependent(instr);
+        }
+    }
+    // other constants are input independent
+    return dep;
+}
+
+void summarizeAnalysedFunction(FunctionAnaliser* FA, llvm::Function* F, ModuleSummary::Function& summary)
+{
+    summary.returnDependency = getDependency(FA->getRetValueDependencies());
+    for (auto& arg : F->args()) {
+        if (!arg.getType()->isPointerTy() || FA->isOutArgInputIndependent(&arg)) {
+            continue;
+        }
+        summary.outArguments[arg.getArgNo()] = getDependency(FA->getOutArgDependencies(&arg));
+    }
+    for (const auto& global : FA->getReferencedGlobals()) {
+        summary.referencedGlobals.insert(global->getName().str());
+    }
+    for (const auto& global : FA->getModifiedGlobals()) {
+        summary.modifiedGlobals[global->getName().str()] = FA->hasGlobalVariableDepInfo(global)
+                                                               ? getDependency(FA->getGlobalVariableDependencies(global))
+                                                               : getInputDependency(true);
+    }
+    // called functions defined in the module
+    for (const auto& callee : FA->getCallSitesData()) {
+        if (!FA->hasCallArgumentInfo(callee)) {
+            continue;
+        }
+        ModuleSummary::CallSite callSite;
+        callSite.callee = callee->getName().str();
+        for (const auto& item : FA->getCallArgumentInfo(callee)) {
+            callSite.arguments[item.first->getArgNo()] = getDependency(item.second);
+        }
+        summary.calls.push_back(std::move(callSite));
+    }
+    // functions defined in other modules are not tracked by the analysis, their call sites are summarized from
+    // dependencies of passed values
+    std::map<std::string, ModuleSummary::CallSite> declarationCalls;
+    for (auto& B : *F) {
+        for (auto& I : B) {
+            auto* callee = getDirectCallee(I);
+            if (!callee || !callee->isDeclaration()) {
+                continue;
+            }
+            auto& callSite = declarationCalls[callee->getName().str()];
+            callSite.callee = callee->getName().str();
+            const auto blockDependency = FA->getBlockDependencyInfo(&B);
+            // passed arguments are the leading operands of both calls and invokes
+            const unsigned argumentsCount = llvm::isa<llvm::CallInst>(I)
+                                                ? llvm::cast<llvm::CallInst>(I).getNumArgOperands()
+                                                : llvm::cast<llvm::InvokeInst>(I).getNumArgOperands();
+            for (unsigned i = 0; i < argumentsCount; ++i) {
+                auto dep = getPassedValueDependency(FA, I.getOperand(i), &B);
+                // values passed under input dependent control flow depend on it
+                addDependency(blockDependency, dep);
+                callSite.arguments[i].merge(dep);
+            }
+        }
+    }
+    for (auto& item : declarationCalls) {
+        summary.calls.push_back(std::move(item.second));
+    }
+}
+
+/// Summary of functions which were not analysed: all their values are either input dependent or independent
+void summarizeNotAnalysedFunction(bool inputDep, llvm::Function* F, ModuleSummary::Function& summary)
+{
+    summary.returnDependency = getInputDependency(inputDep);
+    for (auto& arg : F->args()) {
+        if (inputDep && arg.getType()->isPointerTy()) {
+            summary.outArguments[arg.getArgNo()] = getInputDependency(true);
+        }
+    }
+    std::map<std::string, ModuleSummary::CallSite> calls;
+    for (auto& B : *F) {
+        for (auto& I : B) {
+            for (auto& op : I.operands()) {
+                if (auto* global = llvm::dyn_cast<llvm::GlobalVariable>(op)) {
+                    summary.referencedGlobals.insert(global->getName().str());
+                }
+            }
+            if (auto* store = llvm::dyn_cast<llvm::StoreInst>(&I)) {
+                if (auto* global = llvm::dyn_cast<llvm::GlobalVariable>(store->getPointerOperand()->stripInBoundsOffsets())) {
+                    summary.modifiedGlobals[global->getName().str()] = getInputDependency(inputDep);
+                }
+            }
+            auto* callee = getDirectCallee(I);
+            if (!callee) {
+                continue;
+            }
+            auto& callSite = calls[callee->getName().str()];
+            callSite.callee = callee->getName().str();
+            for (unsigned i = 0; i < callee->getFunctionType()->getNumParams(); ++i) {
+                callSite.arguments[i] = getInputDependency(inputDep);
+            }
+        }
+    }
+    for (auto& item : calls) {
+        summary.calls.push_back(std::move(item.second));
+    }
+}
+
+json toJson(const ModuleSummary::Dependency& dep)
+{
+    json entry = json::array();
+    if (dep.inputDep) {
+        entry.push_back("dep");
+        return entry;
+    }
+    for (const auto& arg : dep.arguments) {
+        entry.push_back(arg);
+    }
+    for (const auto& global : dep.globals) {
+        entry.push_back("@" + global);
+    }
+    if (entry.empty()) {
+        entry.push_back("indep");
+    }
+    return entry;
+}
+
+ModuleSummary::Dependency fromJson(const json& entry)
+{
+    ModuleSummary::Dependency dep;
+    for (const auto& val : entry) {
+        if (val.is_number()) {
+            dep.arguments.insert(val.get<int>());
+            continue;
+        }
+        const std::string& val_str = val;
+        if (val_str == "dep") {
+            dep.inputDep = true;
+        } else if (!val_str.empty() && val_str[0] == '@') {
+            dep.globals.insert(val_str.substr(1));
+        }
+    }
+    return dep;
+}
+
+json toJson(const ModuleSummary::ArgumentDependencies& deps)
+{
+    json entry = json::object();
+    for (const auto& item : deps) {
+        entry[std::to_string(item.first)] = toJson(item.second);
+    }
+    return entry;
+}
+
+ModuleSummary::ArgumentDependencies fromJsonArguments(const json& entry)
+{
+    ModuleSummary::ArgumentDependencies deps;
+    for (auto it = entry.begin(); it != entry.end(); ++it) {
+        deps[std::stoi(it.key())] = fromJson(it.value());
+    }
+    return deps;
+}
+
+}
+
+void ModuleSummary::Dependency::merge(const Dependency& dep)
+{
+    inputDep |= dep.inputDep;
+    arguments.insert(dep.arguments.begin(), dep.arguments.end());
+    globals.insert(dep.globals.begin(), dep.globals.end());
+}
+
+ModuleSummary::ModuleSummary(llvm::Module& M)
+    : m_moduleName(M.getModuleIdentifier())
+{
+    for (auto& global : M.globals()) {
+        if (global.hasLocalLinkage()) {
+            m_localGlobals.insert(global.getName().str());
+        }
+    }
+}
+
+ModuleSummary::ModuleSummary(llvm::Module& M, const InputDependencyAnalysisInterface::InputDependencyAnalysisInfo& results)
+    : ModuleSummary(M)
+{
+    for (const auto& item : results) {
+        addFunction(item.first, *item.second);
+    }
+}
+
+void ModuleSummary::addFunction(llvm::Function* F, FunctionInputDependencyResultInterface& result)
+{
+    Function summary;
+    summary.name = F->getName().str();
+    summary.libraryName = getLibraryName(F);
+    summary.external = !F->hasLocalLinkage();
+    summary.argumentsCount = F->arg_size();
+    if (auto* FA = result.toFunctionAnalysisResult()) {
+        summarizeAnalysedFunction(FA, F, summary);
+    } else {
+        summarizeNotAnalysedFunction(!result.toInputIndependentFunctionAnalysisResult(), F, summary);
+    }
+    m_functions.push_back(std::move(summary));
+}
+
+bool ModuleSummary::read(const std::string& file)
+{
+    std::ifstream ifs(file, std::ifstream::in);
+    if (!ifs.is_open()) {
+        llvm::dbgs() << "Could not open summary file " << file << "\n";
+        return false;
+    }
+    json root;
+    try {
+        ifs >> root;
+        m_moduleName = root["module"].get<std::string>();
+        for (const auto& global : root["local_globals"]) {
+            m_localGlobals.insert(global.get<std::string>());
+        }
+        for (const auto& function_val : root["functions"]) {
+            Function summary;
+            summary.name = function_val["name"].get<std::string>();
+            summary.libraryName = function_val["library_name"].get<std::string>();
+            summary.external = function_val["external"].get<bool>();
+            summary.argumentsCount = function_val["arguments"].get<unsigned>();
+            summary.returnDependency = fromJson(function_val["return"]);
+            summary.outArguments = fromJsonArguments(function_val["out_arguments"]);
+            for (const auto& global : function_val["referenced_globals"]) {
+                summary.referencedGlobals.insert(global.get<std::string>());
+            }
+            const auto& modified = function_val["modified_globals"];
+            for (auto it = modified.begin(); it != modified.end(); ++it) {
+                summary.modifiedGlobals[it.key()] = fromJson(it.value());
+            }
+            for (const auto& call_val : function_val["calls"]) {
+                CallSite callSite;
+                callSite.callee = call_val["callee"].get<std::string>();
+                callSite.arguments = fromJsonArguments(call_val["arguments"]);
+                summary.calls.push_back(std::move(callSite));
+            }
+            m_functions.push_back(std::move(summary));
+        }
+    } catch (const std::exception& e) {
+        llvm::dbgs() << "Invalid summary file " << file << ": " << e.what() << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool ModuleSummary::write(const std::string& file) const
+{
+    json root;
+    root["module"] = m_moduleName;
+    root["local_globals"] = m_localGlobals;
+    json functions = json::array();
+    for (const auto& summary : m_functions) {
+        json function_val;
+        function_val["name"] = summary.name;
+        function_val["library_name"] = summary.libraryName;
+        function_val["external"] = summary.external;
+        function_val["arguments"] = summary.argumentsCount;
+        function_val["return"] = toJson(summary.returnDependency);
+        function_val["out_arguments"] = toJson(summary.outArguments);
+        function_val["referenced_globals"] = summary.referencedGlobals;
+        json modified = json::object();
+        for (const auto& item : summary.modifiedGlobals) {
+            modified[item.first] = toJson(item.second);
+        }
+        function_val["modified_globals"] = modified;
+        json calls = json::array();
+        for (const auto& callSite : summary.calls) {
+            json call_val;
+            call_val["callee"] = callSite.callee;
+            call_val["arguments"] = toJson(callSite.arguments);
+            calls.push_back(call_val);
+        }
+        function_val["calls"] = calls;
+        functions.push_back(function_val);
+    }
+    root["functions"] = functions;
+
+    std::ofstream ofs(file, std::ofstream::out);
+    if (!ofs.is_open()) {
+        llvm::dbgs() << "Could not open summary file " << file << "\n";
+        return false;
+    }
+    ofs << root.dump(2) << "\n";
+    return true;
+}
+
+} // namespace input_dependency
+
@@ -1,6 +1,7 @@
 #include "input-dependency/Analysis/NonDeterministicBasicBlockAnaliser.h"
 
 #include "input-dependency/Analysis/IndirectCallSitesAnalysis.h"
+#include "input-dependency/Analysis/MemoryAccounting.h"
 #include "input-dependency/Analysis/Utils.h"
 
 #include "llvm/Analysis/AliasAnalysis.h"
@@ -107,6 +108,14 @@ bool NonDeterministicBasicBlockAnaliser::isArgumentDependent(llvm::BasicBlock* b
     return m_nonDetDeps.isInputArgumentDep();
 }
 
+void NonDeterministicBasicBlockAnaliser::accountMemory(MemoryUsage& usage) const
+{
+    BasicBlockAnalysisResult::accountMemory(usage);
+    usage.addInstructionDependencies(m_instructions);
+    usage.addResultSet(m_dataDependentInstrs);
+    usage.addValueDependencies(m_valueDataDependencies);
+}
+
 void NonDeterministicBasicBlockAnaliser::addControlDependencies(ValueDepInfo& valueDepInfo)
 {
     valueDepInfo = addOnDependencyInfo(valueDepInfo);
@@ -1,6 +1,7 @@
 #include "input-dependency/Analysis/NonDeterministicReflectingBasicBlockAnaliser.h"
 
 #include "input-dependency/Analysis/IndirectCallSitesAnalysis.h"
+#include "input-dependency/Analysis/MemoryAccounting.h"
 #include "input-dependency/Analysis/Utils.h"
 
 #include "llvm/Analysis/AliasAnalysis.h"
@@ -108,6 +109,14 @@ bool NonDeterministicReflectingBasicBlockAnaliser::isArgumentDependent(llvm::Bas
     return m_nonDeterministicDeps.isInputArgumentDep();
 }
 
+void NonDeterministicReflectingBasicBlockAnaliser::accountMemory(MemoryUsage& usage) const
+{
+    ReflectingBasicBlockAnaliser::accountMemory(usage);
+    usage.addInstructionDependencies(m_instructions);
+    usage.addResultSet(m_dataDependentInstrs);
+    usage.addValueDependencies(m_valueDataDependencies);
+}
+
 void NonDeterministicReflectingBasicBlockAnaliser::reflect(const DependencyAnaliser::ValueDependencies& dependencies,
                                                            const DepInfo& mandatory_deps)
 {
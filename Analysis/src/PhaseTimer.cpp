@@ -0,0 +1,136 @@
+#include "input-dependency/Analysis/PhaseTimer.h"
+
+#include "llvm/IR/Function.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "nlohmann/json.hpp"
+
+#include <fstream>
+
+namespace input_dependency {
+
+PhaseTimers::PhaseTimers()
+    : m_printTimers(false)
+    , m_startTime(Clock::now())
+    , m_timerGroup("input-dependency", "Input dependency phases")
+{
+}
+
+void PhaseTimers::set_print_timers(bool print)
+{
+    m_printTimers = print;
+}
+
+void PhaseTimers::set_trace_file(const std::string& trace_file)
+{
+    m_traceFile = trace_file;
+}
+
+bool PhaseTimers::is_enabled() const
+{
+    return m_printTimers || llvm::TimePassesIsEnabled || !m_traceFile.empty();
+}
+
+void PhaseTimers::report()
+{
+    if (m_printTimers || llvm::TimePassesIsEnabled) {
+        m_timerGroup.print(llvm::errs());
+    }
+    // timers are printed once, not again on destruction
+    m_timerGroup.clear();
+    if (!m_traceFile.empty()) {
+        write_trace();
+    }
+    m_traceEvents.clear();
+}
+
+llvm::Timer& PhaseTimers::get_timer(const char* phase)
+{
+    auto& timer = m_timers[phase];
+    if (!timer) {
+        timer.reset(new llvm::Timer(phase, phase, m_timerGroup));
+    }
+    return *timer;
+}
+
+void PhaseTimers::add_trace_event(const char* phase,
+                                  llvm::StringRef detail,
+                                  const Clock::time_point& start,
+                                  const Clock::time_point& end)
+{
+    if (m_traceFile.empty()) {
+        return;
+    }
+    using microseconds = std::chrono::duration<double, std::micro>;
+    m_traceEvents.push_back(TraceEvent{phase,
+                                       detail.str(),
+                                       microseconds(start - m_startTime).count(),
+                                       microseconds(end - start).count()});
+}
+
+void PhaseTimers::write_trace()
+{
+    // Chrome trace event format, complete events
+    nlohmann::json events = nlohmann::json::array();
+    for (const auto& event : m_traceEvents) {
+        nlohmann::json trace_event;
+        trace_event["name"] = event.phase;
+        trace_event["cat"] = "input-dependency";
+        trace_event["ph"] = "X";
+        trace_event["ts"] = event.start_us;
+        trace_event["dur"] = event.duration_us;
+        trace_event["pid"] = 1;
+        trace_event["tid"] = 1;
+        if (!event.detail.empty()) {
+            trace_event["args"]["function"] = event.detail;
+        }
+        events.push_back(trace_event);
+    }
+    nlohmann::json trace;
+    trace["traceEvents"] = events;
+    trace["displayTimeUnit"] = "ms";
+    std::ofstream trace_stream(m_traceFile);
+    if (!trace_stream) {
+        llvm::dbgs() << "Can not open trace file " << m_traceFile << "\n";
+        return;
+    }
+    trace_stream << trace.dump() << "\n";
+}
+
+PhaseTimer::PhaseTimer(const char* phase, llvm::StringRef detail)
+    : m_phase(phase)
+    , m_enabled(PhaseTimers::get().is_enabled())
+    , m_timer(nullptr)
+{
+    if (!m_enabled) {
+        return;
+    }
+    m_detail = detail.str();
+    auto& timer = PhaseTimers::get().get_timer(phase);
+    if (!timer.isRunning()) {
+        m_timer = &timer;
+        m_timer->startTimer();
+    }
+    m_start = PhaseTimers::Clock::now();
+}
+
+PhaseTimer::PhaseTimer(const char* phase, const llvm::Function* F)
+    : PhaseTimer(phase, F ? F->getName() : llvm::StringRef())
+{
+}
+
+PhaseTimer::~PhaseTimer()
+{
+    if (!m_enabled) {
+        return;
+    }
+    if (m_timer) {
+        m_timer->stopTimer();
+    }
+    PhaseTimers::get().add_trace_event(m_phase, m_detail, m_start, PhaseTimers::Clock::now());
+}
+
+} // namespace input_dependency
+
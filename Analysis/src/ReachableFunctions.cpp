@@ -18,7 +18,7 @@
 #include "llvm/PassRegistry.h"
 #include "llvm/Transforms/IPO/PassManagerBuilder.h"
 
-#include <list>
+#include <algorithm>
 
 namespace input_dependency {
 
@@ -26,124 +26,232 @@ ReachableFunctions::ReachableFunctions(llvm::Module* M,
                                        llvm::CallGraph* cfg)
     : m_module(M)
     , m_callGraph(cfg)
+    , m_inputDepAnalysis(nullptr)
+    , m_graphBuilt(false)
 {
 }
 
 void ReachableFunctions::setInputDependencyAnalysisResult(InputDependencyAnalysisInterface* inputDepAnalysis)
 {
     m_inputDepAnalysis = inputDepAnalysis;
+    invalidate();
 }
 
 ReachableFunctions::FunctionSet
 ReachableFunctions::getReachableFunctions(llvm::Function* F)
 {
-    FunctionSet reachable_functions;
-
-    llvm::CallGraphNode* entryNode = (*m_callGraph)[F];
-    collect_reachable_functions(entryNode,
-                                reachable_functions);
+    return getReachableFunctions(FunctionList{F});
+}
 
-    collect_indirectly_reachable_functions(reachable_functions);
-    collect_functions_with_uses(reachable_functions);
+ReachableFunctions::FunctionSet
+ReachableFunctions::getReachableFunctions(const FunctionList& roots)
+{
+    const auto& reachable_mask = getReachableFunctionsMask(roots);
+    FunctionSet reachable_functions;
+    reachable_functions.reserve(reachable_mask.count());
+    for (auto idx : reachable_mask.set_bits()) {
+        reachable_functions.insert(m_functions[idx]);
+    }
     return reachable_functions;
 }
 
-void ReachableFunctions::collect_reachable_functions(
-                                llvm::CallGraphNode* callNode,
-                                FunctionSet& reachable_functions)
+llvm::BitVector ReachableFunctions::getReachableFunctionsMask(const FunctionList& roots)
 {
-    if (!callNode) {
-        return;
+    if (!m_graphBuilt) {
+        build_graph();
     }
-    llvm::Function* nodeF = callNode->getFunction();
-    if (!nodeF || nodeF->isDeclaration()) {
-        return;
+    llvm::BitVector visited(m_functions.size());
+    std::vector<unsigned> work_list;
+    work_list.reserve(m_functions.size());
+    for (auto* root : roots) {
+        int idx = getFunctionIndex(root);
+        if (idx == -1 || visited.test(idx)) {
+            continue;
+        }
+        visited.set(idx);
+        work_list.push_back(idx);
     }
-    if (!reachable_functions.insert(nodeF).second) {
-        return;
+    // work_list is never shrinked, each function is pushed at most once
+    for (unsigned head = 0; head < work_list.size(); ++head) {
+        const unsigned node = work_list[head];
+        for (unsigned e = m_edgeOffsets[node]; e != m_edgeOffsets[node + 1]; ++e) {
+            const unsigned succ = m_edges[e];
+            if (visited.test(succ)) {
+                continue;
+            }
+            visited.set(succ);
+            work_list.push_back(succ);
+        }
     }
-    for (auto call_it = callNode->begin(); call_it != callNode->end(); ++call_it) {
-        collect_reachable_functions(call_it->second, reachable_functions);
+    return visited;
+}
+
+int ReachableFunctions::getFunctionIndex(llvm::Function* F) const
+{
+    auto pos = m_functionIndices.find(F);
+    if (pos == m_functionIndices.end()) {
+        return -1;
     }
+    return pos->second;
+}
+
+void ReachableFunctions::invalidate()
+{
+    m_graphBuilt = false;
+    m_functions.clear();
+    m_functionIndices.clear();
+    m_edgeOffsets.clear();
+    m_edges.clear();
 }
 
-void ReachableFunctions::collect_indirectly_reachable_functions(
-                                                FunctionSet& reachable_functions)
+ReachableFunctions::FunctionList
+ReachableFunctions::collectEntryPoints(llvm::Module* M,
+                                       const std::vector<std::string>& names,
+                                       bool exported)
 {
-    std::list<llvm::Function*> working_list;
-    working_list.insert(working_list.end(), reachable_functions.begin(), reachable_functions.end());
-    FunctionSet processed_functions;
-
-    while (!working_list.empty()) {
-        auto F = working_list.front();
-        working_list.pop_front();
-        if (!processed_functions.insert(F).second) {
+    FunctionList entry_points;
+    FunctionSet added_entry_points;
+    const auto& add_entry = [&entry_points, &added_entry_points] (llvm::Function* F) {
+        if (F && !F->isDeclaration() && added_entry_points.insert(F).second) {
+            entry_points.push_back(F);
+        }
+    };
+    if (names.empty()) {
+        add_entry(M->getFunction("main"));
+    }
+    for (const auto& name : names) {
+        llvm::Function* F = M->getFunction(name);
+        if (!F) {
+            llvm::dbgs() << "No entry function " << name << "\n";
             continue;
         }
-        auto F_inputDepAnalysis = m_inputDepAnalysis->getAnalysisInfo(F);
-        if (!F_inputDepAnalysis) {
+        add_entry(F);
+    }
+    // global constructors and destructors are executed outside of main
+    for (const auto& list_name : {"llvm.global_ctors", "llvm.global_dtors"}) {
+        auto* list = M->getGlobalVariable(list_name);
+        if (!list || !list->hasInitializer()) {
+            continue;
+        }
+        auto* init_array = llvm::dyn_cast<llvm::ConstantArray>(list->getInitializer());
+        if (!init_array) {
             continue;
         }
-        const auto& calledFunctions = F_inputDepAnalysis->getCallSitesData();
-        for (auto& calledF : calledFunctions) {
-            if (!reachable_functions.insert(calledF).second) {
+        for (auto& op : init_array->operands()) {
+            auto* entry = llvm::dyn_cast<llvm::ConstantStruct>(op);
+            if (!entry || entry->getNumOperands() < 2) {
                 continue;
             }
-            working_list.push_back(calledF);
+            add_entry(llvm::dyn_cast<llvm::Function>(entry->getOperand(1)->stripPointerCasts()));
         }
     }
+    if (!exported) {
+        return entry_points;
+    }
+    for (auto& F : *M) {
+        if (!F.hasLocalLinkage()) {
+            add_entry(&F);
+        }
+    }
+    return entry_points;
 }
 
-void ReachableFunctions::collect_functions_with_uses(FunctionSet& reachable_functions)
+void ReachableFunctions::build_graph()
 {
-    std::unordered_map<llvm::Function*, FunctionSet> waiting_list;
     for (auto& F : *m_module) {
-
         if (F.isDeclaration()) {
             continue;
         }
-        if (reachable_functions.find(&F) != reachable_functions.end()) {
-            continue;
+        m_functionIndices.insert(std::make_pair(&F, m_functions.size()));
+        m_functions.push_back(&F);
+    }
+    std::vector<std::vector<unsigned>> use_successors(m_functions.size());
+    collect_use_edges(use_successors);
+
+    m_edgeOffsets.reserve(m_functions.size() + 1);
+    m_edgeOffsets.push_back(0);
+    std::vector<unsigned> successors;
+    for (unsigned idx = 0; idx < m_functions.size(); ++idx) {
+        successors.clear();
+        collect_call_edges(m_functions[idx], successors);
+        successors.insert(successors.end(), use_successors[idx].begin(), use_successors[idx].end());
+        std::sort(successors.begin(), successors.end());
+        successors.erase(std::unique(successors.begin(), successors.end()), successors.end());
+        m_edges.insert(m_edges.end(), successors.begin(), successors.end());
+        m_edgeOffsets.push_back(m_edges.size());
+    }
+    m_graphBuilt = true;
+}
+
+void ReachableFunctions::collect_call_edges(llvm::Function* F,
+                                            std::vector<unsigned>& successors) const
+{
+    if (llvm::CallGraphNode* callNode = (*m_callGraph)[F]) {
+        for (auto call_it = callNode->begin(); call_it != callNode->end(); ++call_it) {
+            if (!call_it->second) {
+                continue;
+            }
+            int idx = getFunctionIndex(call_it->second->getFunction());
+            if (idx != -1) {
+                successors.push_back(idx);
+            }
+        }
+    }
+    // call sites known to input dependency analysis, including resolved indirect calls
+    if (!m_inputDepAnalysis) {
+        return;
+    }
+    auto F_inputDepAnalysis = m_inputDepAnalysis->getAnalysisInfo(F);
+    if (!F_inputDepAnalysis) {
+        return;
+    }
+    const auto& calledFunctions = F_inputDepAnalysis->getCallSitesData();
+    for (auto& calledF : calledFunctions) {
+        int idx = getFunctionIndex(calledF);
+        if (idx != -1) {
+            successors.push_back(idx);
         }
-        if (F.user_empty()) {
+    }
+}
+
+void ReachableFunctions::collect_use_edges(std::vector<std::vector<unsigned>>& use_successors) const
+{
+    // function used in a reachable function (e.g. its address is taken) is considered reachable
+    for (unsigned idx = 0; idx < m_functions.size(); ++idx) {
+        llvm::Function* F = m_functions[idx];
+        if (F->user_empty()) {
             continue;
         }
-        for (auto user_it = F.user_begin(); user_it != F.user_end(); ++user_it) {
+        for (auto user_it = F->user_begin(); user_it != F->user_end(); ++user_it) {
             const auto& userFunctions = getUserFunctions(*user_it);
             for (auto& user_F : userFunctions) {
-                if (reachable_functions.find(user_F) != reachable_functions.end()) {
-                    reachable_functions.insert(&F);
-                    break;
-                }
-            }
-            if (reachable_functions.find(&F) == reachable_functions.end()) {
-                for (auto& user_F : userFunctions) {
-                    waiting_list[user_F].insert(&F);
+                int user_idx = getFunctionIndex(user_F);
+                if (user_idx != -1 && user_F != F) {
+                    use_successors[user_idx].push_back(idx);
                 }
             }
         }
     }
-    // TODO: there is a flaw here
-    for (auto& item : waiting_list) {
-        if (reachable_functions.find(item.first) != reachable_functions.end()) {
-            reachable_functions.insert(item.second.begin(), item.second.end());
-        }
-    }
 }
 
-ReachableFunctions::FunctionSet ReachableFunctions::getUserFunctions(llvm::User* user)
+ReachableFunctions::FunctionSet ReachableFunctions::getUserFunctions(llvm::User* user) const
 {
     FunctionSet functions;
-    if (auto* inst = llvm::dyn_cast<llvm::Instruction>(user)) {
-        return {inst->getFunction()};
-    } else {
-        for (auto it = user->user_begin(); it != user->user_end(); ++it) {
-            const auto& user_functions = getUserFunctions(*it);
-            if (!user_functions.empty()) {
-                functions.insert(user_functions.begin(), user_functions.end());
-            }
+    std::vector<llvm::User*> work_list{user};
+    std::unordered_set<llvm::User*> processed_users;
+    while (!work_list.empty()) {
+        llvm::User* current = work_list.back();
+        work_list.pop_back();
+        if (!processed_users.insert(current).second) {
+            continue;
+        }
+        if (auto* inst = llvm::dyn_cast<llvm::Instruction>(current)) {
+            functions.insert(inst->getFunction());
+            continue;
+        }
+        for (auto it = current->user_begin(); it != current->user_end(); ++it) {
+            work_list.push_back(*it);
         }
-
     }
     return functions;
 }
@@ -1,6 +1,8 @@
 #include "input-dependency/Analysis/ReflectingBasicBlockAnaliser.h"
 
+#include "input-dependency/Analysis/AnalysisCostRecorder.h"
 #include "input-dependency/Analysis/IndirectCallSitesAnalysis.h"
+#include "input-dependency/Analysis/MemoryAccounting.h"
 #include "input-dependency/Analysis/value_dependence_graph.h"
 
 #include "llvm/ADT/SCCIterator.h"
@@ -267,6 +269,44 @@ DepInfo ReflectingBasicBlockAnaliser::getInstructionDependencies(llvm::Instructi
     return deppos->second;
 }
 
+namespace {
+
+// memory of map from values to nested containers of reflection data
+template <class ValueMap>
+unsigned long value_map_bytes(const ValueMap& map)
+{
+    unsigned long bytes = MemoryUsage::container_bytes(map);
+    for (const auto& item : map) {
+        bytes += MemoryUsage::container_bytes(item.second);
+    }
+    return bytes;
+}
+
+template <class ValueMap>
+unsigned long call_value_map_bytes(const ValueMap& map)
+{
+    unsigned long bytes = MemoryUsage::container_bytes(map);
+    for (const auto& item : map) {
+        bytes += value_map_bytes(item.second);
+    }
+    return bytes;
+}
+
+}
+
+void ReflectingBasicBlockAnaliser::accountMemory(MemoryUsage& usage) const
+{
+    BasicBlockAnalysisResult::accountMemory(usage);
+    usage.addInstructionDependencies(m_instructionValueDependencies);
+    // values waiting for reflection
+    usage.value_maps += value_map_bytes(m_valueDependentInstrs);
+    usage.value_maps += value_map_bytes(m_valueDependentOutArguments);
+    usage.call_dep_info += call_value_map_bytes(m_valueDependentFunctionCallArguments);
+    usage.call_dep_info += call_value_map_bytes(m_valueDependentFunctionInvokeArguments);
+    usage.call_dep_info += call_value_map_bytes(m_valueDependentCallGlobals);
+    usage.call_dep_info += call_value_map_bytes(m_valueDependentInvokeGlobals);
+}
+
 void ReflectingBasicBlockAnaliser::setOutArguments(const ArgumentDependenciesMap& outArgs)
 {
     BasicBlockAnalysisResult::setOutArguments(outArgs);
@@ -351,6 +391,7 @@ void ReflectingBasicBlockAnaliser::updateAliasingOutArgDependencies(llvm::Value*
         if (arg_idx != -1 && arg_idx != arg.first->getArgNo()) {
             continue;
         }
+        AnalysisCostRecorder::get().count_alias_query();
         auto alias = m_AAR.alias(val, arg.first);
         if (alias == llvm::AliasResult::NoAlias) {
             continue;
@@ -424,7 +465,8 @@ void ReflectingBasicBlockAnaliser::updateValueDependentCallArguments(llvm::CallI
         // is this possible?
         return;
     }
-    const auto& dependencies = pos->second.getArgumentDependenciesForCall(callInst);
+    const auto& callDepInfo = pos->second;
+    const auto& dependencies = callDepInfo.getArgumentDependenciesForCall(callInst);
     for (const auto& dep : dependencies) {
         if (!dep.second.isValueDep()) {
             continue;
@@ -443,7 +485,8 @@ void ReflectingBasicBlockAnaliser::updateValueDependentInvokeArguments(llvm::Inv
     assert(F != nullptr);
     auto pos = m_functionCallInfo.find(F);
     assert(pos != m_functionCallInfo.end());
-    const auto& dependencies = pos->second.getArgumentDependenciesForInvoke(invokeInst);
+    const auto& callDepInfo = pos->second;
+    const auto& dependencies = callDepInfo.getArgumentDependenciesForInvoke(invokeInst);
     for (const auto& dep : dependencies) {
         if (!dep.second.isValueDep()) {
             continue;
@@ -459,7 +502,8 @@ void ReflectingBasicBlockAnaliser::updateValueDependentCallReferencedGlobals(llv
     assert(F != nullptr);
     auto pos = m_functionCallInfo.find(F);
     assert(pos != m_functionCallInfo.end());
-    const auto& dependencies = pos->second.getGlobalsDependenciesForCall(callInst);
+    const auto& callDepInfo = pos->second;
+    const auto& dependencies = callDepInfo.getGlobalsDependenciesForCall(callInst);
     for (const auto& dep : dependencies) {
         if (!dep.second.isValueDep()) {
             continue;
@@ -475,7 +519,8 @@ void ReflectingBasicBlockAnaliser::updateValueDependentInvokeReferencedGlobals(l
     assert(F != nullptr);
     auto pos = m_functionCallInfo.find(F);
     assert(pos != m_functionCallInfo.end());
-    const auto& dependencies = pos->second.getGlobalsDependenciesForInvoke(invokeInst);
+    const auto& callDepInfo = pos->second;
+    const auto& dependencies = callDepInfo.getGlobalsDependenciesForInvoke(invokeInst);
     for (const auto& dep : dependencies) {
         if (!dep.second.isValueDep()) {
             continue;
@@ -488,6 +533,7 @@ void ReflectingBasicBlockAnaliser::updateValueDependentInvokeReferencedGlobals(l
 
 void ReflectingBasicBlockAnaliser::reflect(llvm::Value* value, const ValueDepInfo& deps)
 {
+    AnalysisCostRecorder::get().count_loop_reflected_value();
     assert(deps.isDefined());
     if (deps.isValueDep()) {
         assert(deps.isOnlyGlobalValueDependent());
@@ -614,7 +660,7 @@ void ReflectingBasicBlockAnaliser::reflectOnCalledFunctionReferencedGlobals(llvm
             }
             assert(Fpos != m_functionCallInfo.end());
             auto& callDeps = Fpos->second.getGlobalsDependenciesForCall(callInst);
-            for (auto& global : fargs.second) {
+            for (auto* global : fargs.second) {
                 auto globPos = callDeps.find(global);
                 if (globPos == callDeps.end()) {
                     continue;
@@ -692,7 +738,7 @@ void ReflectingBasicBlockAnaliser::reflectOnInvokedFunctionReferencedGlobals(llv
             }
             assert(Fpos != m_functionCallInfo.end());
             auto& invokeDeps = Fpos->second.getGlobalsDependenciesForInvoke(invokeInst);
-            for (auto& arg : fargs.second) {
+            for (auto* arg : fargs.second) {
                 auto argPos = invokeDeps.find(arg);
                 assert(argPos != invokeDeps.end());
                 reflectOnDepInfo(value, argPos->second, depInfo);
@@ -724,6 +770,10 @@ void ReflectingBasicBlockAnaliser::reflectOnDepInfo(llvm::Value* value,
         return;
     }
     assert(depInfoTo.isValueDep());
+    if (depInfoTo.isInputDep() || depInfoFrom.isInputDep()) {
+        // merge saturates, argument dependencies are not collected
+        AnalysisCostRecorder::get().count_saturated_reflection();
+    }
     if (depInfoTo.getDependency() == DepInfo::VALUE_DEP) {
         depInfoTo.setDependency(depInfoFrom.getDependency());
     }
@@ -793,7 +843,8 @@ void ReflectingBasicBlockAnaliser::resolveValueDependencies(const DependencyAnal
                     continue;
                 }
                 if (pos->second.isInputDep()) {
-                    item.second.setDependency(DepInfo::INPUT_DEP);
+                    AnalysisCostRecorder::get().count_saturated_reflection();
+                    item.second.getValueDep().saturate();
                     value_dependencies.clear();
                     break;
                 }
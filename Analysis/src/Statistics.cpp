@@ -33,6 +33,7 @@ public:
 
     void write_entry(const key& k, double value) override;
     void write_entry(const key& k, unsigned value) override;
+    void write_entry(const key& k, unsigned long value) override;
     void write_entry(const key& k, const std::string& value) override;
     void write_entry(const key& k, const std::vector<std::string>& value) override;
     void flush() override
@@ -60,6 +61,11 @@ public:
         write(k, value);
     }
 
+    void write_entry(const key& k, unsigned long value) override
+    {
+        write(k, value);
+    }
+
     void write_entry(const key& k, const std::string& value) override
     {
         write(k, value);
@@ -134,6 +140,12 @@ void TextReportWriter::write_entry(const key& k, unsigned value)
     m_strm << value << "\n";
 }
 
+void TextReportWriter::write_entry(const key& k, unsigned long value)
+{
+    write_key(k);
+    m_strm << value << "\n";
+}
+
 void TextReportWriter::write_entry(const key& k, const std::string& value)
 {
     write_key(k);
@@ -213,6 +225,11 @@ void Statistics::write_entry(const std::string& class_key, const std::string& ke
     m_writer->write_entry(ReportWriter::key{m_sectionName, class_key, m_statsTypeName, key}, value);
 }
 
+void Statistics::write_entry(const std::string& class_key, const std::string& key, unsigned long value)
+{
+    m_writer->write_entry(ReportWriter::key{m_sectionName, class_key, m_statsTypeName, key}, value);
+}
+
 void Statistics::write_entry(const std::string& class_key, const std::string& key, const std::string& value)
 {
     m_writer->write_entry(ReportWriter::key{m_sectionName, class_key, m_statsTypeName, key}, value);
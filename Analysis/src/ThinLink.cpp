@@ -0,0 +1,286 @@
+#include "input-dependency/Analysis/ThinLink.h"
+
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "nlohmann/json.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+
+namespace input_dependency {
+
+namespace {
+
+using json = nlohmann::json;
+
+std::string getLocalKey(unsigned module, const std::string& name)
+{
+    return std::to_string(module) + ":" + name;
+}
+
+}
+
+void ThinLink::addModule(ModuleSummary&& summary)
+{
+    m_modules.push_back(std::move(summary));
+}
+
+void ThinLink::link()
+{
+    for (unsigned m = 0; m < m_modules.size(); ++m) {
+        for (const auto& function : m_modules[m].getFunctions()) {
+            // functions with the same external name, e.g. inline functions, are linked into one node
+            auto& node = m_functions[getFunctionKey(m, function)];
+            if (!node.summary) {
+                node.summary = &function;
+                node.argumentDeps.assign(function.argumentsCount, false);
+                node.crossModuleArgumentDeps.assign(function.argumentsCount, false);
+            }
+            node.modules.push_back(m);
+        }
+    }
+    for (unsigned m = 0; m < m_modules.size(); ++m) {
+        for (const auto& function : m_modules[m].getFunctions()) {
+            for (const auto& callSite : function.calls) {
+                auto* callee = getCallee(m, callSite.callee);
+                if (!callee) {
+                    continue;
+                }
+                callee->hasCallers = true;
+                if (!isDefinedInModule(*callee, m)) {
+                    callee->hasCrossModuleCallers = true;
+                    ++m_crossModuleCalls;
+                }
+            }
+        }
+    }
+    // as in analysis of a single module, arguments of functions without callers are input dependent
+    for (auto& item : m_functions) {
+        if (!item.second.hasCallers) {
+            item.second.argumentDeps.assign(item.second.argumentDeps.size(), true);
+        }
+    }
+    while (propagate()) {
+    }
+    llvm::dbgs() << "Thin link of " << m_modules.size() << " modules finished in " << m_iterations << " iterations\n";
+}
+
+bool ThinLink::propagate()
+{
+    ++m_iterations;
+    bool changed = false;
+    for (unsigned m = 0; m < m_modules.size(); ++m) {
+        for (const auto& function : m_modules[m].getFunctions()) {
+            const auto& caller = m_functions.at(getFunctionKey(m, function));
+            for (const auto& callSite : function.calls) {
+                auto* callee = getCallee(m, callSite.callee);
+                if (!callee) {
+                    continue;
+                }
+                const bool crossModule = !isDefinedInModule(*callee, m);
+                for (const auto& item : callSite.arguments) {
+                    const unsigned arg = item.first;
+                    if (arg >= callee->argumentDeps.size() || !isInputDep(item.second, caller, m)) {
+                        continue;
+                    }
+                    if (!callee->argumentDeps[arg]) {
+                        callee->argumentDeps[arg] = true;
+                        changed = true;
+                    }
+                    if (crossModule) {
+                        callee->crossModuleArgumentDeps[arg] = true;
+                    }
+                }
+            }
+            for (const auto& item : function.modifiedGlobals) {
+                const auto& key = getGlobalKey(m, item.first);
+                if (!isInputDepGlobal(key) && isInputDep(item.second, caller, m)) {
+                    m_globalDeps[key] = true;
+                    changed = true;
+                }
+            }
+        }
+    }
+    return changed;
+}
+
+bool ThinLink::writeModuleResult(unsigned module, const std::string& file) const
+{
+    const auto& summary = m_modules[module];
+    const auto& libraryDependency = [this] (const ModuleSummary::Dependency& dep, unsigned depModule) {
+        json entry = json::array();
+        bool inputDep = dep.inputDep;
+        for (const auto& global : dep.globals) {
+            inputDep |= isInputDepGlobal(getGlobalKey(depModule, global));
+        }
+        if (inputDep) {
+            entry.push_back("dep");
+        } else if (dep.arguments.empty()) {
+            entry.push_back("indep");
+        } else {
+            for (const auto& arg : dep.arguments) {
+                entry.push_back(arg);
+            }
+        }
+        return entry;
+    };
+
+    // functions defined in other modules, as library functions
+    json functions = json::array();
+    std::set<std::string> libraryFunctions;
+    for (const auto& function : summary.getFunctions()) {
+        for (const auto& callSite : function.calls) {
+            const auto* callee = getCallee(module, callSite.callee);
+            if (!callee || isDefinedInModule(*callee, module)
+                    || !libraryFunctions.insert(callee->summary->libraryName).second) {
+                continue;
+            }
+            const unsigned calleeModule = callee->modules.front();
+            json deps;
+            deps["return"] = libraryDependency(callee->summary->returnDependency, calleeModule);
+            for (const auto& item : callee->summary->outArguments) {
+                deps[std::to_string(item.first)] = libraryDependency(item.second, calleeModule);
+            }
+            json function_val;
+            function_val["name"] = callee->summary->libraryName;
+            function_val["deps"] = json::array({deps});
+            functions.push_back(function_val);
+        }
+    }
+
+    json arguments = json::object();
+    json globals = json::object();
+    for (const auto& function : summary.getFunctions()) {
+        const auto& node = m_functions.at(getFunctionKey(module, function));
+        if (node.hasCrossModuleCallers) {
+            json args = json::object();
+            for (unsigned i = 0; i < node.crossModuleArgumentDeps.size(); ++i) {
+                args[std::to_string(i)] = node.crossModuleArgumentDeps[i] ? "dep" : "indep";
+            }
+            arguments[function.name] = args;
+        }
+        for (const auto& global : function.referencedGlobals) {
+            if (!summary.isLocalGlobal(global)) {
+                globals[global] = isInputDepGlobal(global) ? "dep" : "indep";
+            }
+        }
+    }
+
+    json root;
+    root["module"] = summary.getModuleName();
+    root["functions"] = functions;
+    root["arguments"] = arguments;
+    root["globals"] = globals;
+    std::ofstream ofs(file, std::ofstream::out);
+    if (!ofs.is_open()) {
+        llvm::dbgs() << "Could not open link result file " << file << "\n";
+        return false;
+    }
+    ofs << root.dump(2) << "\n";
+    return true;
+}
+
+std::string ThinLink::getFunctionKey(unsigned module, const ModuleSummary::Function& function) const
+{
+    return function.external ? function.name : getLocalKey(module, function.name);
+}
+
+const ThinLink::FunctionNode* ThinLink::getCallee(unsigned module, const std::string& name) const
+{
+    auto pos = m_functions.find(getLocalKey(module, name));
+    if (pos != m_functions.end()) {
+        return &pos->second;
+    }
+    pos = m_functions.find(name);
+    if (pos != m_functions.end() && pos->second.summary->external) {
+        return &pos->second;
+    }
+    return nullptr;
+}
+
+ThinLink::FunctionNode* ThinLink::getCallee(unsigned module, const std::string& name)
+{
+    return const_cast<FunctionNode*>(static_cast<const ThinLink*>(this)->getCallee(module, name));
+}
+
+std::string ThinLink::getGlobalKey(unsigned module, const std::string& name) const
+{
+    return m_modules[module].isLocalGlobal(name) ? getLocalKey(module, name) : name;
+}
+
+bool ThinLink::isDefinedInModule(const FunctionNode& node, unsigned module) const
+{
+    return std::find(node.modules.begin(), node.modules.end(), module) != node.modules.end();
+}
+
+bool ThinLink::isInputDep(const ModuleSummary::Dependency& dep, const FunctionNode& function, unsigned module) const
+{
+    if (dep.inputDep) {
+        return true;
+    }
+    for (const auto& arg : dep.arguments) {
+        if (arg >= 0 && static_cast<unsigned>(arg) < function.argumentDeps.size() && function.argumentDeps[arg]) {
+            return true;
+        }
+    }
+    for (const auto& global : dep.globals) {
+        if (isInputDepGlobal(getGlobalKey(module, global))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThinLink::isInputDepGlobal(const std::string& key) const
+{
+    auto pos = m_globalDeps.find(key);
+    return pos != m_globalDeps.end() && pos->second;
+}
+
+bool ThinLinkResult::read(const std::string& file)
+{
+    std::ifstream ifs(file, std::ifstream::in);
+    if (!ifs.is_open()) {
+        llvm::dbgs() << "Could not open link result file " << file << "\n";
+        return false;
+    }
+    json root;
+    try {
+        ifs >> root;
+        const auto& arguments = root["arguments"];
+        for (auto it = arguments.begin(); it != arguments.end(); ++it) {
+            auto& argDeps = m_argumentDeps[it.key()];
+            for (auto arg_it = it.value().begin(); arg_it != it.value().end(); ++arg_it) {
+                argDeps[std::stoi(arg_it.key())] = arg_it.value().get<std::string>() == "dep";
+            }
+        }
+        const auto& globals = root["globals"];
+        for (auto it = globals.begin(); it != globals.end(); ++it) {
+            m_globalDeps[it.key()] = it.value().get<std::string>() == "dep";
+        }
+    } catch (const std::exception& e) {
+        llvm::dbgs() << "Invalid link result file " << file << ": " << e.what() << "\n";
+        return false;
+    }
+    return true;
+}
+
+const ThinLinkResult::ArgumentDependencies* ThinLinkResult::getArgumentDependencies(const std::string& function) const
+{
+    auto pos = m_argumentDeps.find(function);
+    if (pos == m_argumentDeps.end()) {
+        return nullptr;
+    }
+    return &pos->second;
+}
+
+bool ThinLinkResult::isInputDepGlobal(const std::string& global) const
+{
+    auto pos = m_globalDeps.find(global);
+    return pos != m_globalDeps.end() && pos->second;
+}
+
+} // namespace input_dependency
+
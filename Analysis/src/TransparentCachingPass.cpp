@@ -3,6 +3,7 @@
 #include "input-dependency/Analysis/InputDependencyAnalysisInterface.h"
 #include "input-dependency/Analysis/FunctionInputDependencyResultInterface.h"
 #include "input-dependency/Analysis/BasicBlocksUtils.h"
+#include "input-dependency/Analysis/PhaseTimer.h"
 
 #include "input-dependency/Analysis/Utils.h"
 #include "input-dependency/Analysis/constants.h"
@@ -66,6 +67,7 @@ bool TransparentCachingPass::runOnModule(llvm::Module& M)
     for (auto& FA_item : functionAnalisers) {
         llvm::Function* F = FA_item.first;
         auto& FA = FA_item.second;
+        PhaseTimer timer("caching", F);
         llvm::dbgs() << "Caching input dependenct for function " << F->getName() << "\n";
         if (FA->isInputDepFunction()) {
             F->setMetadata(metadata_strings::input_dep_function, input_dep_function_md);
@@ -75,6 +77,8 @@ bool TransparentCachingPass::runOnModule(llvm::Module& M)
         if (FA->isExtractedFunction()) {
             F->setMetadata(metadata_strings::extracted, extracted_function_md);
         }
+        const auto& classification = FA->getInstructionClassification();
+        unsigned index = 0;
         for (auto& B : *F) {
             bool is_input_dep_block = false;
             if (FA->isInputDependentBlock(&B)) {
@@ -83,34 +87,36 @@ bool TransparentCachingPass::runOnModule(llvm::Module& M)
                 // don't add metadata_strings to instructions as they'll all be input dep
             } else if (BasicBlocksUtils::get().isBlockUnreachable(&B)) {
                 B.begin()->setMetadata(metadata_strings::unreachable, unreachable_md);
+                index += B.size();
                 continue;
             } else {
                 B.begin()->setMetadata(metadata_strings::input_indep_block, input_indep_block_md);
             }
             for (auto& I : B) {
                 if (!is_input_dep_block) {
-                    if (FA->isInputDependent(&I)) {
+                    if (classification.test(InstructionClassification::INPUT_DEP, index)) {
                         I.setMetadata(metadata_strings::input_dep_instr, input_dep_instr_md);
-                    } else if (FA->isInputIndependent(&I)) {
+                    } else if (classification.test(InstructionClassification::INPUT_INDEP, index)) {
                         I.setMetadata(metadata_strings::input_indep_instr, input_indep_instr_md);
                     } else {
                         I.setMetadata(metadata_strings::unknown, unknown_md);
                     }
                 }
-                if (FA->isControlDependent(&I)) {
+                if (classification.test(InstructionClassification::CONTROL_DEP, index)) {
                     I.setMetadata(metadata_strings::control_dep_instr, control_dep_instr_md);
                 }
-                if (FA->isGlobalDependent(&I)) {
+                if (classification.test(InstructionClassification::GLOBAL_DEP, index)) {
                     I.setMetadata(metadata_strings::global_dep_instr, global_dep_instr_md);
                 }
-                if (FA->isArgumentDependent(&I)) {
+                if (classification.test(InstructionClassification::ARGUMENT_DEP, index)) {
                     I.setMetadata(metadata_strings::argument_dep_instr, arg_dep_instr_md);
                 }
-                if (FA->isDataDependent(&I)) {
+                if (classification.test(InstructionClassification::DATA_DEP, index)) {
                     I.setMetadata(metadata_strings::data_dep_instr, data_dep_instr_md);
                 } else {
                     I.setMetadata(metadata_strings::data_indep_instr, data_indep_instr_md);
                 }
+                ++index;
             }
         }
     }
@@ -3,6 +3,7 @@
 
 #include "input-dependency/Analysis/FunctionAnaliser.h"
 #include "input-dependency/Analysis/InputDepConfig.h"
+#include "input-dependency/Analysis/PhaseTimer.h"
 
 #include "llvm/ADT/SCCIterator.h"
 #include "llvm/Analysis/CallGraph.h"
@@ -58,6 +59,8 @@ void FunctionClonePass::getAnalysisUsage(llvm::AnalysisUsage& AU) const
     AU.addRequired<input_dependency::InputDependencyAnalysisPass>();
     AU.addRequired<llvm::CallGraphWrapperPass>();
     AU.setPreservesAll();
+    // results are cloned for arguments, which needs full function analisers
+    input_dependency::InputDepConfig::get().request_function_analisers();
 }
 
 bool FunctionClonePass::runOnModule(llvm::Module& M)
@@ -121,6 +124,7 @@ bool FunctionClonePass::runOnModule(llvm::Module& M)
                     continue;
                 }
                 original_uses.insert(std::make_pair(callSite, false));
+                input_dependency::PhaseTimer timer("cloning", callSite);
                 bool uses_original = false;
                 const auto& clonedFunctions = doClone(f_analysisInfo, callSite, uses_original);
                 original_uses[callSite] |= uses_original;
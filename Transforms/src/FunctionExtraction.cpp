@@ -22,6 +22,7 @@
 #include "input-dependency/Analysis/InputDependentFunctionAnalysisResult.h"
 #include "input-dependency/Analysis/BasicBlocksUtils.h"
 #include "input-dependency/Analysis/InputDepConfig.h"
+#include "input-dependency/Analysis/PhaseTimer.h"
 
 #include <vector>
 #include <memory>
@@ -552,6 +553,7 @@ bool FunctionExtractionPass::runOnModule(llvm::Module& M)
         llvm::PostDominatorTree* PDom = &getAnalysis<llvm::PostDominatorTreeWrapperPass>(F).getPostDomTree();
         llvm::LoopInfo* loopInfo = &getAnalysis<llvm::LoopInfoWrapperPass>(F).getLoopInfo();
         extract_instr_pred.set_input_dep_info(f_input_dep_info);
+        input_dependency::PhaseTimer timer("extraction", &F);
         run_on_function(F, PDom, loopInfo, f_input_dep_info, &extract_instr_pred, dont_extract_data_indep,
                         extracted_functions, numberOfExtractedDataIndepInstrs);
         modified = true;
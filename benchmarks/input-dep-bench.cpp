@@ -0,0 +1,251 @@
+#include "input-dependency/Analysis/AnalysisContext.h"
+#include "input-dependency/Analysis/InputDependencyAnalysisPass.h"
+#include "input-dependency/Transforms/FunctionClonePass.h"
+#include "input-dependency/Transforms/FunctionExtraction.h"
+
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/InitializePasses.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "nlohmann/json.hpp"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+
+/**
+ * Runs input dependency analysis and transformation passes on given bitcode files repeatedly in process,
+ * and reports wall time, time of each phase, peak RSS and allocations in JSON format.
+ */
+
+namespace {
+
+std::atomic<unsigned long> allocations_count(0);
+std::atomic<unsigned long> allocated_bytes(0);
+
+}
+
+// Count all allocations of the process, including ones made in analysis libraries.
+void* operator new(std::size_t size)
+{
+    ++allocations_count;
+    allocated_bytes += size;
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace {
+
+llvm::cl::list<std::string> input_files(
+    llvm::cl::Positional,
+    llvm::cl::desc("<bitcode files>"),
+    llvm::cl::OneOrMore);
+
+llvm::cl::list<std::string> pipelines(
+    "pipelines",
+    llvm::cl::desc("Pipelines to run: analysis, clone, extract. All by default"),
+    llvm::cl::CommaSeparated);
+
+llvm::cl::opt<unsigned> iterations(
+    "iterations",
+    llvm::cl::desc("Number of runs of each pipeline on each module"),
+    llvm::cl::init(5));
+
+llvm::cl::opt<std::string> output_file(
+    "o",
+    llvm::cl::desc("Output JSON file. Standard output by default"),
+    llvm::cl::value_desc("file name"));
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(const Clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Resets peak RSS of the process, so that it can be measured for a single run. Linux only.
+void reset_peak_rss()
+{
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (clear_refs) {
+        clear_refs << "5";
+    }
+}
+
+long peak_rss_kb()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            return std::stol(line.substr(6));
+        }
+    }
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+nlohmann::json summarize(std::vector<double> values)
+{
+    nlohmann::json summary;
+    if (values.empty()) {
+        return summary;
+    }
+    std::sort(values.begin(), values.end());
+    double sum = 0;
+    for (auto value : values) {
+        sum += value;
+    }
+    summary["min"] = values.front();
+    summary["max"] = values.back();
+    summary["median"] = values[values.size() / 2];
+    summary["mean"] = sum / values.size();
+    return summary;
+}
+
+void add_pipeline_passes(const std::string& pipeline, llvm::legacy::PassManager& PM)
+{
+    if (pipeline == "analysis") {
+        PM.add(new input_dependency::InputDependencyAnalysisPass());
+    } else if (pipeline == "clone") {
+        PM.add(new oh::FunctionClonePass());
+    } else if (pipeline == "extract") {
+        PM.add(new oh::FunctionExtractionPass());
+    }
+}
+
+bool run_benchmark(const std::string& file_name,
+                   const std::string& pipeline,
+                   nlohmann::json& result)
+{
+    std::vector<double> parse_times;
+    std::vector<double> run_times;
+    std::vector<double> total_times;
+    long peak_rss = 0;
+    unsigned long allocations = 0;
+    unsigned long bytes = 0;
+    for (unsigned i = 0; i < iterations; ++i) {
+        reset_peak_rss();
+        const unsigned long allocations_before = allocations_count;
+        const unsigned long bytes_before = allocated_bytes;
+        const auto start = Clock::now();
+        {
+            // fresh analysis state for each run
+            input_dependency::AnalysisContext analysis_context;
+            input_dependency::AnalysisContext::Scope analysis_scope(analysis_context);
+            llvm::LLVMContext context;
+            llvm::SMDiagnostic err;
+            std::unique_ptr<llvm::Module> M = llvm::parseIRFile(file_name, err, context);
+            if (!M) {
+                err.print("input-dep-bench", llvm::errs());
+                return false;
+            }
+            parse_times.push_back(elapsed_ms(start));
+
+            const auto run_start = Clock::now();
+            llvm::legacy::PassManager PM;
+            add_pipeline_passes(pipeline, PM);
+            PM.run(*M);
+            run_times.push_back(elapsed_ms(run_start));
+        }
+        total_times.push_back(elapsed_ms(start));
+        peak_rss = std::max(peak_rss, peak_rss_kb());
+        allocations = allocations_count - allocations_before;
+        bytes = allocated_bytes - bytes_before;
+    }
+    result["module"] = file_name;
+    result["pipeline"] = pipeline;
+    result["iterations"] = iterations.getValue();
+    result["wall_ms"] = summarize(total_times);
+    result["phases"]["parse_ms"] = summarize(parse_times);
+    result["phases"]["run_ms"] = summarize(run_times);
+    result["peak_rss_kb"] = peak_rss;
+    // allocations of the last run, earlier runs are warm-up for lazily created state
+    result["allocations"] = allocations;
+    result["allocated_bytes"] = bytes;
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    llvm::PassRegistry& registry = *llvm::PassRegistry::getPassRegistry();
+    llvm::initializeCore(registry);
+    llvm::initializeAnalysis(registry);
+    llvm::initializeIPO(registry);
+    llvm::initializeTransformUtils(registry);
+    llvm::cl::ParseCommandLineOptions(argc, argv, "Input dependency analysis benchmarks\n");
+
+    std::vector<std::string> pipelines_to_run(pipelines.begin(), pipelines.end());
+    if (pipelines_to_run.empty()) {
+        pipelines_to_run = {"analysis", "clone", "extract"};
+    }
+    for (const auto& pipeline : pipelines_to_run) {
+        if (pipeline != "analysis" && pipeline != "clone" && pipeline != "extract") {
+            llvm::errs() << "Unknown pipeline " << pipeline << "\n";
+            return 1;
+        }
+    }
+
+    nlohmann::json report;
+    report["benchmarks"] = nlohmann::json::array();
+    for (const auto& file_name : input_files) {
+        for (const auto& pipeline : pipelines_to_run) {
+            nlohmann::json result;
+            if (!run_benchmark(file_name, pipeline, result)) {
+                return 1;
+            }
+            report["benchmarks"].push_back(result);
+        }
+    }
+
+    if (output_file.empty()) {
+        llvm::outs() << report.dump(4) << "\n";
+        return 0;
+    }
+    std::ofstream out(output_file);
+    out << report.dump(4) << "\n";
+    return 0;
+}
+
@@ -0,0 +1,338 @@
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Generates synthetic LLVM IR modules of controllable size and shape for complexity benchmarking.
+ * Generated code mimics unoptimized clang output: locals are allocas, values are loaded and stored through memory.
+ * The input of the program is argc of main, which flows to all functions through arguments.
+ */
+
+namespace {
+
+llvm::cl::opt<unsigned> functions_count(
+    "functions",
+    llvm::cl::desc("Number of functions"),
+    llvm::cl::init(10));
+
+llvm::cl::opt<unsigned> call_depth(
+    "call-depth",
+    llvm::cl::desc("Maximal depth of call graph"),
+    llvm::cl::init(4));
+
+llvm::cl::opt<unsigned> fan_out(
+    "fan-out",
+    llvm::cl::desc("Number of callees of each function"),
+    llvm::cl::init(2));
+
+llvm::cl::opt<unsigned> blocks_count(
+    "blocks",
+    llvm::cl::desc("Approximate number of basic blocks in each function body"),
+    llvm::cl::init(12));
+
+llvm::cl::opt<unsigned> loop_depth(
+    "loop-depth",
+    llvm::cl::desc("Nesting depth of loops around function body"),
+    llvm::cl::init(1));
+
+llvm::cl::opt<unsigned> stores_per_block(
+    "stores",
+    llvm::cl::desc("Number of stores in each block"),
+    llvm::cl::init(4));
+
+llvm::cl::opt<unsigned> aggregate_size(
+    "aggregate-size",
+    llvm::cl::desc("Number of fields of struct and elements of global array"),
+    llvm::cl::init(8));
+
+llvm::cl::opt<double> indirect_call_density(
+    "indirect-calls",
+    llvm::cl::desc("Fraction of call sites calling through function pointer table, in [0, 1]"),
+    llvm::cl::init(0.0));
+
+llvm::cl::opt<unsigned> seed(
+    "seed",
+    llvm::cl::desc("Random seed"),
+    llvm::cl::init(0));
+
+llvm::cl::opt<bool> emit_text(
+    "S",
+    llvm::cl::desc("Emit textual IR instead of bitcode"));
+
+llvm::cl::opt<std::string> output_file(
+    "o",
+    llvm::cl::desc("Output file"),
+    llvm::cl::value_desc("file name"),
+    llvm::cl::init("-"));
+
+class ModuleGenerator
+{
+public:
+    explicit ModuleGenerator(llvm::LLVMContext& context)
+        : m_context(context)
+        , m_rng(seed)
+    {
+    }
+
+public:
+    std::unique_ptr<llvm::Module> generate()
+    {
+        m_module.reset(new llvm::Module("scaling", m_context));
+        create_types();
+        declare_functions();
+        create_globals();
+        for (unsigned i = 0; i < m_functions.size(); ++i) {
+            define_function(i);
+        }
+        define_main();
+        return std::move(m_module);
+    }
+
+private:
+    void create_types()
+    {
+        m_int = llvm::Type::getInt32Ty(m_context);
+        m_intPtr = llvm::PointerType::getUnqual(m_int);
+        std::vector<llvm::Type*> fields(std::max(1u, aggregate_size.getValue()), m_int);
+        m_struct = llvm::StructType::create(m_context, fields, "struct.S");
+        m_structPtr = llvm::PointerType::getUnqual(m_struct);
+        m_array = llvm::ArrayType::get(m_int, std::max(1u, aggregate_size.getValue()));
+        m_functionType = llvm::FunctionType::get(m_int, {m_int, m_intPtr, m_structPtr}, false);
+        m_functionPtr = llvm::PointerType::getUnqual(m_functionType);
+    }
+
+    void declare_functions()
+    {
+        for (unsigned i = 0; i < functions_count; ++i) {
+            m_functions.push_back(llvm::Function::Create(m_functionType, llvm::GlobalValue::InternalLinkage,
+                                                         "f" + std::to_string(i), m_module.get()));
+        }
+        // function i calls functions i * fan_out + 1, ..., i * fan_out + fan_out, up to call_depth levels
+        m_callees.resize(m_functions.size());
+        m_called.assign(m_functions.size(), false);
+        std::vector<unsigned> depths(m_functions.size(), 0);
+        for (unsigned i = 0; i < m_functions.size(); ++i) {
+            if (depths[i] + 1 >= call_depth) {
+                continue;
+            }
+            for (unsigned k = 1; k <= fan_out; ++k) {
+                const unsigned callee = i * fan_out + k;
+                if (callee >= m_functions.size()) {
+                    break;
+                }
+                m_callees[i].push_back(callee);
+                m_called[callee] = true;
+                depths[callee] = depths[i] + 1;
+            }
+        }
+    }
+
+    void create_globals()
+    {
+        m_globalArray = new llvm::GlobalVariable(*m_module, m_array, false, llvm::GlobalValue::InternalLinkage,
+                                                 llvm::ConstantAggregateZero::get(m_array), "global_array");
+        m_globalStruct = new llvm::GlobalVariable(*m_module, m_struct, false, llvm::GlobalValue::InternalLinkage,
+                                                  llvm::ConstantAggregateZero::get(m_struct), "global_struct");
+        std::vector<llvm::Constant*> table(m_functions.begin(), m_functions.end());
+        m_tableType = llvm::ArrayType::get(m_functionPtr, table.size());
+        m_functionTable = new llvm::GlobalVariable(*m_module, m_tableType, true, llvm::GlobalValue::InternalLinkage,
+                                                   llvm::ConstantArray::get(m_tableType, table), "function_table");
+    }
+
+    void define_function(unsigned idx)
+    {
+        llvm::Function* F = m_functions[idx];
+        auto arg_it = F->arg_begin();
+        llvm::Value* input = &*arg_it++;
+        llvm::Value* ptr = &*arg_it++;
+        llvm::Value* str = &*arg_it;
+
+        llvm::BasicBlock* entry = llvm::BasicBlock::Create(m_context, "entry", F);
+        llvm::IRBuilder<> builder(entry);
+        m_locals.clear();
+        for (unsigned i = 0; i < std::max(1u, stores_per_block.getValue()); ++i) {
+            m_locals.push_back(builder.CreateAlloca(m_int, nullptr, "local" + std::to_string(i)));
+            builder.CreateStore(i % 2 ? input : builder.getInt32(i), m_locals.back());
+        }
+        std::vector<llvm::AllocaInst*> counters;
+        for (unsigned d = 0; d < loop_depth; ++d) {
+            counters.push_back(builder.CreateAlloca(m_int, nullptr, "counter" + std::to_string(d)));
+        }
+
+        // open loops
+        std::vector<std::pair<llvm::BasicBlock*, llvm::BasicBlock*>> loops;
+        for (unsigned d = 0; d < loop_depth; ++d) {
+            builder.CreateStore(builder.getInt32(0), counters[d]);
+            auto* header = llvm::BasicBlock::Create(m_context, "loop.header" + std::to_string(d), F);
+            auto* body = llvm::BasicBlock::Create(m_context, "loop.body" + std::to_string(d), F);
+            auto* exit = llvm::BasicBlock::Create(m_context, "loop.exit" + std::to_string(d), F);
+            builder.CreateBr(header);
+            builder.SetInsertPoint(header);
+            auto* counter = builder.CreateLoad(m_int, counters[d]);
+            // inner loops are bounded by input
+            llvm::Value* bound = d % 2 ? input : builder.getInt32(10);
+            builder.CreateCondBr(builder.CreateICmpSLT(counter, bound), body, exit);
+            builder.SetInsertPoint(body);
+            loops.push_back(std::make_pair(header, exit));
+        }
+
+        // chain of diamonds
+        const unsigned diamonds = std::max(1u, blocks_count.getValue() / 3);
+        unsigned call_idx = 0;
+        for (unsigned i = 0; i < diamonds; ++i) {
+            auto* then_block = llvm::BasicBlock::Create(m_context, "then" + std::to_string(i), F);
+            auto* else_block = llvm::BasicBlock::Create(m_context, "else" + std::to_string(i), F);
+            auto* join_block = llvm::BasicBlock::Create(m_context, "join" + std::to_string(i), F);
+            auto* cond_value = builder.CreateLoad(m_int, m_locals[i % m_locals.size()]);
+            builder.CreateCondBr(builder.CreateICmpSGT(cond_value, builder.getInt32(i)), then_block, else_block);
+
+            builder.SetInsertPoint(then_block);
+            emit_stores(builder, ptr, str, i);
+            builder.CreateBr(join_block);
+
+            builder.SetInsertPoint(else_block);
+            emit_stores(builder, ptr, str, i + 1);
+            if (!m_callees[idx].empty()) {
+                unsigned callee = m_callees[idx][call_idx++ % m_callees[idx].size()];
+                emit_call(builder, callee, builder.CreateLoad(m_int, m_locals[0]), ptr, str);
+            }
+            builder.CreateBr(join_block);
+            builder.SetInsertPoint(join_block);
+        }
+        // make sure every callee is called at least once
+        while (call_idx < m_callees[idx].size()) {
+            emit_call(builder, m_callees[idx][call_idx++], input, ptr, str);
+        }
+
+        // close loops
+        for (unsigned d = loop_depth; d-- > 0;) {
+            auto* counter = builder.CreateLoad(m_int, counters[d]);
+            builder.CreateStore(builder.CreateAdd(counter, builder.getInt32(1)), counters[d]);
+            builder.CreateBr(loops[d].first);
+            builder.SetInsertPoint(loops[d].second);
+        }
+        builder.CreateRet(builder.CreateLoad(m_int, m_locals[0]));
+    }
+
+    void emit_stores(llvm::IRBuilder<>& builder, llvm::Value* ptr, llvm::Value* str, unsigned offset)
+    {
+        const unsigned size = std::max(1u, aggregate_size.getValue());
+        for (unsigned i = 0; i < stores_per_block; ++i) {
+            const unsigned n = offset + i;
+            llvm::Value* value = builder.CreateLoad(m_int, m_locals[n % m_locals.size()]);
+            value = builder.CreateAdd(value, builder.getInt32(n));
+            llvm::Value* address = nullptr;
+            switch (n % 4) {
+            case 0:
+                address = m_locals[(n + 1) % m_locals.size()];
+                break;
+            case 1:
+                address = builder.CreateInBoundsGEP(m_array, m_globalArray,
+                                                    {builder.getInt32(0), builder.getInt32(n % size)});
+                break;
+            case 2:
+                address = builder.CreateStructGEP(m_struct, str, n % size);
+                break;
+            default:
+                address = builder.CreateInBoundsGEP(m_int, ptr, builder.getInt32(n % size));
+                break;
+            }
+            builder.CreateStore(value, address);
+        }
+    }
+
+    void emit_call(llvm::IRBuilder<>& builder, unsigned callee,
+                   llvm::Value* input, llvm::Value* ptr, llvm::Value* str)
+    {
+        llvm::Value* callee_value = m_functions[callee];
+        if (m_distribution(m_rng) < indirect_call_density) {
+            auto* slot = builder.CreateInBoundsGEP(m_tableType, m_functionTable,
+                                                   {builder.getInt32(0), builder.getInt32(callee)});
+            callee_value = builder.CreateLoad(m_functionPtr, slot);
+        }
+        auto* result = builder.CreateCall(m_functionType, callee_value, {input, ptr, str});
+        builder.CreateStore(result, m_locals[callee % m_locals.size()]);
+    }
+
+    void define_main()
+    {
+        auto* main_type = llvm::FunctionType::get(m_int, {m_int, llvm::PointerType::getUnqual(llvm::Type::getInt8PtrTy(m_context))}, false);
+        auto* main = llvm::Function::Create(main_type, llvm::GlobalValue::ExternalLinkage, "main", m_module.get());
+        llvm::IRBuilder<> builder(llvm::BasicBlock::Create(m_context, "entry", main));
+        llvm::Value* argc = &*main->arg_begin();
+        auto* ptr = builder.CreateInBoundsGEP(m_array, m_globalArray, {builder.getInt32(0), builder.getInt32(0)});
+        for (unsigned i = 0; i < m_functions.size(); ++i) {
+            if (!m_called[i]) {
+                builder.CreateCall(m_functionType, m_functions[i], {argc, ptr, m_globalStruct});
+            }
+        }
+        builder.CreateRet(builder.getInt32(0));
+    }
+
+private:
+    llvm::LLVMContext& m_context;
+    std::unique_ptr<llvm::Module> m_module;
+    std::mt19937 m_rng;
+    std::uniform_real_distribution<double> m_distribution;
+
+    llvm::Type* m_int;
+    llvm::Type* m_intPtr;
+    llvm::StructType* m_struct;
+    llvm::Type* m_structPtr;
+    llvm::ArrayType* m_array;
+    llvm::FunctionType* m_functionType;
+    llvm::Type* m_functionPtr;
+    llvm::ArrayType* m_tableType;
+
+    llvm::GlobalVariable* m_globalArray;
+    llvm::GlobalVariable* m_globalStruct;
+    llvm::GlobalVariable* m_functionTable;
+    std::vector<llvm::Function*> m_functions;
+    std::vector<std::vector<unsigned>> m_callees;
+    std::vector<bool> m_called;
+    std::vector<llvm::AllocaInst*> m_locals;
+};
+
+}
+
+int main(int argc, char* argv[])
+{
+    llvm::cl::ParseCommandLineOptions(argc, argv, "Synthetic IR generator for input dependency benchmarks\n");
+
+    llvm::LLVMContext context;
+    ModuleGenerator generator(context);
+    auto M = generator.generate();
+    if (llvm::verifyModule(*M, &llvm::errs())) {
+        llvm::errs() << "Generated module is broken\n";
+        return 1;
+    }
+
+    std::error_code EC;
+    llvm::raw_fd_ostream out(output_file, EC, llvm::sys::fs::F_None);
+    if (EC) {
+        llvm::errs() << "Failed to open " << output_file << ": " << EC.message() << "\n";
+        return 1;
+    }
+    if (emit_text) {
+        M->print(out, nullptr);
+    } else {
+        llvm::WriteBitcodeToFile(*M, out);
+    }
+    return 0;
+}
+
@@ -0,0 +1,394 @@
+#include "input-dependency/Analysis/DependencyAnaliser.h"
+#include "input-dependency/Analysis/DependencyInfo.h"
+#include "input-dependency/Analysis/InputDependencyAnalysis.h"
+#include "input-dependency/Analysis/ValueDepInfo.h"
+#include "input-dependency/Analysis/value_dependence_graph.h"
+
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/Regex.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "nlohmann/json.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Micro-benchmarks of dependency lattice primitives used by every analysis run:
+ * merges of DepInfo and composite ValueDepInfo, merges of predecessor dependency maps,
+ * merges of call site dependency maps and value dependence graph construction.
+ * Each benchmark runs for each size argument over synthetic values of a generated function,
+ * so that data structure changes of these types can be evaluated in isolation.
+ */
+
+namespace {
+
+llvm::cl::opt<std::string> filter(
+    "filter",
+    llvm::cl::desc("Run only benchmarks with names matching given regular expression"),
+    llvm::cl::value_desc("regex"));
+
+llvm::cl::list<unsigned> sizes(
+    "sizes",
+    llvm::cl::desc("Sizes of synthetic inputs. 4,16,64,256,1024 by default"),
+    llvm::cl::CommaSeparated);
+
+llvm::cl::opt<unsigned> min_time_ms(
+    "min-time-ms",
+    llvm::cl::desc("Minimal time to run each benchmark"),
+    llvm::cl::init(200));
+
+llvm::cl::opt<std::string> output_file(
+    "o",
+    llvm::cl::desc("Output JSON file. Only text report is printed by default"),
+    llvm::cl::value_desc("file name"));
+
+using Clock = std::chrono::steady_clock;
+
+// Keeps compiler from optimizing away computations whose results are not used.
+template <class T>
+void do_not_optimize(T& value)
+{
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+/// Iteration state of a single benchmark run. Timing starts with the first keep_running call.
+class State
+{
+public:
+    State(unsigned long iterations, unsigned size)
+        : m_iterations(iterations)
+        , m_remaining(iterations)
+        , m_size(size)
+    {
+    }
+
+    bool keep_running()
+    {
+        if (m_remaining == m_iterations) {
+            m_start = Clock::now();
+        }
+        if (m_remaining == 0) {
+            m_end = Clock::now();
+            return false;
+        }
+        --m_remaining;
+        return true;
+    }
+
+    unsigned size() const
+    {
+        return m_size;
+    }
+
+    unsigned long iterations() const
+    {
+        return m_iterations;
+    }
+
+    double elapsed_ns() const
+    {
+        return std::chrono::duration<double, std::nano>(m_end - m_start).count();
+    }
+
+private:
+    const unsigned long m_iterations;
+    unsigned long m_remaining;
+    const unsigned m_size;
+    Clock::time_point m_start;
+    Clock::time_point m_end;
+};
+
+using BenchmarkFunction = void (*)(State& state);
+
+struct Benchmark
+{
+    const char* name;
+    BenchmarkFunction function;
+};
+
+/// Function with size arguments and size local values, used as keys of dependency sets and maps.
+class SyntheticInputs
+{
+public:
+    explicit SyntheticInputs(unsigned size)
+        : m_module(new llvm::Module("microbench", m_context))
+    {
+        llvm::Type* int_type = llvm::Type::getInt32Ty(m_context);
+        std::vector<llvm::Type*> arg_types(size, int_type);
+        auto* fun_type = llvm::FunctionType::get(llvm::Type::getVoidTy(m_context), arg_types, false);
+        auto* F = llvm::Function::Create(fun_type, llvm::GlobalValue::ExternalLinkage, "f", m_module.get());
+        llvm::IRBuilder<> builder(llvm::BasicBlock::Create(m_context, "entry", F));
+        for (auto& arg : F->args()) {
+            m_arguments.push_back(&arg);
+        }
+        for (unsigned i = 0; i < size; ++i) {
+            m_values.push_back(builder.CreateAlloca(int_type));
+        }
+        builder.CreateRetVoid();
+        m_compositeType = llvm::StructType::get(m_context, arg_types);
+    }
+
+public:
+    const std::vector<llvm::Argument*>& arguments() const
+    {
+        return m_arguments;
+    }
+
+    const std::vector<llvm::Value*>& values() const
+    {
+        return m_values;
+    }
+
+    llvm::Type* composite_type() const
+    {
+        return m_compositeType;
+    }
+
+    /// Argument dependency of size / 2 arguments, starting from argument at given offset.
+    input_dependency::DepInfo argument_dep(unsigned offset) const
+    {
+        input_dependency::ArgumentSet args;
+        for (unsigned i = 0; i < m_arguments.size() / 2; ++i) {
+            args.insert(m_arguments[(offset + i) % m_arguments.size()]);
+        }
+        return input_dependency::DepInfo(input_dependency::DepInfo::INPUT_ARGDEP, args);
+    }
+
+    /// Value dependency of size / 2 values, starting from value at given offset.
+    input_dependency::DepInfo value_dep(unsigned offset) const
+    {
+        input_dependency::ValueSet values;
+        for (unsigned i = 0; i < m_values.size() / 2; ++i) {
+            values.insert(m_values[(offset + i) % m_values.size()]);
+        }
+        return input_dependency::DepInfo(input_dependency::DepInfo::VALUE_DEP, values);
+    }
+
+private:
+    llvm::LLVMContext m_context;
+    std::unique_ptr<llvm::Module> m_module;
+    std::vector<llvm::Argument*> m_arguments;
+    std::vector<llvm::Value*> m_values;
+    llvm::Type* m_compositeType;
+};
+
+// Merge of two argument dependencies with half of the arguments in common.
+void bench_depinfo_merge_arguments(State& state)
+{
+    SyntheticInputs inputs(state.size());
+    const auto to = inputs.argument_dep(0);
+    const auto from = inputs.argument_dep(state.size() / 4);
+    while (state.keep_running()) {
+        auto merged = to;
+        merged.mergeDependencies(from);
+        do_not_optimize(merged);
+    }
+}
+
+// Merge of two value dependencies with half of the values in common.
+void bench_depinfo_merge_values(State& state)
+{
+    SyntheticInputs inputs(state.size());
+    const auto to = inputs.value_dep(0);
+    const auto from = inputs.value_dep(state.size() / 4);
+    while (state.keep_running()) {
+        auto merged = to;
+        merged.mergeDependencies(from);
+        do_not_optimize(merged);
+    }
+}
+
+// Update of a composite value of size elements, each element depending on arguments.
+void bench_valuedepinfo_update_composite(State& state)
+{
+    SyntheticInputs inputs(state.size());
+    const input_dependency::ValueDepInfo to(inputs.composite_type(), inputs.argument_dep(0));
+    const input_dependency::ValueDepInfo from(inputs.composite_type(), inputs.argument_dep(state.size() / 4));
+    while (state.keep_running()) {
+        auto updated = to;
+        updated.updateValueDep(from);
+        do_not_optimize(updated);
+    }
+}
+
+// Merge of a composite value of size elements, each element depending on arguments.
+void bench_valuedepinfo_merge_composite(State& state)
+{
+    SyntheticInputs inputs(state.size());
+    const input_dependency::ValueDepInfo to(inputs.composite_type(), inputs.argument_dep(0));
+    const input_dependency::ValueDepInfo from(inputs.composite_type(), inputs.argument_dep(state.size() / 4));
+    while (state.keep_running()) {
+        auto merged = to;
+        merged.mergeDependencies(from);
+        do_not_optimize(merged);
+    }
+}
+
+// Merge of value dependencies of four predecessors, as done for each block on entry.
+void bench_predecessors_merge(State& state)
+{
+    const unsigned predecessors_num = 4;
+    SyntheticInputs inputs(state.size());
+    const auto& values = inputs.values();
+    std::vector<input_dependency::DependencyAnaliser::ValueDependencies> predecessors(predecessors_num);
+    for (unsigned p = 0; p < predecessors_num; ++p) {
+        // each predecessor has dependencies of half of the values, shifted by a quarter
+        for (unsigned i = 0; i < values.size() / 2; ++i) {
+            const unsigned idx = (p * values.size() / 4 + i) % values.size();
+            predecessors[p].emplace(values[idx], input_dependency::ValueDepInfo(inputs.argument_dep(idx)));
+        }
+    }
+    while (state.keep_running()) {
+        input_dependency::DependencyAnaliser::ValueDependencies deps;
+        for (const auto& valueDeps : predecessors) {
+            for (auto& dep : valueDeps) {
+                auto res = deps.insert(dep);
+                if (!res.second) {
+                    res.first->second.mergeDependencies(dep.second);
+                }
+            }
+        }
+        do_not_optimize(deps);
+    }
+}
+
+// Merge of argument dependencies of two call sites of a function with size arguments.
+void bench_merge_dependency_maps(State& state)
+{
+    SyntheticInputs inputs(state.size());
+    const auto& args = inputs.arguments();
+    input_dependency::DependencyAnaliser::ArgumentDependenciesMap to;
+    input_dependency::DependencyAnaliser::ArgumentDependenciesMap from;
+    for (unsigned i = 0; i < args.size(); ++i) {
+        to.emplace(args[i], input_dependency::ValueDepInfo(inputs.argument_dep(i)));
+        if (i % 2 == 0) {
+            from.emplace(args[i], input_dependency::ValueDepInfo(inputs.argument_dep(i + 1)));
+        } else {
+            from.emplace(args[i], input_dependency::ValueDepInfo(input_dependency::DepInfo::INPUT_DEP));
+        }
+    }
+    while (state.keep_running()) {
+        auto merged = to;
+        input_dependency::InputDependencyAnalysis::mergeDependencyMaps(merged, from);
+        do_not_optimize(merged);
+    }
+}
+
+// Build of value dependence graph of size values, depending on each other in chains closed into cycles of 8 values.
+void bench_value_dependence_graph_build(State& state)
+{
+    const unsigned cycle_length = 8;
+    SyntheticInputs inputs(state.size());
+    const auto& values = inputs.values();
+    const auto& args = inputs.arguments();
+    input_dependency::DependencyAnaliser::ValueDependencies valueDeps;
+    input_dependency::DependencyAnaliser::ValueDependencies initialDeps;
+    for (unsigned i = 0; i < values.size(); ++i) {
+        if (i % cycle_length == 0) {
+            // cycle leaf, depends on the previous cycle and on an argument
+            input_dependency::DepInfo dep(input_dependency::DepInfo::INPUT_ARGDEP,
+                                          input_dependency::ArgumentSet{args[i]});
+            if (i != 0) {
+                dep.mergeDependencies(input_dependency::ValueSet{values[i - 1]});
+                dep.setDependency(input_dependency::DepInfo::VALUE_DEP);
+            }
+            valueDeps.emplace(values[i], input_dependency::ValueDepInfo(dep));
+            continue;
+        }
+        const unsigned cycle_start = i - i % cycle_length;
+        input_dependency::ValueSet depends_on{values[i - 1]};
+        const bool closes_cycle = i % cycle_length == cycle_length - 1 || i == values.size() - 1;
+        if (closes_cycle && i > cycle_start + 1) {
+            depends_on.insert(values[cycle_start + 1]);
+        }
+        valueDeps.emplace(values[i], input_dependency::ValueDepInfo(
+                                        input_dependency::DepInfo(input_dependency::DepInfo::VALUE_DEP, depends_on)));
+    }
+    while (state.keep_running()) {
+        auto deps = valueDeps;
+        input_dependency::value_dependence_graph graph;
+        graph.build(deps, initialDeps);
+        do_not_optimize(graph);
+    }
+}
+
+const Benchmark benchmarks[] = {
+    {"DepInfo::mergeDependencies/arguments", bench_depinfo_merge_arguments},
+    {"DepInfo::mergeDependencies/values", bench_depinfo_merge_values},
+    {"ValueDepInfo::updateValueDep/composite", bench_valuedepinfo_update_composite},
+    {"ValueDepInfo::mergeDependencies/composite", bench_valuedepinfo_merge_composite},
+    {"predecessors_merge", bench_predecessors_merge},
+    {"InputDependencyAnalysis::mergeDependencyMaps", bench_merge_dependency_maps},
+    {"value_dependence_graph::build", bench_value_dependence_graph_build},
+};
+
+// Doubles iterations count until a run takes at least min_time_ms, and reports the last run.
+nlohmann::json run_benchmark(const Benchmark& benchmark, unsigned size)
+{
+    const double min_time_ns = min_time_ms * 1e6;
+    unsigned long iterations = 1;
+    while (true) {
+        State state(iterations, size);
+        benchmark.function(state);
+        if (state.elapsed_ns() >= min_time_ns || iterations >= (1ul << 40)) {
+            nlohmann::json result;
+            result["name"] = std::string(benchmark.name) + "/" + std::to_string(size);
+            result["size"] = size;
+            result["iterations"] = iterations;
+            result["ns_per_iteration"] = state.elapsed_ns() / iterations;
+            return result;
+        }
+        iterations *= 2;
+    }
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    llvm::cl::ParseCommandLineOptions(argc, argv, "Input dependency lattice micro-benchmarks\n");
+
+    std::vector<unsigned> sizes_to_run(sizes.begin(), sizes.end());
+    if (sizes_to_run.empty()) {
+        sizes_to_run = {4, 16, 64, 256, 1024};
+    }
+    llvm::Regex name_filter(filter.empty() ? std::string(".*") : filter.getValue());
+    std::string error;
+    if (!name_filter.isValid(error)) {
+        llvm::errs() << "Invalid filter: " << error << "\n";
+        return 1;
+    }
+
+    nlohmann::json report;
+    report["benchmarks"] = nlohmann::json::array();
+    for (const auto& benchmark : benchmarks) {
+        if (!name_filter.match(benchmark.name)) {
+            continue;
+        }
+        for (auto size : sizes_to_run) {
+            auto result = run_benchmark(benchmark, size);
+            llvm::outs() << llvm::left_justify(result["name"].get<std::string>(), 56);
+            llvm::outs() << llvm::format("%14.1f ns %12lu iterations\n",
+                                         result["ns_per_iteration"].get<double>(),
+                                         result["iterations"].get<unsigned long>());
+            report["benchmarks"].push_back(result);
+        }
+    }
+
+    if (!output_file.empty()) {
+        std::ofstream out(output_file);
+        out << report.dump(4) << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,40 @@
+#!/bin/bash
+
+# Builds bitcode of test programs and runs input-dep-bench on them.
+# Usage: run-benchmarks.sh [output json] [iterations]
+
+OUTPUT=${1:-benchmarks.json}
+ITERATIONS=${2:-5}
+
+BENCH_BIN=../build/benchmarks/input-dep-bench
+TESTS_DIR=../tests
+BC_DIR=bitcode
+
+mkdir -p $BC_DIR
+
+clone_project()
+{
+    if [ ! -d "$1" ]; then
+        git clone $2 $1
+    fi
+}
+
+clone_project $BC_DIR/2048_game https://github.com/cuadue/2048_game.git
+clone_project $BC_DIR/micro_snake https://github.com/troglobit/snake.git
+clone_project $BC_DIR/snake_c https://github.com/mnisjk/snake.git
+clone_project $BC_DIR/tetris https://github.com/troglobit/tetris.git
+
+clang $BC_DIR/2048_game/2048_game.c -DVERSION=\"1.0.1\" -c -emit-llvm -o $BC_DIR/2048_game.bc
+clang $BC_DIR/micro_snake/snake.c -DVERSION=\"1.0.1\" -c -emit-llvm -o $BC_DIR/micro_snake.bc
+clang $BC_DIR/snake_c/snake.c -DVERSION=\"1.0.1\" -c -emit-llvm -o $BC_DIR/snake_c.bc
+clang $BC_DIR/tetris/tetris.c -DVERSION=\"1.0.1\" -c -emit-llvm -o $BC_DIR/tetris.bc
+
+clang $TESTS_DIR/bubble_sort/bubble_sort.cpp -c -emit-llvm -o $BC_DIR/bubble_sort.bc
+
+for src in $TESTS_DIR/control_flow/*.cpp $TESTS_DIR/loop_controlflow/*.cpp $TESTS_DIR/composite_types/*.c $TESTS_DIR/composite_types/*.cpp
+do
+    name=$(basename $(dirname $src))_$(basename ${src%.*})
+    clang $src -c -emit-llvm -o $BC_DIR/$name.bc
+done
+
+$BENCH_BIN $BC_DIR/*.bc -iterations=$ITERATIONS -o $OUTPUT
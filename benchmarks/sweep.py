@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+
+"""
+Sweeps parameters of input-dep-gen through input-dep-bench, and reports analysis time and memory
+against each parameter value as CSV, and as plots if matplotlib is available.
+
+Example:
+    sweep.py --sweep functions=10,100,1000 --sweep blocks=12,48,192 --base loop-depth=2 -o sweep
+"""
+
+import argparse
+import csv
+import json
+import os
+import subprocess
+import sys
+
+
+def parse_assignment(text):
+    name, _, values = text.partition('=')
+    if not values:
+        raise argparse.ArgumentTypeError('expected name=value[,value...], got ' + text)
+    return name, values.split(',')
+
+
+def run_point(args, params, bc_file, json_file):
+    gen_cmd = [args.gen, '-o', bc_file] + ['-%s=%s' % item for item in sorted(params.items())]
+    subprocess.check_call(gen_cmd)
+    bench_cmd = [args.bench, bc_file, '-pipelines=' + args.pipelines,
+                 '-iterations=%d' % args.iterations, '-o', json_file]
+    subprocess.check_call(bench_cmd)
+    with open(json_file) as f:
+        return json.load(f)['benchmarks']
+
+
+def plot(rows, param, out_dir):
+    try:
+        import matplotlib
+        matplotlib.use('Agg')
+        import matplotlib.pyplot as plt
+    except ImportError:
+        return
+    metrics = [('wall_ms', 'median wall time (ms)'),
+               ('peak_rss_kb', 'peak RSS (KB)'),
+               ('allocations', 'allocations')]
+    fig, axes = plt.subplots(1, len(metrics), figsize=(6 * len(metrics), 4))
+    for ax, (metric, label) in zip(axes, metrics):
+        for pipeline in sorted(set(row['pipeline'] for row in rows)):
+            points = [(float(row['value']), row[metric]) for row in rows if row['pipeline'] == pipeline]
+            points.sort()
+            ax.plot([p[0] for p in points], [p[1] for p in points], marker='o', label=pipeline)
+        ax.set_xlabel(param)
+        ax.set_ylabel(label)
+        # symlog keeps zero values, e.g. loop-depth=0 or no allocations, which log scale cannot show
+        ax.set_xscale('symlog')
+        ax.set_yscale('symlog')
+        ax.legend()
+    fig.tight_layout()
+    fig.savefig(os.path.join(out_dir, param + '.png'))
+    plt.close(fig)
+
+
+def main():
+    script_dir = os.path.dirname(os.path.abspath(__file__))
+    build_dir = os.path.join(script_dir, '..', 'build', 'benchmarks')
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--gen', default=os.path.join(build_dir, 'input-dep-gen'))
+    parser.add_argument('--bench', default=os.path.join(build_dir, 'input-dep-bench'))
+    parser.add_argument('--sweep', type=parse_assignment, action='append', required=True,
+                        help='generator parameter and values to sweep, e.g. functions=10,100,1000')
+    parser.add_argument('--base', type=parse_assignment, action='append', default=[],
+                        help='generator parameter kept fixed during sweeps, e.g. loop-depth=2')
+    parser.add_argument('--pipelines', default='analysis')
+    parser.add_argument('--iterations', type=int, default=3)
+    parser.add_argument('-o', '--output', default='sweep', help='output directory')
+    args = parser.parse_args()
+
+    os.makedirs(args.output, exist_ok=True)
+    base = dict((name, values[0]) for name, values in args.base)
+    for param, values in args.sweep:
+        rows = []
+        for value in values:
+            params = dict(base)
+            params[param] = value
+            stem = os.path.join(args.output, '%s_%s' % (param, value))
+            for result in run_point(args, params, stem + '.bc', stem + '.json'):
+                row = {'param': param,
+                       'value': value,
+                       'pipeline': result['pipeline'],
+                       'wall_ms': result['wall_ms']['median'],
+                       'run_ms': result['phases']['run_ms']['median'],
+                       'peak_rss_kb': result['peak_rss_kb'],
+                       'allocations': result['allocations'],
+                       'allocated_bytes': result['allocated_bytes']}
+                rows.append(row)
+                print('%s=%s %s: %.2f ms, %d KB' % (param, value, row['pipeline'], row['wall_ms'], row['peak_rss_kb']))
+        with open(os.path.join(args.output, param + '.csv'), 'w') as f:
+            writer = csv.DictWriter(f, fieldnames=list(rows[0].keys()))
+            writer.writeheader()
+            writer.writerows(rows)
+        plot(rows, param, args.output)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
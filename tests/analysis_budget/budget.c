@@ -0,0 +1,33 @@
+#include <stdio.h>
+
+int total;
+
+int helper(int x)
+{
+    return x + 1;
+}
+
+/* loop reflects several values, exceeds a budget of one reflected value */
+int heavy(int n)
+{
+    int sum = 0;
+    int prod = 1;
+    for (int i = 0; i < n; ++i) {
+        sum += helper(i);
+        prod *= 2;
+        total += sum;
+    }
+    return sum + prod;
+}
+
+int light(int x)
+{
+    return x * 2;
+}
+
+int main(int argc, char** argv)
+{
+    int res = heavy(10) + light(3);
+    printf("%d\n", res);
+    return 0;
+}
@@ -0,0 +1,36 @@
+#!/bin/bash
+
+echo "Run analysis budget tests"
+
+LOCAL_LIB_LOC=../../build/lib
+
+rm *.bc
+
+clang budget.c -c -emit-llvm
+
+# heavy exceeds the budget in the middle of its loop reflection and falls back to input dependent result
+opt -load $LOCAL_LIB_LOC/libInputDependency.so budget.bc -input-dep -input-dep-budget-loop-reflections=1 \
+    -dependency-stats -dependency-stats-format=text -dependency-stats-file=stats.txt -transparent-cache -o out.bc
+llvm-dis out.bc -o out.ll
+
+echo "Fallback summary test"
+if grep -q "FallbackFunctionsCount 1$" stats.txt && grep -q "^ heavy values reflected in loops$" stats.txt; then
+    echo "PASS"
+else
+    echo "FAIL"
+fi
+
+echo "Fallback callee results test"
+# dependency of return instruction of each function
+awk '/^define/ { match($0, /@[A-Za-z_0-9]+/); F = substr($0, RSTART + 1, RLENGTH - 1) }
+     /^  ret / { dep = "unknown";
+                 if ($0 ~ /!input_indep_instr/) dep = "input_indep";
+                 else if ($0 ~ /!input_dep_instr/) dep = "input_dep";
+                 print F, dep }' out.ll > returns.txt
+if cmp returns.txt gold.txt; then
+    echo "PASS"
+else
+    echo "FAIL"
+fi
+
+rm *.bc out.ll returns.txt stats.txt
@@ -0,0 +1,34 @@
+#!/bin/bash
+
+echo "Run compact results tests"
+
+LOCAL_LIB_LOC=../../build/lib
+
+# programs of other tests
+programs=$(ls ../control_flow/*.cpp ../loop_controlflow/*.cpp ../composite_types/*.c ../composite_types/*.cpp \
+              ../bubble_sort/*.cpp ../irreducible_cfg/*.c ../entry_points/*.c)
+
+rm *.bc *.ll
+
+# transparent cache writes dependencies of each function, block and instruction as metadata
+cached_results()
+{
+    opt -load $LOCAL_LIB_LOC/libInputDependency.so $1 -transparent-cache "${@:2}" -o cached.bc
+    llvm-dis cached.bc -o - | grep -v "^; ModuleID"
+}
+
+for program in $programs; do
+    name=$(basename $program)
+    name=${name%.*}
+    echo "Compact results test $name"
+    clang $program -c -emit-llvm -o $name.bc
+    cached_results $name.bc -input-dep-compact-results=false > full.ll
+    cached_results $name.bc -input-dep-compact-results=true > compact.ll
+    if cmp full.ll compact.ll; then
+        echo "PASS"
+    else
+        echo "FAIL"
+    fi
+done
+
+rm *.bc *.ll
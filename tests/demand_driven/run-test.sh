@@ -0,0 +1,29 @@
+#!/bin/bash
+
+echo "Run demand driven tests"
+
+LOCAL_LIB_LOC=../../build/lib
+
+# programs of other tests
+programs=$(ls ../control_flow/*.cpp ../loop_controlflow/*.cpp ../composite_types/*.c ../composite_types/*.cpp \
+              ../bubble_sort/*.cpp ../irreducible_cfg/*.c ../entry_points/*.c)
+
+rm *.bc
+
+for program in $programs; do
+    name=$(basename $program)
+    name=${name%.*}
+    echo "Demand driven test $name"
+    clang $program -c -emit-llvm -o $name.bc
+    # demand driven answers for all instructions are compared with the whole module analysis
+    opt -load $LOCAL_LIB_LOC/libInputDependency.so $name.bc -input-dep-demand -input-dep-demand-verify \
+        -o out.bc 2> verify.txt
+    if grep -q "^Demand driven verification: [0-9]* instructions, 0 differences$" verify.txt; then
+        echo "PASS"
+    else
+        grep "differs from whole module analysis" verify.txt
+        echo "FAIL"
+    fi
+done
+
+rm *.bc verify.txt
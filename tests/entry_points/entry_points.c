@@ -0,0 +1,39 @@
+#include <stdio.h>
+
+int counter;
+
+static int called_from_main(int a)
+{
+    return a + 1;
+}
+
+static int called_from_entry(int a)
+{
+    return a * 2;
+}
+
+int entry(int a)
+{
+    return called_from_entry(a);
+}
+
+int exported(int a)
+{
+    return a - 1;
+}
+
+__attribute__((used)) static int not_called(int a)
+{
+    return a;
+}
+
+__attribute__((constructor)) static void init_counter(void)
+{
+    counter = 1;
+}
+
+int main(int argc, char** argv)
+{
+    printf("%d\n", called_from_main(argc) + counter);
+    return 0;
+}
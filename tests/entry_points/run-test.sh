@@ -0,0 +1,36 @@
+#!/bin/bash
+
+echo "Run entry points tests"
+
+LOCAL_LIB_LOC=../../build/lib
+
+rm *.bc
+
+clang entry_points.c -c -emit-llvm
+
+# functions skipped as unreachable from entry points, sorted by name
+skipped_functions()
+{
+    opt -load $LOCAL_LIB_LOC/libInputDependency.so entry_points.bc -input-dep -reachables-only "$@" -o out.bc 2>&1 \
+        | grep "^Skip unreachable function" | awk '{print $4}' | sort
+}
+
+check()
+{
+    local gold=$1
+    shift
+    echo "Entry points test $*"
+    skipped_functions "$@" > skipped.txt
+    if cmp skipped.txt $gold; then
+        echo "PASS"
+    else
+        echo "FAIL"
+    fi
+}
+
+check default_gold.txt
+check entry_gold.txt -entry-points=entry
+check entry_and_main_gold.txt -entry-points=entry,main
+check exported_gold.txt -exported-entry-points
+
+rm *.bc skipped.txt
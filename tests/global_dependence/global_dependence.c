@@ -0,0 +1,25 @@
+#include <stdio.h>
+
+int scale = 3;
+
+/* argument dependent before finalization, input dependent after it, depends on global in both cases */
+int input_and_global(int input)
+{
+    return input * scale;
+}
+
+int input_only(int input)
+{
+    return input * 3;
+}
+
+int global_only()
+{
+    return scale + 1;
+}
+
+int main(int argc, char** argv)
+{
+    printf("%d %d %d\n", input_and_global(argc), input_only(argc), global_only());
+    return 0;
+}
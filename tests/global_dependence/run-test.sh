@@ -0,0 +1,27 @@
+#!/bin/bash
+
+echo "Run global dependence tests"
+
+LOCAL_LIB_LOC=../../build/lib
+
+rm *.bc
+
+clang global_dependence.c -c -emit-llvm
+
+# input dependent instructions depending on globals are global dependent, as other instructions are
+opt -load $LOCAL_LIB_LOC/libInputDependency.so global_dependence.bc -input-dep -transparent-cache -o out.bc
+llvm-dis out.bc -o out.ll
+
+# global dependence of return instruction of each function
+awk '/^define/ { match($0, /@[A-Za-z_0-9]+/); F = substr($0, RSTART + 1, RLENGTH - 1) }
+     /^  ret / { dep = "global_indep";
+                 if ($0 ~ /!global_dep_instr/) dep = "global_dep";
+                 print F, dep }' out.ll > returns.txt
+
+if cmp returns.txt gold.txt; then
+    echo "PASS"
+else
+    echo "FAIL"
+fi
+
+rm *.bc out.ll returns.txt
@@ -0,0 +1,52 @@
+#include <stdio.h>
+
+int iterations;
+
+/* loop with two entries: entered at its header or jumped into its middle */
+int irreducible_indep(int n, int start_in_middle)
+{
+    int i = 0;
+    int sum = 0;
+    if (start_in_middle) {
+        goto middle;
+    }
+loop:
+    sum += i;
+middle:
+    ++i;
+    if (i < n) {
+        goto loop;
+    }
+    return sum;
+}
+
+int irreducible_dep(int n, int start_in_middle)
+{
+    int i = 0;
+    int sum = 0;
+    if (start_in_middle) {
+        goto middle;
+    }
+loop:
+    sum += i;
+    ++iterations;
+middle:
+    ++i;
+    if (i < n) {
+        goto loop;
+    }
+    return sum;
+}
+
+int read_iterations()
+{
+    return iterations;
+}
+
+int main(int argc, char** argv)
+{
+    int indep = irreducible_indep(10, 1);
+    int dep = irreducible_dep(argc, 0);
+    printf("%d %d %d\n", indep, dep, read_iterations());
+    return 0;
+}
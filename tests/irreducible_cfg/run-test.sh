@@ -0,0 +1,43 @@
+#!/bin/bash
+
+echo "Run irreducible control flow tests"
+
+LOCAL_LIB_LOC=../../build/lib
+
+rm *.bc
+
+clang irreducible.c -c -emit-llvm
+
+# gotos into the middle of the loop make the loop irreducible, it is analyzed without -goto-unsafe
+opt -load $LOCAL_LIB_LOC/libInputDependency.so irreducible.bc -input-dep -transparent-cache -o out.bc
+llvm-dis out.bc -o out.ll
+
+# dependency of return instruction of each function
+print_returns() {
+    awk '/^define/ { match($0, /@[A-Za-z_0-9]+/); F = substr($0, RSTART + 1, RLENGTH - 1) }
+         /^  ret / { dep = "unknown";
+                     if ($0 ~ /!input_indep_instr/) dep = "input_indep";
+                     else if ($0 ~ /!input_dep_instr/) dep = "input_dep";
+                     print F, dep }' out.ll
+}
+
+print_returns > returns.txt
+
+if cmp returns.txt gold.txt; then
+    echo "PASS"
+else
+    echo "FAIL"
+fi
+
+# regions not converging in a single iteration are considered input dependent
+opt -load $LOCAL_LIB_LOC/libInputDependency.so irreducible.bc -input-dep -input-dep-irreducible-region-iterations=1 -transparent-cache -o out.bc
+llvm-dis out.bc -o out.ll
+print_returns > returns.txt
+
+if cmp returns.txt gold_not_converged.txt; then
+    echo "PASS"
+else
+    echo "FAIL"
+fi
+
+rm *.bc out.ll returns.txt
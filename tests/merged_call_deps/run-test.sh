@@ -0,0 +1,29 @@
+#!/bin/bash
+
+echo "Run merged call dependencies tests"
+
+LOCAL_LIB_LOC=../../build/lib
+
+# programs of other tests
+programs=$(ls ../control_flow/*.cpp ../loop_controlflow/*.cpp ../composite_types/*.c ../composite_types/*.cpp \
+              ../bubble_sort/*.cpp ../irreducible_cfg/*.c ../entry_points/*.c)
+
+rm *.bc
+
+for program in $programs; do
+    name=$(basename $program)
+    name=${name%.*}
+    echo "Merged call dependencies test $name"
+    clang $program -c -emit-llvm -o $name.bc
+    # dependencies maintained while call sites are added are compared with merge of all call sites on each request
+    opt -load $LOCAL_LIB_LOC/libInputDependency.so $name.bc -transparent-cache -input-dep-verify-merged-call-deps \
+        -o out.bc 2> verify.txt
+    if grep -q "^Merged call dependencies verification: [0-9]* checks, 0 differences$" verify.txt; then
+        echo "PASS"
+    else
+        grep "differ from merge of all call sites" verify.txt
+        echo "FAIL"
+    fi
+done
+
+rm *.bc verify.txt
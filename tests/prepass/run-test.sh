@@ -0,0 +1,41 @@
+#!/bin/bash
+
+echo "Run prepass tests"
+
+LOCAL_LIB_LOC=../../build/lib
+
+# programs of other tests and programs of this test
+programs=$(ls ../control_flow/*.cpp ../loop_controlflow/*.cpp ../composite_types/*.c ../composite_types/*.cpp \
+              ../bubble_sort/*.cpp ../irreducible_cfg/*.c ../entry_points/*.c \
+              ./*.c)
+
+rm *.bc *.ll *.txt
+
+# transparent cache writes dependencies of each function, block and instruction as metadata.
+# Statistics are compared apart from analysis tiers, which differ by design
+run_analysis()
+{
+    local results=$1
+    local stats=$2
+    shift 2
+    opt -load $LOCAL_LIB_LOC/libInputDependency.so input.bc -transparent-cache "$@" \
+        -dependency-stats -dependency-stats-format=text -dependency-stats-file=all_stats.txt -o cached.bc
+    llvm-dis cached.bc -o - | grep -v "^; ModuleID" > $results
+    grep -v " analysis_tiers " all_stats.txt > $stats
+}
+
+for program in $programs; do
+    name=$(basename $program)
+    name=${name%.*}
+    echo "Prepass test $name"
+    clang $program -c -emit-llvm -o input.bc
+    run_analysis full.ll full_stats.txt -input-dep-prepass=false
+    run_analysis prepass.ll prepass_stats.txt -input-dep-prepass=true
+    if cmp full.ll prepass.ll && cmp full_stats.txt prepass_stats.txt; then
+        echo "PASS"
+    else
+        echo "FAIL"
+    fi
+done
+
+rm *.bc *.ll *.txt
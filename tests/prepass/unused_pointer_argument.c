@@ -0,0 +1,21 @@
+#include <stdio.h>
+#include <unistd.h>
+
+/* input independent by the prepass, pointer parameter is not used */
+void noop(char* buf)
+{
+}
+
+int main(int argc, char** argv)
+{
+    char buf[16];
+    int r = 0;
+    read(0, buf, sizeof(buf));
+    noop(buf);
+    // buf is input dependent after the call to noop
+    if (buf[0]) {
+        r = 1;
+    }
+    printf("%d\n", r);
+    return 0;
+}
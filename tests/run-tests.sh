@@ -6,7 +6,16 @@ directories="2048_game
              tetris
              bubble_sort
              control_flow
-             loop_controlflow"
+             loop_controlflow
+             entry_points
+             irreducible_cfg
+             compact_results
+             analysis_budget
+             demand_driven
+             prepass
+             merged_call_deps
+             global_dependence
+             thin_link"
 
 
 for dir in $directories
@@ -0,0 +1,33 @@
+#include <stdio.h>
+
+/* defined in lib.c */
+extern int lines;
+void process(int value);
+void count_lines();
+int read_last();
+int get_answer();
+
+/* lines is modified with input in lib.c */
+int input_lines()
+{
+    return lines;
+}
+
+/* returns global modified in lib.c with the value passed by main */
+int last_value_twice()
+{
+    return 2 * read_last();
+}
+
+int answer()
+{
+    return get_answer();
+}
+
+int main(int argc, char** argv)
+{
+    process(argc);
+    count_lines();
+    printf("%d %d %d\n", input_lines(), last_value_twice(), answer());
+    return 0;
+}
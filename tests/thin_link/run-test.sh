@@ -0,0 +1,38 @@
+#!/bin/bash
+
+echo "Run thin link tests"
+
+LOCAL_LIB_LOC=../../build/lib
+LOCAL_TOOLS_LOC=../../build/tools
+
+rm *.bc *.json
+
+modules="main lib"
+
+# summary of each module, then thin link of summaries across modules
+for module in $modules; do
+    clang $module.c -c -emit-llvm -o $module.bc
+    opt -load $LOCAL_LIB_LOC/libInputDependency.so $module.bc -input-dep -input-dep-summary=$module.json -o /dev/null
+done
+$LOCAL_TOOLS_LOC/input-dep-link main.json lib.json -output-dir=.
+
+# dependencies of returned values and stores to globals of each function, analysed with link results of its module
+for module in $modules; do
+    opt -load $LOCAL_LIB_LOC/libInputDependency.so $module.bc -input-dep -input-dep-link-result=$module.link.json \
+        -transparent-cache -o out.bc
+    llvm-dis out.bc -o - |
+    awk '/^define/ { match($0, /@[A-Za-z_0-9]+/); F = substr($0, RSTART + 1, RLENGTH - 1) }
+         /^  ret [^v]/ || /^  store .*, .* @/ {
+                 dep = "unknown";
+                 if ($0 ~ /!input_indep_instr/) dep = "input_indep";
+                 else if ($0 ~ /!input_dep_instr/) dep = "input_dep";
+                 print F, $1, dep }'
+done > results.txt
+
+if cmp results.txt gold.txt; then
+    echo "PASS"
+else
+    echo "FAIL"
+fi
+
+rm *.bc *.json results.txt
@@ -0,0 +1,179 @@
+#include "input-dependency/Analysis/AnalysisContext.h"
+#include "input-dependency/Analysis/InputDepConfig.h"
+#include "input-dependency/Analysis/InputDependencyAnalysisPass.h"
+
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/InitializePasses.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Runs input dependency analysis on many bitcode files in one process, on a pool of worker threads.
+ * Each worker parses its modules into its own LLVMContext, and each module is analysed in its own analysis
+ * context. Library function models are loaded once and shared read only by all modules.
+ * Statistics of each module are written to a separate file in the output directory.
+ */
+
+namespace {
+
+llvm::cl::opt<std::string> file_list(
+    llvm::cl::Positional,
+    llvm::cl::desc("<file with list of bitcode files, one per line>"),
+    llvm::cl::Required);
+
+llvm::cl::opt<unsigned> threads(
+    "j",
+    llvm::cl::desc("Number of worker threads. Number of hardware threads by default"),
+    llvm::cl::value_desc("number of threads"),
+    llvm::cl::init(0));
+
+llvm::cl::opt<std::string> output_dir(
+    "output-dir",
+    llvm::cl::desc("Directory for statistics of each module"),
+    llvm::cl::value_desc("directory"),
+    llvm::cl::init("."));
+
+using Clock = std::chrono::steady_clock;
+
+struct ModuleResult
+{
+    bool analyzed = false;
+    unsigned functions = 0;
+    std::string error;
+};
+
+std::vector<std::string> read_file_list(const std::string& list_file)
+{
+    std::vector<std::string> files;
+    std::ifstream list(list_file);
+    std::string line;
+    while (std::getline(list, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        files.push_back(line);
+    }
+    return files;
+}
+
+std::string get_stats_file_name(const std::string& file_name, unsigned index)
+{
+    // modules in different directories may have the same name
+    return output_dir + "/" + std::to_string(index) + "_" + llvm::sys::path::stem(file_name).str() + ".stats";
+}
+
+void analyze_module(const std::string& file_name,
+                    const std::string& stats_file_name,
+                    input_dependency::AnalysisContext& library_context,
+                    llvm::LLVMContext& context,
+                    ModuleResult& result)
+{
+    input_dependency::AnalysisContext analysis_context;
+    analysis_context.share_library_info(library_context);
+    analysis_context.get_config().set_stats_file(stats_file_name);
+    input_dependency::AnalysisContext::Scope analysis_scope(analysis_context);
+
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseIRFile(file_name, err, context);
+    if (!M) {
+        llvm::raw_string_ostream error_stream(result.error);
+        err.print("input-dep-batch", error_stream);
+        return;
+    }
+    llvm::legacy::PassManager PM;
+    PM.add(new input_dependency::InputDependencyAnalysisPass());
+    PM.run(*M);
+    for (auto& F : *M) {
+        if (!F.isDeclaration()) {
+            ++result.functions;
+        }
+    }
+    result.analyzed = true;
+}
+
+void run_worker(const std::vector<std::string>& files,
+                std::atomic<unsigned>& next_file,
+                input_dependency::AnalysisContext& library_context,
+                std::vector<ModuleResult>& results)
+{
+    // modules of the worker are parsed in turn into the same context
+    llvm::LLVMContext context;
+    for (unsigned i = next_file++; i < files.size(); i = next_file++) {
+        analyze_module(files[i], get_stats_file_name(files[i], i), library_context, context, results[i]);
+    }
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    llvm::PassRegistry& registry = *llvm::PassRegistry::getPassRegistry();
+    llvm::initializeCore(registry);
+    llvm::initializeAnalysis(registry);
+    llvm::initializeIPO(registry);
+    llvm::initializeTransformUtils(registry);
+    llvm::cl::ParseCommandLineOptions(argc, argv, "Input dependency analysis of many bitcode files\n");
+
+    const auto& files = read_file_list(file_list);
+    if (files.empty()) {
+        llvm::errs() << "No bitcode files in " << file_list << "\n";
+        return 1;
+    }
+    if (auto ec = llvm::sys::fs::create_directories(output_dir)) {
+        llvm::errs() << "Can not create output directory " << output_dir << ": " << ec.message() << "\n";
+        return 1;
+    }
+
+    // library function models are loaded once, with library configuration of command line options
+    input_dependency::AnalysisContext library_context;
+    {
+        input_dependency::AnalysisContext::Scope library_scope(library_context);
+        input_dependency::configure_run();
+        library_context.get_library_info();
+    }
+
+    const unsigned threads_count = threads != 0 ? threads.getValue() : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<ModuleResult> results(files.size());
+    std::atomic<unsigned> next_file(0);
+    const auto start = Clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < std::min<std::size_t>(threads_count, files.size()); ++i) {
+        workers.emplace_back(run_worker, std::cref(files), std::ref(next_file), std::ref(library_context), std::ref(results));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    unsigned analyzed = 0;
+    unsigned long functions = 0;
+    for (unsigned i = 0; i < files.size(); ++i) {
+        if (!results[i].analyzed) {
+            llvm::errs() << "Failed to analyze " << files[i] << "\n" << results[i].error;
+            continue;
+        }
+        ++analyzed;
+        functions += results[i].functions;
+    }
+    llvm::outs() << "Analyzed " << analyzed << " of " << files.size() << " modules, "
+                 << functions << " functions in " << seconds << " s with " << workers.size() << " threads: "
+                 << analyzed / seconds << " modules/s, " << functions / seconds << " functions/s\n";
+    return analyzed == files.size() ? 0 : 1;
+}
+
@@ -0,0 +1,77 @@
+#include "input-dependency/Analysis/ModuleSummary.h"
+#include "input-dependency/Analysis/ThinLink.h"
+
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <chrono>
+#include <string>
+
+/**
+ * Thin link step of input dependency analysis across modules.
+ * Reads module summaries written with -input-dep-summary, propagates dependencies of arguments and globals across
+ * modules, and writes link results of each module, to be used with -input-dep-link-result when analysing the module.
+ */
+
+namespace {
+
+llvm::cl::list<std::string> summary_files(
+    llvm::cl::Positional,
+    llvm::cl::desc("<module summaries>"),
+    llvm::cl::OneOrMore);
+
+llvm::cl::opt<std::string> output_dir(
+    "output-dir",
+    llvm::cl::desc("Directory for link results of each module"),
+    llvm::cl::value_desc("directory"),
+    llvm::cl::init("."));
+
+using Clock = std::chrono::steady_clock;
+
+std::string get_result_file_name(const std::string& summary_file)
+{
+    return output_dir + "/" + llvm::sys::path::stem(summary_file).str() + ".link.json";
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    llvm::cl::ParseCommandLineOptions(argc, argv, "Thin link of input dependency module summaries\n");
+
+    if (auto ec = llvm::sys::fs::create_directories(output_dir)) {
+        llvm::errs() << "Can not create output directory " << output_dir << ": " << ec.message() << "\n";
+        return 1;
+    }
+
+    const auto start = Clock::now();
+    input_dependency::ThinLink thinLink;
+    unsigned long functions = 0;
+    for (const auto& file : summary_files) {
+        input_dependency::ModuleSummary summary;
+        if (!summary.read(file)) {
+            llvm::errs() << "Failed to read summary " << file << "\n";
+            return 1;
+        }
+        functions += summary.getFunctions().size();
+        thinLink.addModule(std::move(summary));
+    }
+    thinLink.link();
+
+    bool success = true;
+    for (unsigned i = 0; i < summary_files.size(); ++i) {
+        const auto& result_file = get_result_file_name(summary_files[i]);
+        if (!thinLink.writeModuleResult(i, result_file)) {
+            llvm::errs() << "Failed to write link result " << result_file << "\n";
+            success = false;
+        }
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    llvm::outs() << "Linked " << summary_files.size() << " modules, " << functions << " functions, "
+                 << thinLink.getCrossModuleCallsCount() << " cross module calls in "
+                 << thinLink.getIterationsCount() << " iterations, " << seconds << " s\n";
+    return success ? 0 : 1;
+}
+
@@ -0,0 +1,406 @@
+#include "input-dependency/Analysis/AnalysisContext.h"
+#include "input-dependency/Analysis/CallGraphPartitioner.h"
+#include "input-dependency/Analysis/FunctionInputDependencyResultInterface.h"
+#include "input-dependency/Analysis/InputDepConfig.h"
+#include "input-dependency/Analysis/InputDependencyAnalysisPass.h"
+#include "input-dependency/Analysis/ModuleSummary.h"
+#include "input-dependency/Analysis/ThinLink.h"
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Analysis/CallGraph.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/InitializePasses.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Partitioned input dependency analysis of a module too large to be analysed at once.
+ * Call graph is split into balanced partitions with few call edges between them, and each partition is analysed
+ * on its own, on a pool of worker threads. Calls between partitions are exchanged as module summaries through thin
+ * link: the first round analyses partitions with conservative boundaries, where functions of other partitions are
+ * input dependent and arguments of functions called from other partitions are input dependent. Each refinement
+ * round analyses partitions with link results of the previous round, until link results do not change or the
+ * number of rounds is reached.
+ * With -compare the module is also analysed at once, and precision lost by partitioning is reported.
+ */
+
+namespace {
+
+llvm::cl::opt<std::string> input_file(
+    llvm::cl::Positional,
+    llvm::cl::desc("<bitcode file>"),
+    llvm::cl::Required);
+
+llvm::cl::opt<unsigned> partitions(
+    "partitions",
+    llvm::cl::desc("Number of partitions"),
+    llvm::cl::value_desc("number"),
+    llvm::cl::init(4));
+
+llvm::cl::opt<unsigned> refinement_rounds(
+    "refinement-rounds",
+    llvm::cl::desc("Maximal number of rounds exchanging boundary summaries"),
+    llvm::cl::value_desc("number"),
+    llvm::cl::init(2));
+
+llvm::cl::opt<unsigned> threads(
+    "j",
+    llvm::cl::desc("Number of worker threads. Number of hardware threads by default"),
+    llvm::cl::value_desc("number of threads"),
+    llvm::cl::init(0));
+
+llvm::cl::opt<std::string> output_dir(
+    "output-dir",
+    llvm::cl::desc("Directory for summaries and link results of partitions"),
+    llvm::cl::value_desc("directory"),
+    llvm::cl::init("."));
+
+llvm::cl::opt<bool> compare(
+    "compare",
+    llvm::cl::desc("Analyse the module at once and report precision lost by partitioning"),
+    llvm::cl::init(false));
+
+using Clock = std::chrono::steady_clock;
+
+struct FunctionResult
+{
+    bool input_dep = false;
+    long unsigned input_dep_count = 0;
+    long unsigned input_indep_count = 0;
+};
+
+using FunctionResults = std::map<std::string, FunctionResult>;
+
+struct PartitionResult
+{
+    bool analyzed = false;
+    std::string error;
+};
+
+/// Collects per function results of input dependency analysis
+class ResultsCollectorPass : public llvm::ModulePass
+{
+public:
+    static char ID;
+
+    explicit ResultsCollectorPass(FunctionResults& results)
+        : llvm::ModulePass(ID)
+        , m_results(results)
+    {
+    }
+
+public:
+    void getAnalysisUsage(llvm::AnalysisUsage& AU) const override
+    {
+        AU.addRequired<input_dependency::InputDependencyAnalysisPass>();
+        AU.setPreservesAll();
+    }
+
+    bool runOnModule(llvm::Module& M) override
+    {
+        auto IDA = getAnalysis<input_dependency::InputDependencyAnalysisPass>().getInputDependencyAnalysis();
+        for (const auto& item : IDA->getAnalysisInfo()) {
+            FunctionResult& result = m_results[item.first->getName().str()];
+            result.input_dep = item.second->isInputDepFunction();
+            result.input_dep_count = item.second->get_input_dep_count();
+            result.input_indep_count = item.second->get_input_indep_count();
+        }
+        return false;
+    }
+
+private:
+    FunctionResults& m_results;
+};
+
+char ResultsCollectorPass::ID = 0;
+
+std::string get_summary_file_name(unsigned partition)
+{
+    return output_dir + "/partition" + std::to_string(partition) + ".summary.json";
+}
+
+std::string get_link_file_name(unsigned partition)
+{
+    return output_dir + "/partition" + std::to_string(partition) + ".link.json";
+}
+
+std::string read_file(const std::string& file_name)
+{
+    std::ifstream ifs(file_name);
+    std::stringstream content;
+    content << ifs.rdbuf();
+    return content.str();
+}
+
+/// Functions and globals local to the module are made external, so that partitions can refer to them
+void externalize(llvm::Module& M)
+{
+    for (auto& F : M) {
+        if (F.hasLocalLinkage()) {
+            if (!F.hasName()) {
+                F.setName("input_dep.anon");
+            }
+            F.setLinkage(llvm::GlobalValue::ExternalLinkage);
+        }
+    }
+    for (auto& global : M.globals()) {
+        if (global.hasLocalLinkage()) {
+            if (!global.hasName()) {
+                global.setName("input_dep.anon");
+            }
+            global.setLinkage(llvm::GlobalValue::ExternalLinkage);
+        }
+    }
+}
+
+/// Bitcode of each partition: the module with bodies of functions of other partitions deleted
+std::vector<llvm::SmallVector<char, 0>> split_module(llvm::Module& M, const input_dependency::CallGraphPartitioner& partitioner)
+{
+    std::vector<llvm::SmallVector<char, 0>> bitcodes(partitioner.getPartitionsCount());
+    for (unsigned i = 0; i < bitcodes.size(); ++i) {
+        std::unique_ptr<llvm::Module> partition = llvm::CloneModule(M);
+        partition->setModuleIdentifier("partition" + std::to_string(i));
+        for (auto& F : *partition) {
+            if (!F.isDeclaration() && partitioner.getPartition(M.getFunction(F.getName())) != i) {
+                F.deleteBody();
+            }
+        }
+        llvm::raw_svector_ostream bitcode_stream(bitcodes[i]);
+        llvm::WriteBitcodeToFile(*partition, bitcode_stream);
+    }
+    return bitcodes;
+}
+
+void analyze_partition(const llvm::SmallVector<char, 0>& bitcode,
+                       unsigned partition,
+                       bool use_link_result,
+                       llvm::LLVMContext& context,
+                       FunctionResults& results,
+                       PartitionResult& result)
+{
+    // library info is not shared, as functions of other partitions are added to it from link result
+    input_dependency::AnalysisContext analysis_context;
+    input_dependency::AnalysisContext::Scope analysis_scope(analysis_context);
+    input_dependency::configure_run();
+    input_dependency::InputDepConfig::get().set_summary_file(get_summary_file_name(partition));
+    if (use_link_result) {
+        input_dependency::InputDepConfig::get().set_link_file(get_link_file_name(partition));
+    }
+
+    const std::string name = "partition" + std::to_string(partition);
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseIR(
+            llvm::MemoryBufferRef(llvm::StringRef(bitcode.data(), bitcode.size()), name), err, context);
+    if (!M) {
+        llvm::raw_string_ostream error_stream(result.error);
+        err.print("input-dep-partition", error_stream);
+        return;
+    }
+    llvm::legacy::PassManager PM;
+    PM.add(new input_dependency::InputDependencyAnalysisPass());
+    PM.add(new ResultsCollectorPass(results));
+    PM.run(*M);
+    result.analyzed = true;
+}
+
+/// Analyses all partitions on worker threads. Returns false if any partition failed.
+bool analyze_partitions(const std::vector<llvm::SmallVector<char, 0>>& bitcodes,
+                        bool use_link_result,
+                        std::vector<FunctionResults>& results)
+{
+    std::vector<PartitionResult> partition_results(bitcodes.size());
+    results.assign(bitcodes.size(), FunctionResults());
+    std::atomic<unsigned> next_partition(0);
+    const auto& worker = [&] () {
+        // partitions of the worker are parsed in turn into the same context
+        llvm::LLVMContext context;
+        for (unsigned i = next_partition++; i < bitcodes.size(); i = next_partition++) {
+            analyze_partition(bitcodes[i], i, use_link_result, context, results[i], partition_results[i]);
+        }
+    };
+    const unsigned threads_count = threads != 0 ? threads.getValue() : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < std::min<std::size_t>(threads_count, bitcodes.size()); ++i) {
+        workers.emplace_back(worker);
+    }
+    for (auto& worker_thread : workers) {
+        worker_thread.join();
+    }
+    bool success = true;
+    for (unsigned i = 0; i < bitcodes.size(); ++i) {
+        if (!partition_results[i].analyzed) {
+            llvm::errs() << "Failed to analyze partition " << i << "\n" << partition_results[i].error;
+            success = false;
+        }
+    }
+    return success;
+}
+
+/// Links summaries of partitions. Returns false on failure, changed is set if link results changed.
+bool link_partitions(unsigned partitions_count, bool& changed)
+{
+    input_dependency::ThinLink thinLink;
+    for (unsigned i = 0; i < partitions_count; ++i) {
+        input_dependency::ModuleSummary summary;
+        const auto& summary_file = get_summary_file_name(i);
+        if (!summary.read(summary_file)) {
+            llvm::errs() << "Failed to read summary " << summary_file << "\n";
+            return false;
+        }
+        thinLink.addModule(std::move(summary));
+    }
+    thinLink.link();
+    changed = false;
+    for (unsigned i = 0; i < partitions_count; ++i) {
+        const auto& link_file = get_link_file_name(i);
+        const std::string previous = read_file(link_file);
+        if (!thinLink.writeModuleResult(i, link_file)) {
+            llvm::errs() << "Failed to write link result " << link_file << "\n";
+            return false;
+        }
+        changed |= previous != read_file(link_file);
+    }
+    return true;
+}
+
+void report_precision(const FunctionResults& partitioned, const FunctionResults& monolithic)
+{
+    unsigned long partitioned_input_deps = 0;
+    unsigned long monolithic_input_deps = 0;
+    unsigned less_precise = 0;
+    unsigned more_precise = 0;
+    unsigned input_dep_functions = 0;
+    for (const auto& item : monolithic) {
+        auto pos = partitioned.find(item.first);
+        if (pos == partitioned.end()) {
+            continue;
+        }
+        partitioned_input_deps += pos->second.input_dep_count;
+        monolithic_input_deps += item.second.input_dep_count;
+        if (pos->second.input_dep_count > item.second.input_dep_count) {
+            ++less_precise;
+        } else if (pos->second.input_dep_count < item.second.input_dep_count) {
+            ++more_precise;
+        }
+        if (pos->second.input_dep && !item.second.input_dep) {
+            ++input_dep_functions;
+        }
+    }
+    llvm::outs() << "Input dependent instructions: partitioned " << partitioned_input_deps
+                 << ", monolithic " << monolithic_input_deps << "\n"
+                 << "Functions with more input dependent instructions " << less_precise
+                 << ", with fewer " << more_precise
+                 << ", input dependent only when partitioned " << input_dep_functions << "\n";
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    llvm::PassRegistry& registry = *llvm::PassRegistry::getPassRegistry();
+    llvm::initializeCore(registry);
+    llvm::initializeAnalysis(registry);
+    llvm::initializeIPO(registry);
+    llvm::initializeTransformUtils(registry);
+    llvm::cl::ParseCommandLineOptions(argc, argv, "Partitioned input dependency analysis of a large module\n");
+
+    if (partitions == 0) {
+        llvm::errs() << "Number of partitions should be positive\n";
+        return 1;
+    }
+    if (auto ec = llvm::sys::fs::create_directories(output_dir)) {
+        llvm::errs() << "Can not create output directory " << output_dir << ": " << ec.message() << "\n";
+        return 1;
+    }
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseIRFile(input_file, err, context);
+    if (!M) {
+        err.print("input-dep-partition", llvm::errs());
+        return 1;
+    }
+
+    FunctionResults monolithic;
+    double monolithic_seconds = 0;
+    if (compare) {
+        const auto start = Clock::now();
+        input_dependency::AnalysisContext analysis_context;
+        input_dependency::AnalysisContext::Scope analysis_scope(analysis_context);
+        llvm::legacy::PassManager PM;
+        PM.add(new input_dependency::InputDependencyAnalysisPass());
+        PM.add(new ResultsCollectorPass(monolithic));
+        PM.run(*M);
+        monolithic_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    const auto start = Clock::now();
+    externalize(*M);
+    std::vector<llvm::SmallVector<char, 0>> bitcodes;
+    unsigned long cut_edges = 0;
+    unsigned long call_edges = 0;
+    {
+        llvm::CallGraph callGraph(*M);
+        input_dependency::CallGraphPartitioner partitioner(*M, callGraph);
+        partitioner.partition(partitions);
+        cut_edges = partitioner.getCutEdgesCount();
+        call_edges = partitioner.getCallEdgesCount();
+        bitcodes = split_module(*M, partitioner);
+    }
+
+    std::vector<FunctionResults> results;
+    unsigned rounds = 0;
+    bool changed = true;
+    // first round has conservative boundaries, following rounds use link results of the previous one
+    while (true) {
+        if (!analyze_partitions(bitcodes, rounds != 0, results)) {
+            return 1;
+        }
+        if (rounds == refinement_rounds || !changed) {
+            break;
+        }
+        if (!link_partitions(bitcodes.size(), changed)) {
+            return 1;
+        }
+        ++rounds;
+        if (!changed && rounds > 1) {
+            // partitions were analysed with the same link results
+            break;
+        }
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    FunctionResults partitioned;
+    for (const auto& partition_results : results) {
+        partitioned.insert(partition_results.begin(), partition_results.end());
+    }
+    llvm::outs() << "Analyzed " << partitioned.size() << " functions in " << bitcodes.size() << " partitions, "
+                 << cut_edges << " of " << call_edges << " call edges cut, " << rounds << " refinement rounds, "
+                 << seconds << " s\n";
+    if (compare) {
+        llvm::outs() << "Monolithic analysis " << monolithic_seconds << " s\n";
+        report_precision(partitioned, monolithic);
+    }
+    return 0;
+}
+
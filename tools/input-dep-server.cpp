@@ -0,0 +1,387 @@
+#include "input-dependency/Analysis/AnalysisContext.h"
+#include "input-dependency/Analysis/FunctionInputDependencyResultInterface.h"
+#include "input-dependency/Analysis/InputDependencyAnalysisPass.h"
+#include "input-dependency/Analysis/TransparentCachingPass.h"
+
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/InitializePasses.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Long lived analysis server for IDE and incremental build integration, reachable over a Unix domain socket.
+ * Library function models are loaded once at start up. Results of each analysed bitcode file are kept per
+ * function until the file changes, so repeated queries for an unchanged file are answered without analysis. Each
+ * request parses its module into a fresh LLVM context, released with the module once the request is served.
+ *
+ * Requests and replies are lines of text:
+ *      analyze <bitcode> [function...]     classification of given functions, all functions if none given
+ *      cache <bitcode> <output>            writes bitcode with cached input dependency metadata to output
+ *      shutdown                            stops the server
+ * Each reply ends with a line "ok <milliseconds>" or "error <message>".
+ */
+
+namespace {
+
+llvm::cl::opt<std::string> socket_path(
+    "socket",
+    llvm::cl::desc("Unix domain socket path to listen on"),
+    llvm::cl::value_desc("path"),
+    llvm::cl::Required);
+
+using Clock = std::chrono::steady_clock;
+
+struct FunctionResult
+{
+    bool input_dep = false;
+    bool extracted = false;
+    long unsigned input_dep_count = 0;
+    long unsigned input_indep_count = 0;
+    long unsigned unknowns_count = 0;
+};
+
+/// Results of a bitcode file, valid while the file is not modified
+struct ModuleResults
+{
+    /// set once the file is analysed, a module without functions is cached as well
+    bool cached = false;
+    llvm::sys::TimePoint<> modification_time;
+    uint64_t size = 0;
+    std::map<std::string, FunctionResult> functions;
+};
+
+/// Collects per function results of input dependency analysis
+class ResultsCollectorPass : public llvm::ModulePass
+{
+public:
+    static char ID;
+
+    explicit ResultsCollectorPass(ModuleResults& results)
+        : llvm::ModulePass(ID)
+        , m_results(results)
+    {
+    }
+
+public:
+    void getAnalysisUsage(llvm::AnalysisUsage& AU) const override
+    {
+        AU.addRequired<input_dependency::InputDependencyAnalysisPass>();
+        AU.setPreservesAll();
+    }
+
+    bool runOnModule(llvm::Module& M) override
+    {
+        auto IDA = getAnalysis<input_dependency::InputDependencyAnalysisPass>().getInputDependencyAnalysis();
+        m_results.functions.clear();
+        for (const auto& item : IDA->getAnalysisInfo()) {
+            const auto& FA = item.second;
+            FunctionResult& result = m_results.functions[item.first->getName().str()];
+            result.input_dep = FA->isInputDepFunction();
+            result.extracted = FA->isExtractedFunction();
+            result.input_dep_count = FA->get_input_dep_count();
+            result.input_indep_count = FA->get_input_indep_count();
+            result.unknowns_count = FA->get_input_unknowns_count();
+        }
+        return false;
+    }
+
+private:
+    ModuleResults& m_results;
+};
+
+char ResultsCollectorPass::ID = 0;
+
+class AnalysisServer
+{
+public:
+    AnalysisServer()
+    {
+        // library function models are loaded once, with library configuration of command line options
+        input_dependency::AnalysisContext::Scope library_scope(m_libraryContext);
+        input_dependency::configure_run();
+        m_libraryContext.get_library_info();
+    }
+
+public:
+    /// Handles one request line, writes reply to out. Returns false on shutdown request.
+    bool handle_request(const std::string& request, llvm::raw_ostream& out);
+
+private:
+    bool analyze(const std::vector<std::string>& args, llvm::raw_ostream& out);
+    bool cache(const std::vector<std::string>& args, llvm::raw_ostream& out);
+    std::unique_ptr<llvm::Module> parse(const std::string& file_name,
+                                        llvm::LLVMContext& context,
+                                        llvm::raw_ostream& out);
+
+private:
+    input_dependency::AnalysisContext m_libraryContext;
+    std::unordered_map<std::string, ModuleResults> m_results;
+};
+
+bool AnalysisServer::handle_request(const std::string& request, llvm::raw_ostream& out)
+{
+    std::istringstream request_stream(request);
+    std::string command;
+    request_stream >> command;
+    std::vector<std::string> args;
+    std::string arg;
+    while (request_stream >> arg) {
+        args.push_back(arg);
+    }
+
+    const auto start = Clock::now();
+    bool success = false;
+    if (command == "analyze") {
+        success = analyze(args, out);
+    } else if (command == "cache") {
+        success = cache(args, out);
+    } else if (command == "shutdown") {
+        out << "ok 0\n";
+        return false;
+    } else {
+        out << "error unknown request " << command << "\n";
+    }
+    if (success) {
+        out << "ok " << std::chrono::duration<double, std::milli>(Clock::now() - start).count() << "\n";
+    }
+    return true;
+}
+
+std::unique_ptr<llvm::Module> AnalysisServer::parse(const std::string& file_name,
+                                                    llvm::LLVMContext& context,
+                                                    llvm::raw_ostream& out)
+{
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseIRFile(file_name, err, context);
+    if (!M) {
+        out << "error can not parse " << file_name << ": " << err.getMessage() << "\n";
+    }
+    return M;
+}
+
+bool AnalysisServer::analyze(const std::vector<std::string>& args, llvm::raw_ostream& out)
+{
+    if (args.empty()) {
+        out << "error analyze expects bitcode file\n";
+        return false;
+    }
+    const std::string& file_name = args[0];
+    llvm::sys::fs::file_status status;
+    if (auto ec = llvm::sys::fs::status(file_name, status)) {
+        out << "error " << file_name << ": " << ec.message() << "\n";
+        return false;
+    }
+
+    auto& results = m_results[file_name];
+    if (!results.cached
+            || results.modification_time != status.getLastModificationTime()
+            || results.size != status.getSize()) {
+        // callers and callees of changed functions depend on them, thus whole module is analysed again.
+        // Types and constants of the module are released with the context, after the module itself
+        llvm::LLVMContext context;
+        auto M = parse(file_name, context, out);
+        if (!M) {
+            m_results.erase(file_name);
+            return false;
+        }
+        input_dependency::AnalysisContext analysis_context;
+        analysis_context.share_library_info(m_libraryContext);
+        input_dependency::AnalysisContext::Scope analysis_scope(analysis_context);
+        llvm::legacy::PassManager PM;
+        PM.add(new input_dependency::InputDependencyAnalysisPass());
+        PM.add(new ResultsCollectorPass(results));
+        PM.run(*M);
+        results.cached = true;
+        results.modification_time = status.getLastModificationTime();
+        results.size = status.getSize();
+    }
+
+    auto print_result = [&out] (const std::string& name, const FunctionResult& result) {
+        out << name << " " << (result.input_dep ? "input_dep" : "input_indep")
+            << (result.extracted ? " extracted" : "")
+            << " " << result.input_dep_count << " " << result.input_indep_count << " " << result.unknowns_count << "\n";
+    };
+    if (args.size() == 1) {
+        for (const auto& item : results.functions) {
+            print_result(item.first, item.second);
+        }
+        return true;
+    }
+    for (unsigned i = 1; i < args.size(); ++i) {
+        auto pos = results.functions.find(args[i]);
+        if (pos == results.functions.end()) {
+            out << args[i] << " unknown\n";
+        } else {
+            print_result(pos->first, pos->second);
+        }
+    }
+    return true;
+}
+
+bool AnalysisServer::cache(const std::vector<std::string>& args, llvm::raw_ostream& out)
+{
+    if (args.size() != 2) {
+        out << "error cache expects bitcode and output files\n";
+        return false;
+    }
+    llvm::LLVMContext context;
+    auto M = parse(args[0], context, out);
+    if (!M) {
+        return false;
+    }
+    input_dependency::AnalysisContext analysis_context;
+    analysis_context.share_library_info(m_libraryContext);
+    input_dependency::AnalysisContext::Scope analysis_scope(analysis_context);
+    llvm::legacy::PassManager PM;
+    PM.add(new input_dependency::InputDependencyAnalysisPass());
+    PM.add(new input_dependency::TransparentCachingPass());
+    PM.run(*M);
+
+    std::error_code ec;
+    llvm::raw_fd_ostream bitcode(args[1], ec, llvm::sys::fs::F_None);
+    if (ec) {
+        out << "error can not write " << args[1] << ": " << ec.message() << "\n";
+        return false;
+    }
+    llvm::WriteBitcodeToFile(*M, bitcode);
+    return true;
+}
+
+bool read_line(int fd, std::string& buffer, std::string& line)
+{
+    while (true) {
+        auto pos = buffer.find('\n');
+        if (pos != std::string::npos) {
+            line = buffer.substr(0, pos);
+            buffer.erase(0, pos + 1);
+            return true;
+        }
+        char data[4096];
+        ssize_t read_count = read(fd, data, sizeof(data));
+        if (read_count <= 0) {
+            return false;
+        }
+        buffer.append(data, read_count);
+    }
+}
+
+/// Returns false if the client dropped the connection, e.g. closed it before reading the reply (EPIPE).
+bool write_all(int fd, const std::string& data)
+{
+    std::size_t written = 0;
+    while (written < data.size()) {
+        // MSG_NOSIGNAL: writing to a closed connection fails with EPIPE instead of raising SIGPIPE
+        ssize_t count = send(fd, data.data() + written, data.size() - written, MSG_NOSIGNAL);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            if (errno != EPIPE) {
+                llvm::errs() << "Can not write reply: " << std::strerror(errno) << "\n";
+            }
+            return false;
+        }
+        written += count;
+    }
+    return true;
+}
+
+/// Serves requests of a client until it disconnects. Returns false on shutdown request.
+bool serve_client(int client, AnalysisServer& server)
+{
+    std::string buffer;
+    std::string request;
+    while (read_line(client, buffer, request)) {
+        if (request.empty()) {
+            continue;
+        }
+        std::string reply;
+        llvm::raw_string_ostream reply_stream(reply);
+        bool keep_running = server.handle_request(request, reply_stream);
+        if (!write_all(client, reply_stream.str()) || !keep_running) {
+            // dropped client does not stop the server
+            return keep_running;
+        }
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    llvm::PassRegistry& registry = *llvm::PassRegistry::getPassRegistry();
+    llvm::initializeCore(registry);
+    llvm::initializeAnalysis(registry);
+    llvm::initializeIPO(registry);
+    llvm::initializeTransformUtils(registry);
+    llvm::cl::ParseCommandLineOptions(argc, argv, "Input dependency analysis server\n");
+    // clients closing connection must not terminate the server
+    std::signal(SIGPIPE, SIG_IGN);
+
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path)) {
+        llvm::errs() << "Socket path " << socket_path << " is too long\n";
+        return 1;
+    }
+    std::strcpy(address.sun_path, socket_path.c_str());
+
+    int server_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server_socket < 0) {
+        llvm::errs() << "Can not create socket: " << std::strerror(errno) << "\n";
+        return 1;
+    }
+    unlink(socket_path.c_str());
+    if (bind(server_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+            || listen(server_socket, 8) != 0) {
+        llvm::errs() << "Can not listen on " << socket_path << ": " << std::strerror(errno) << "\n";
+        close(server_socket);
+        return 1;
+    }
+
+    AnalysisServer server;
+    llvm::outs() << "Listening on " << socket_path << "\n";
+    llvm::outs().flush();
+    // clients are served in turn, as they share warm state of the server
+    bool keep_running = true;
+    while (keep_running) {
+        int client = accept(server_socket, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            llvm::errs() << "Can not accept connection: " << std::strerror(errno) << "\n";
+            break;
+        }
+        keep_running = serve_client(client, server);
+        close(client);
+    }
+    close(server_socket);
+    unlink(socket_path.c_str());
+    return keep_running ? 1 : 0;
+}
+
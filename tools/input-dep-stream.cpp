@@ -0,0 +1,173 @@
+#include "input-dependency/Analysis/AnalysisContext.h"
+#include "input-dependency/Analysis/FunctionAnalyses.h"
+#include "input-dependency/Analysis/IndirectCallSitesAnalysis.h"
+#include "input-dependency/Analysis/InputDepConfig.h"
+#include "input-dependency/Analysis/InputDependencyAnalysis.h"
+#include "input-dependency/Analysis/InputDependencyAnalysisPass.h"
+
+#include "llvm/ADT/Triple.h"
+#include "llvm/Analysis/CallGraph.h"
+#include "llvm/Analysis/TargetLibraryInfo.h"
+#include "llvm/IR/CallSite.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Streaming input dependency analysis of a single large bitcode file, writing the module summary only.
+ * The module is loaded lazily: call graph is built from a scan of call edges, after which function bodies are
+ * materialized SCC by SCC, bottom up. Once all callers of a function are analysed, its results, its analyses and
+ * its body are released, so peak memory is bounded by functions whose callers are still pending rather than by
+ * the whole module. Summary can be linked with input-dep-link as summaries of any other module.
+ */
+
+namespace {
+
+llvm::cl::opt<std::string> input_file(
+    llvm::cl::Positional,
+    llvm::cl::desc("<bitcode file>"),
+    llvm::cl::Required);
+
+llvm::cl::opt<std::string> output_file(
+    "o",
+    llvm::cl::desc("Module summary output file"),
+    llvm::cl::value_desc("file"),
+    llvm::cl::Required);
+
+using Clock = std::chrono::steady_clock;
+using CallEdges = std::vector<std::pair<std::string, std::string>>;
+
+long get_peak_rss_kb()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/// Direct call edges of the module, collected one function body at a time in a separate context
+bool scan_call_edges(const std::string& file_name, CallEdges& edges)
+{
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::getLazyIRFileModule(file_name, err, context);
+    if (!M) {
+        err.print("input-dep-stream", llvm::errs());
+        return false;
+    }
+    for (auto& F : *M) {
+        if (!F.isMaterializable()) {
+            continue;
+        }
+        if (auto error = F.materialize()) {
+            llvm::errs() << "Failed to materialize " << F.getName() << ": " << llvm::toString(std::move(error)) << "\n";
+            return false;
+        }
+        for (auto& B : F) {
+            for (auto& I : B) {
+                llvm::CallSite callSite(&I);
+                if (!callSite) {
+                    continue;
+                }
+                auto* callee = callSite.getCalledFunction();
+                if (callee && !callee->isIntrinsic()) {
+                    edges.emplace_back(F.getName().str(), callee->getName().str());
+                }
+            }
+        }
+        F.deleteBody();
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    llvm::cl::ParseCommandLineOptions(argc, argv, "Streaming input dependency analysis of a lazily loaded module\n");
+
+    const auto start = Clock::now();
+    CallEdges edges;
+    if (!scan_call_edges(input_file, edges)) {
+        return 1;
+    }
+
+    input_dependency::AnalysisContext analysis_context;
+    input_dependency::AnalysisContext::Scope analysis_scope(analysis_context);
+    input_dependency::configure_run();
+    input_dependency::InputDepConfig::get().set_summary_file(output_file);
+
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::getLazyIRFileModule(input_file, err, context);
+    if (!M) {
+        err.print("input-dep-stream", llvm::errs());
+        return 1;
+    }
+    // without bodies call graph has only edges from external node; direct calls are added from the scan
+    llvm::CallGraph CG(*M);
+    for (const auto& edge : edges) {
+        auto* caller = M->getFunction(edge.first);
+        auto* callee = M->getFunction(edge.second);
+        if (caller && callee) {
+            CG.getOrInsertFunction(caller)->addCalledFunction(llvm::CallSite(), CG.getOrInsertFunction(callee));
+        }
+    }
+
+    const llvm::TargetLibraryInfoImpl TLII(llvm::Triple(M->getTargetTriple()));
+    // function level analyses are built on materialization of the function and released with it
+    std::unordered_map<llvm::Function*, std::unique_ptr<input_dependency::FunctionAnalyses>> analyses;
+    unsigned long functions = 0;
+    bool materialize_failed = false;
+    const auto& materializer = [&] (llvm::Function* F) {
+        if (auto error = F->materialize()) {
+            llvm::errs() << "Failed to materialize " << F->getName() << ": " << llvm::toString(std::move(error)) << "\n";
+            materialize_failed = true;
+            return false;
+        }
+        analyses[F].reset(new input_dependency::FunctionAnalyses(*F, TLII));
+        ++functions;
+        return true;
+    };
+    const auto& releaser = [&] (llvm::Function* F) {
+        analyses.erase(F);
+        F->deleteBody();
+    };
+
+    // indirect and virtual call targets are not known without bodies, such calls are input dependent
+    input_dependency::VirtualCallSiteAnalysisResult virtualCallsInfo;
+    input_dependency::IndirectCallSitesAnalysisResult indirectCallsInfo;
+    input_dependency::InputDependencyAnalysis analysis(M.get());
+    analysis.setCallGraph(&CG);
+    analysis.setVirtualCallSiteAnalysisResult(&virtualCallsInfo);
+    analysis.setIndirectCallSiteAnalysisResult(&indirectCallsInfo);
+    analysis.setAliasAnalysisInfoGetter([&] (llvm::Function* F) { return &analyses.at(F)->AAR; });
+    analysis.setLoopInfoGetter([&] (llvm::Function* F) { return &analyses.at(F)->LI; });
+    analysis.setPostDominatorTreeGetter([&] (llvm::Function* F) { return &analyses.at(F)->PDT; });
+    analysis.setDominatorTreeGetter([&] (llvm::Function* F) { return &analyses.at(F)->DT; });
+    analysis.setStreaming(materializer, releaser);
+    analysis.run();
+    if (materialize_failed) {
+        return 1;
+    }
+
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    llvm::outs() << "Summarized " << functions << " functions of " << input_file << " in " << seconds << " s, "
+                 << "peak memory " << get_peak_rss_kb() / 1024 << " MB\n";
+    return 0;
+}
+